@@ -1,3 +1,5 @@
+#pragma once
+
 #include <AH/Hardware/Arduino-Hardware-Types.hpp>
 
 // TODO
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define BUFFER_LENGTH 32
+
+// Mock of the Arduino Wire library that records all transmissions.
+class TwoWire {
+  public:
+    struct Transmission {
+        uint8_t address;
+        std::vector<uint8_t> data;
+    };
+
+    void begin() {}
+    void setClock(uint32_t clock) { this->clock = clock; }
+
+    void beginTransmission(uint8_t address) {
+        current = {address, {}};
+        transmitting = true;
+    }
+    size_t write(uint8_t data) {
+        // Like the real library, the transmit buffer is limited
+        if (!transmitting || current.data.size() >= BUFFER_LENGTH)
+            return 0;
+        current.data.push_back(data);
+        return 1;
+    }
+    uint8_t endTransmission(bool = true) {
+        if (!transmitting)
+            return 4;
+        transmissions.push_back(current);
+        transmitting = false;
+        return 0;
+    }
+
+    // Mock: all complete transmissions, and the current clock frequency.
+    std::vector<Transmission> transmissions;
+    uint32_t clock = 100000;
+
+  private:
+    Transmission current;
+    bool transmitting = false;
+};
+
+extern TwoWire Wire;
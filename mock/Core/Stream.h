@@ -8,6 +8,20 @@ class Stream : public Print {
     virtual int read() = 0;
     virtual int peek() = 0;
     virtual int available() = 0;
+    virtual size_t readBytes(char *buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0)
+                break;
+            *buffer++ = (char)c;
+            count++;
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t *buffer, size_t length) {
+        return readBytes((char *)buffer, length);
+    }
 };
 
 #endif
\ No newline at end of file
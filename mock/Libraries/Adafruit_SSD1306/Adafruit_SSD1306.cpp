@@ -0,0 +1,99 @@
+// Mock implementation of the parts of the Adafruit_SSD1306 library that are
+// used by the tests: drawing to the frame buffer works like the real library,
+// commands and transfers are only recorded.
+
+#include "Adafruit_SSD1306.h"
+
+#include <cstring>
+
+Adafruit_SSD1306::Adafruit_SSD1306(int8_t SID, int8_t SCLK, int8_t DC,
+                                   int8_t RST, int8_t CS)
+    : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), sid(SID), sclk(SCLK),
+      dc(DC), rst(RST), cs(CS), hwSPI(false) {}
+
+Adafruit_SSD1306::Adafruit_SSD1306(int8_t DC, int8_t RST, int8_t CS)
+    : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), sid(-1), sclk(-1),
+      dc(DC), rst(RST), cs(CS), hwSPI(true) {}
+
+Adafruit_SSD1306::Adafruit_SSD1306(int8_t RST)
+    : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), sid(-1), sclk(-1),
+      dc(-1), rst(RST), cs(-1), hwSPI(false) {}
+
+// The frame buffer has a fixed size, smaller displays only use part of it.
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi,
+                                   int8_t rst_pin)
+    : Adafruit_GFX(w <= SSD1306_LCDWIDTH ? w : SSD1306_LCDWIDTH,
+                   h <= SSD1306_LCDHEIGHT ? h : SSD1306_LCDHEIGHT),
+      wire(twi), sid(-1), sclk(-1), dc(-1), rst(rst_pin), cs(-1),
+      hwSPI(false) {}
+
+void Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t i2caddr, bool) {
+    _vccstate = switchvcc;
+    _i2caddr = i2caddr;
+    this->i2caddr = i2caddr;
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+    commands.push_back(c);
+    if (wire) {
+        wire->beginTransmission(i2caddr);
+        wire->write(0x00); // Co = 0, D/C = 0
+        wire->write(c);
+        wire->endTransmission();
+    }
+}
+
+void Adafruit_SSD1306::clearDisplay() { std::memset(buffer, 0, sizeof(buffer)); }
+
+void Adafruit_SSD1306::display() {
+    ++displayCount;
+    if (!wire)
+        return;
+    ssd1306_command(SSD1306_PAGEADDR);
+    ssd1306_command(0);
+    ssd1306_command(0xFF);
+    ssd1306_command(SSD1306_COLUMNADDR);
+    ssd1306_command(0);
+    ssd1306_command(WIDTH - 1);
+    uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+    const uint8_t *ptr = buffer;
+    wire->beginTransmission(i2caddr);
+    wire->write(0x40);
+    uint16_t bytesOut = 1;
+    while (count--) {
+        if (bytesOut >= BUFFER_LENGTH) {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            wire->write(0x40);
+            bytesOut = 1;
+        }
+        wire->write(*ptr++);
+        bytesOut++;
+    }
+    wire->endTransmission();
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= width() || y < 0 || y >= height())
+        return;
+    uint8_t &byte = buffer[x + (y / 8) * WIDTH];
+    uint8_t mask = 1 << (y & 7);
+    switch (color) {
+        case WHITE: byte |= mask; break;
+        case BLACK: byte &= ~mask; break;
+        case INVERSE: byte ^= mask; break;
+        default: break;
+    }
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color) {
+    for (int16_t i = 0; i < h; ++i)
+        drawPixel(x, y + i, color);
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color) {
+    for (int16_t i = 0; i < w; ++i)
+        drawPixel(x + i, y, color);
+}
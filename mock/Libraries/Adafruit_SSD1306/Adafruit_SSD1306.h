@@ -43,11 +43,18 @@ typedef uint32_t PortMask;
 
 // #include <SPI.h>
 #include <Adafruit_GFX.h>
+#include <Wire.h>
+#include <vector>
 
 #define BLACK 0
 #define WHITE 1
 #define INVERSE 2
 
+// Mock: the I²C interface of version 2 of the library is supported as well
+#define SSD1306_BLACK BLACK
+#define SSD1306_WHITE WHITE
+#define SSD1306_INVERSE INVERSE
+
 #define SSD1306_I2C_ADDRESS 0x3C // 011110+SA0+RW - 0x3C or 0x3D
 
 // Address for 128x32 is 0x3C
@@ -146,6 +153,8 @@ class Adafruit_SSD1306 : public Adafruit_GFX {
     Adafruit_SSD1306(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS);
     Adafruit_SSD1306(int8_t DC, int8_t RST, int8_t CS);
     Adafruit_SSD1306(int8_t RST = -1);
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi = &Wire,
+                     int8_t rst_pin = -1);
 
     void begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC,
                uint8_t i2caddr = SSD1306_I2C_ADDRESS, bool reset = true);
@@ -171,7 +180,20 @@ class Adafruit_SSD1306 : public Adafruit_GFX {
     void drawFastHLine(int16_t x, int16_t y, int16_t w,
                        uint16_t color) override;
 
+    uint8_t *getBuffer() { return buffer; }
+
+    // Mock: the commands that were sent, and the number of times the entire
+    // buffer was sent. If the display was created with a TwoWire interface,
+    // the commands and the buffer are written to it as well.
+    std::vector<uint8_t> commands;
+    unsigned displayCount = 0;
+
+  protected:
+    TwoWire *wire = nullptr;
+    int8_t i2caddr = SSD1306_I2C_ADDRESS;
+
   private:
+    uint8_t buffer[SSD1306_LCDWIDTH * SSD1306_LCDHEIGHT / 8] = {};
     int8_t _i2caddr, _vccstate, sid, sclk, dc, rst, cs;
     void fastSPIwrite(uint8_t c);
 
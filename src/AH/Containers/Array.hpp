@@ -128,14 +128,23 @@ struct Array {
      *          The end index of the slice.
      */
     template <size_t Start = 0, size_t End = N - 1>
-    ArraySlice<T, abs_diff(Start, End) + 1, (End < Start), false> slice();
+    ArraySlice<T, abs_diff(Start, End) + 1, (End < Start), false> slice() {
+        static_assert(Start < N, "");
+        static_assert(End < N, "");
+        return &(*this)[Start];
+    }
 
     /**
      * @brief   Get a read-only view on a slice of the Array.
      * @copydetails     slice()
      */
     template <size_t Start = 0, size_t End = N - 1>
-    ArraySlice<T, abs_diff(Start, End) + 1, (End < Start), true> slice() const;
+    ArraySlice<T, abs_diff(Start, End) + 1, (End < Start), true>
+    slice() const {
+        static_assert(Start < N, "");
+        static_assert(End < N, "");
+        return &(*this)[Start];
+    }
 
     /**
      * @brief   Get a read-only view on a slice of the Array.
@@ -224,39 +233,16 @@ class ArraySlice {
 
     template <size_t Start, size_t End>
     ArraySlice<T, abs_diff(End, Start) + 1, Reverse ^ (End < Start), Const>
-    slice() const;
+    slice() const {
+        static_assert(Start < N, "");
+        static_assert(End < N, "");
+        return &(*this)[Start];
+    }
 
   private:
     ElementPtrType array;
 };
 
-template <class T, size_t N>
-template <size_t Start, size_t End>
-inline ArraySlice<T, abs_diff(Start, End) + 1, (End < Start), false>
-Array<T, N>::slice() {
-    static_assert(Start < N, "");
-    static_assert(End < N, "");
-    return &(*this)[Start];
-}
-
-template <class T, size_t N>
-template <size_t Start, size_t End>
-inline ArraySlice<T, abs_diff(Start, End) + 1, (End < Start), true>
-Array<T, N>::slice() const {
-    static_assert(Start < N, "");
-    static_assert(End < N, "");
-    return &(*this)[Start];
-}
-
-template <class T, size_t N, bool Reverse, bool Const>
-template <size_t Start, size_t End>
-ArraySlice<T, abs_diff(End, Start) + 1, Reverse ^ (End < Start), Const>
-ArraySlice<T, N, Reverse, Const>::slice() const {
-    static_assert(Start < N, "");
-    static_assert(End < N, "");
-    return &(*this)[Start];
-}
-
 /// @related ArraySlice<T, N, Reverse, Const>::iterator
 template <class T, size_t N, bool Reverse, bool Const>
 typename ArraySlice<T, N, Reverse, Const>::iterator operator+(
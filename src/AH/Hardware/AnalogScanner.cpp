@@ -0,0 +1,284 @@
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include "AnalogScanner.hpp"
+
+BEGIN_AH_NAMESPACE
+
+AnalogScannerBase *AnalogScannerBase::active = nullptr;
+
+AnalogScannerBase::AnalogScannerBase(Channel *channels, analog_t *values,
+                                     uint8_t *scanOrder, uint8_t *pinOrder,
+                                     uint8_t maxChannels,
+                                     Multiplexer *multiplexers,
+                                     uint8_t *lineAddresses,
+                                     uint8_t maxMultiplexers)
+    : channels(channels), values(values), scanOrder(scanOrder),
+      pinOrder(pinOrder), maxChannels(maxChannels),
+      multiplexers(multiplexers), lineAddresses(lineAddresses),
+      maxMultiplexers(maxMultiplexers) {
+    active = this;
+}
+
+AnalogScannerBase::~AnalogScannerBase() {
+    if (active == this)
+        active = nullptr;
+}
+
+bool AnalogScannerBase::add(pin_t analogPin) {
+    if (numChannels == maxChannels)
+        return false;
+    addChannel({analogPin, analogPin, NO_MULTIPLEXER, 0, false, false, 0});
+    return true;
+}
+
+uint8_t AnalogScannerBase::addMultiplexer(Multiplexer mux) {
+    if (numMultiplexers == maxMultiplexers)
+        return NO_MULTIPLEXER;
+    uint8_t index = numMultiplexers++;
+    // Find the first multiplexer that uses the same address lines
+    mux.lineGroup = index;
+    for (uint8_t i = 0; i < index; ++i) {
+        const Multiplexer &other = multiplexers[i];
+        if (other.numAddressPins != mux.numAddressPins)
+            continue;
+        uint8_t p = 0;
+        while (p < mux.numAddressPins &&
+               other.addressPins[p] == mux.addressPins[p])
+            ++p;
+        if (p == mux.numAddressPins) {
+            mux.lineGroup = other.lineGroup;
+            break;
+        }
+    }
+    multiplexers[index] = mux;
+    return index;
+}
+
+void AnalogScannerBase::addChannel(Channel channel) {
+    channels[numChannels] = channel;
+    ++numChannels;
+    sorted = false;
+}
+
+/// Sort the channels in scan order: grouped by multiplexer address, and then
+/// by address lines, so the address lines change as little as possible.
+/// The pins that are not multiplexed go last. Also sort the channels by pin
+/// number, to look up the values.
+void AnalogScannerBase::sortChannels() {
+    // Restart the scan, the order changes
+    if (converting) {
+        deselect(channels[scanOrder[position]]);
+        converting = false;
+    }
+    auto scanKey = [this](uint8_t i) -> uint32_t {
+        const Channel &c = channels[i];
+        if (c.multiplexer == NO_MULTIPLEXER)
+            return uint32_t(0x1FF) << 16;
+        uint8_t group = multiplexers[c.multiplexer].lineGroup;
+        return (uint32_t(c.address) << 16) | (uint32_t(group) << 8) |
+               c.multiplexer;
+    };
+    // Insertion sort, it's only done once, and it's stable
+    for (uint8_t n = 0; n < numChannels; ++n) {
+        uint8_t i = n;
+        for (; i > 0 && scanKey(scanOrder[i - 1]) > scanKey(n); --i)
+            scanOrder[i] = scanOrder[i - 1];
+        scanOrder[i] = n;
+        i = n;
+        for (; i > 0 && channels[pinOrder[i - 1]].pin > channels[n].pin; --i)
+            pinOrder[i] = pinOrder[i - 1];
+        pinOrder[i] = n;
+    }
+    position = 0;
+    sorted = true;
+}
+
+void AnalogScannerBase::setBackend(AnalogScanBackend &backend) {
+    // Don't collect a conversion that was started by the old backend
+    if (converting) {
+        deselect(channels[scanOrder[position]]);
+        converting = false;
+    }
+    this->backend = &backend;
+}
+
+void AnalogScannerBase::select(const Channel &channel) {
+    if (channel.multiplexer == NO_MULTIPLEXER)
+        return;
+    const Multiplexer &mux = multiplexers[channel.multiplexer];
+    uint8_t &current = lineAddresses[mux.lineGroup];
+    if (current != channel.address) {
+        for (uint8_t p = 0; p < mux.numAddressPins; ++p)
+            ExtIO::digitalWrite(mux.addressPins[p],
+                                (channel.address >> p) & 1 ? HIGH : LOW);
+#if !defined(__AVR__) && defined(ARDUINO)
+        delayMicroseconds(SELECT_LINE_DELAY);
+#endif
+        current = channel.address;
+        ++addressChanges;
+    }
+    if (mux.enablePin != NO_PIN)
+        ExtIO::digitalWrite(mux.enablePin, LOW); // active low
+}
+
+void AnalogScannerBase::deselect(const Channel &channel) {
+    if (channel.multiplexer == NO_MULTIPLEXER)
+        return;
+    const Multiplexer &mux = multiplexers[channel.multiplexer];
+    if (mux.enablePin != NO_PIN)
+        ExtIO::digitalWrite(mux.enablePin, HIGH);
+}
+
+void AnalogScannerBase::invalidateLines() {
+    for (uint8_t i = 0; i < numMultiplexers; ++i)
+        lineAddresses[i] = 0xFF;
+}
+
+void AnalogScannerBase::startPass() {
+    addressChanges = 0;
+    conversions = 0;
+    if (adaptive)
+        passTime = millis();
+}
+
+bool AnalogScannerBase::isDue(uint8_t index) const {
+    return !adaptive || !channels[index].idle ||
+           index % idleInterval == idlePhase;
+}
+
+bool AnalogScannerBase::scan() {
+    if (!sorted)
+        sortChannels();
+    if (numChannels == 0)
+        return false;
+    // The scanner only owns the address lines during this call: in between,
+    // someone else (e.g. a `FilteredAnalog` that reads a multiplexer pin that
+    // isn't scanned) may have selected a different address.
+    invalidateLines();
+    if (!converting && position == 0)
+        startPass();
+    while (true) {
+        if (converting) {
+            if (!backend->isConversionReady())
+                return false;
+            uint8_t index = scanOrder[position];
+            Channel &channel = channels[index];
+            analog_t result = backend->getConversionResult();
+            if (discarding) {
+                discarding = false;
+                select(channel);
+                backend->startConversion(channel.analogPin);
+                continue;
+            }
+            values[index] = result;
+            channel.valid = true;
+            if (adaptive && !channel.idle &&
+                uint16_t(passTime - channel.lastActive) >= idleTimeout)
+                channel.idle = true;
+            deselect(channel);
+            converting = false;
+            ++conversions;
+            ++position;
+        }
+        // Skip the idle channels that are not converted during this pass
+        while (position < numChannels && !isDue(scanOrder[position]))
+            ++position;
+        if (position == numChannels) {
+            position = 0;
+            ++numScans;
+            lastAddressChanges = addressChanges;
+            lastConversions = conversions;
+            if (++idlePhase >= idleInterval)
+                idlePhase = 0;
+            return true;
+        }
+        const Channel &channel = channels[scanOrder[position]];
+        select(channel);
+        discarding = channel.multiplexer != NO_MULTIPLEXER &&
+                     multiplexers[channel.multiplexer].discardFirstReading;
+        backend->startConversion(channel.analogPin);
+        converting = true;
+    }
+}
+
+/// Returns the index into @ref pinOrder of the given pin, or the number of
+/// channels if the pin is not scanned.
+uint8_t AnalogScannerBase::findPin(pin_t pin) {
+    if (!sorted)
+        sortChannels();
+    // Binary search
+    uint8_t lo = 0, hi = numChannels;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (channels[pinOrder[mid]].pin < pin)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < numChannels && channels[pinOrder[lo]].pin != pin)
+        return numChannels;
+    return lo;
+}
+
+bool AnalogScannerBase::getValue(pin_t pin, analog_t &value) {
+    uint8_t i = findPin(pin);
+    if (i == numChannels)
+        return false;
+    const Channel &channel = channels[pinOrder[i]];
+    if (!channel.valid)
+        return false;
+    value = values[pinOrder[i]];
+    return true;
+}
+
+void AnalogScannerBase::enableAdaptiveSampling(uint16_t idleTimeout,
+                                               uint8_t idleInterval) {
+    this->idleTimeout = idleTimeout;
+    this->idleInterval = idleInterval > 0 ? idleInterval : 1;
+    this->idlePhase = 0;
+    this->passTime = millis();
+    for (uint8_t i = 0; i < numChannels; ++i) {
+        channels[i].idle = false;
+        channels[i].lastActive = passTime;
+    }
+    adaptive = true;
+}
+
+void AnalogScannerBase::disableAdaptiveSampling() {
+    adaptive = false;
+    for (uint8_t i = 0; i < numChannels; ++i)
+        channels[i].idle = false;
+}
+
+void AnalogScannerBase::wake(pin_t pin) {
+    uint8_t i = findPin(pin);
+    if (i == numChannels)
+        return;
+    // Also wake the neighbours, they're likely to be moved next
+    uint8_t first = i > 0 ? i - 1 : i;
+    uint8_t last = i + 1 < numChannels ? i + 1 : i;
+    for (uint8_t j = first; j <= last; ++j) {
+        Channel &channel = channels[pinOrder[j]];
+        channel.idle = false;
+        channel.lastActive = passTime;
+    }
+}
+
+uint8_t AnalogScannerBase::getSampleInterval(pin_t pin) {
+    uint8_t i = findPin(pin);
+    if (i == numChannels)
+        return 0;
+    return adaptive && channels[pinOrder[i]].idle ? idleInterval : 1;
+}
+
+uint8_t AnalogScannerBase::getNumberOfIdleChannels() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < numChannels; ++i)
+        count += adaptive && channels[i].idle;
+    return count;
+}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Containers/Updatable.hpp>
+#include <AH/Hardware/ExtendedInputOutput/AnalogMultiplex.hpp>
+#include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+#include <AH/Hardware/Hardware-Types.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   Performs the analog conversions for an @ref AnalogScanner.
+ *
+ * The scanner starts a conversion, and then polls the backend until the
+ * result is ready, so the main loop doesn't have to wait for the ADC. The
+ * default backend, @ref BlockingAnalogScanBackend, uses `analogRead`.
+ * A backend for a specific microcontroller can start the conversion by
+ * writing to the ADC registers, and check the “conversion complete” flag.
+ */
+class AnalogScanBackend {
+  public:
+    /// Start converting the voltage on the given pin.
+    virtual void startConversion(pin_t analogPin) = 0;
+    /// Check whether the conversion that was started last has completed.
+    virtual bool isConversionReady() = 0;
+    /// Get the result of the conversion that was started last. Only called
+    /// after @ref isConversionReady returned true.
+    virtual analog_t getConversionResult() = 0;
+
+  protected:
+    ~AnalogScanBackend() = default;
+};
+
+/// @ref AnalogScanBackend that uses a blocking `ExtIO::analogRead`.
+class BlockingAnalogScanBackend : public AnalogScanBackend {
+  public:
+    void startConversion(pin_t analogPin) override { pin = analogPin; }
+    bool isConversionReady() override { return true; }
+    analog_t getConversionResult() override { return ExtIO::analogRead(pin); }
+
+  private:
+    pin_t pin = NO_PIN;
+};
+
+/**
+ * @brief   Non-template base class of @ref AnalogScanner, which stores the
+ *          channels in arrays owned by the derived class.
+ */
+class AnalogScannerBase : public Updatable<AnalogScannerBase> {
+  public:
+    /// An analog input, either a pin of the microcontroller (or of an
+    /// ExtIO element), or a channel of a multiplexer.
+    struct Channel {
+        /// The pin number used to look up the value of the channel, i.e. the
+        /// pin that is passed to `FilteredAnalog`.
+        pin_t pin;
+        /// The pin that is converted by the ADC.
+        pin_t analogPin;
+        /// The index of the multiplexer, or @ref NO_MULTIPLEXER.
+        uint8_t multiplexer;
+        /// The address of the channel on the multiplexer.
+        uint8_t address;
+        /// Whether the value was converted at least once.
+        bool valid;
+        /// Whether the channel is sampled at the reduced rate.
+        bool idle;
+        /// Time of the last activity (lower 16 bits of `millis()`).
+        uint16_t lastActive;
+    };
+    /// The address lines, enable pin and settings of a multiplexer.
+    struct Multiplexer {
+        const pin_t *addressPins;
+        uint8_t numAddressPins;
+        pin_t enablePin;
+        bool discardFirstReading;
+        /// Index of the first multiplexer that uses the same address lines.
+        uint8_t lineGroup;
+    };
+    constexpr static uint8_t NO_MULTIPLEXER = 0xFF;
+
+  protected:
+    AnalogScannerBase(Channel *channels, analog_t *values, uint8_t *scanOrder,
+                      uint8_t *pinOrder, uint8_t maxChannels,
+                      Multiplexer *multiplexers, uint8_t *lineAddresses,
+                      uint8_t maxMultiplexers);
+
+  public:
+    // The pointers refer to the storage of the derived class.
+    AnalogScannerBase(const AnalogScannerBase &) = delete;
+    AnalogScannerBase &operator=(const AnalogScannerBase &) = delete;
+    ~AnalogScannerBase();
+
+    /// @name   Configuration
+    /// @{
+
+    /**
+     * @brief   Add an analog input pin to the scan.
+     * @return  False if there is no more space for the channel.
+     */
+    bool add(pin_t analogPin);
+
+    /**
+     * @brief   Add all channels of a multiplexer to the scan.
+     *
+     * Multiplexers that share their address lines are scanned together: the
+     * scanner selects an address once, and then converts the outputs of all
+     * these multiplexers, before moving on to the next address.
+     *
+     * @return  False if there is no more space for the multiplexer or its
+     *          channels.
+     */
+    template <uint8_t N>
+    bool add(AnalogMultiplex<N> &mux) {
+        if (numChannels + mux.getLength() > maxChannels)
+            return false;
+        uint8_t index = addMultiplexer({
+            mux.getAddressPins().data,
+            N,
+            mux.getEnablePin(),
+            mux.getDiscardFirstReading(),
+            0,
+        });
+        if (index == NO_MULTIPLEXER)
+            return false;
+        for (uint8_t address = 0; address < mux.getLength(); ++address)
+            addChannel({mux.pin(address), mux.getAnalogPin(), index, address,
+                        false, false, 0});
+        return true;
+    }
+
+    /// Use the given backend for the conversions, instead of the default
+    /// blocking `analogRead`.
+    void setBackend(AnalogScanBackend &backend);
+
+    /// @}
+
+    /// @name   Adaptive sampling
+    /// @{
+
+    /**
+     * @brief   Reduce the sampling rate of channels that are not being used.
+     *
+     * A channel becomes idle when no activity was reported for it during
+     * @p idleTimeout milliseconds. Idle channels are only converted once every
+     * @p idleInterval passes, so the ADC time goes to the channels that are
+     * actually moving, and a pass takes less time.
+     *
+     * Activity is reported by `FilteredAnalog` (and `FilteredAnalogBank`)
+     * when the output of its hysteresis changes, see @ref reportActivity.
+     * This makes the channel and its neighbours (the channels with the
+     * previous and next pin numbers, e.g. the faders next to it) run at the
+     * full rate again.
+     *
+     * @param   idleTimeout
+     *          The time without activity before a channel becomes idle, in
+     *          milliseconds.
+     * @param   idleInterval
+     *          The number of passes between two conversions of an idle
+     *          channel.
+     */
+    void enableAdaptiveSampling(uint16_t idleTimeout = 1000,
+                                uint8_t idleInterval = 8);
+    /// Convert all channels during every pass (default).
+    void disableAdaptiveSampling();
+    /// Check whether adaptive sampling is enabled.
+    bool isAdaptiveSamplingEnabled() const { return adaptive; }
+
+    /**
+     * @brief   Get the current sampling rate of the given pin, as the number
+     *          of passes between two conversions.
+     *
+     * @retval  0
+     *          The pin is not scanned.
+     * @retval  1
+     *          The pin is converted during every pass.
+     * @return  The idle interval if the pin is idle.
+     */
+    uint8_t getSampleInterval(pin_t pin);
+    /// Get the number of channels that are currently idle.
+    uint8_t getNumberOfIdleChannels() const;
+
+    /// @}
+
+    /// @name   Scanning
+    /// @{
+
+    /// Does nothing, the multiplexers are initialized by
+    /// `ExtendedIOElement::beginAll()`.
+    void begin() override {}
+    /// @copydoc scan
+    void update() override { scan(); }
+
+    /**
+     * @brief   Convert as many channels as possible without waiting for the
+     *          ADC, and save the results in the snapshot buffer.
+     *
+     * With a blocking backend, this does a full pass over all channels.
+     * With a non-blocking backend, this collects the result of the pending
+     * conversion (if it is ready), and starts the next one. The address
+     * lines of the multiplexers are selected again during every call, since
+     * they may have been changed by someone else in between.
+     *
+     * @return  True if a pass over all channels was completed.
+     */
+    bool scan();
+
+    /// @}
+
+    /// @name   Reading the snapshot buffer
+    /// @{
+
+    /**
+     * @brief   Get the value of the given pin from the last scan.
+     *
+     * @param   pin
+     *          The pin to look up, either an analog pin or a pin of a
+     *          multiplexer that was added.
+     * @param[out]  value
+     *          The last converted value of that pin.
+     * @return  False if the pin is not scanned, or if it hasn't been converted
+     *          yet.
+     */
+    bool getValue(pin_t pin, analog_t &value);
+
+    /// Get the number of channels that are scanned.
+    uint8_t getNumberOfChannels() const { return numChannels; }
+    /// Get the number of passes over all channels that were completed.
+    uint32_t getNumberOfScans() const { return numScans; }
+    /// Get the number of times the address lines of a multiplexer were
+    /// changed during the last complete pass.
+    uint16_t getAddressChangesPerScan() const { return lastAddressChanges; }
+    /// Get the number of channels that were converted during the last
+    /// complete pass (not counting discarded readings).
+    uint8_t getConversionsPerScan() const { return lastConversions; }
+
+    /// @}
+
+    /**
+     * @brief   Get the value of the given pin from the snapshot buffer of the
+     *          active scanner. Used by `FilteredAnalog`.
+     *
+     * @return  False if there is no active scanner, or if the pin is not
+     *          scanned (yet), in which case the pin should be read directly.
+     */
+    static bool getSnapshot(pin_t pin, analog_t &value) {
+        return active != nullptr && active->getValue(pin, value);
+    }
+    /// Get the active scanner, i.e. the one that was created last.
+    static AnalogScannerBase *getActive() { return active; }
+
+    /**
+     * @brief   Report that the value of the given pin changed, so the active
+     *          scanner samples it (and its neighbours) at the full rate.
+     *          Used by `FilteredAnalog` if adaptive sampling is enabled.
+     */
+    static void reportActivity(pin_t pin) {
+        if (active != nullptr && active->adaptive)
+            active->wake(pin);
+    }
+
+  private:
+    uint8_t findPin(pin_t pin);
+    void wake(pin_t pin);
+    void invalidateLines();
+    void startPass();
+    bool isDue(uint8_t index) const;
+    uint8_t addMultiplexer(Multiplexer mux);
+    void addChannel(Channel channel);
+    void sortChannels();
+    void select(const Channel &channel);
+    void deselect(const Channel &channel);
+
+  private:
+    Channel *channels;
+    analog_t *values;
+    uint8_t *scanOrder;
+    uint8_t *pinOrder;
+    uint8_t maxChannels;
+    uint8_t numChannels = 0;
+
+    Multiplexer *multiplexers;
+    /// The address that is currently selected on the address lines of each
+    /// line group, indexed by the @ref Multiplexer::lineGroup.
+    uint8_t *lineAddresses;
+    uint8_t maxMultiplexers;
+    uint8_t numMultiplexers = 0;
+
+    BlockingAnalogScanBackend defaultBackend;
+    AnalogScanBackend *backend = &defaultBackend;
+
+    /// Index into @ref scanOrder of the channel that is being converted.
+    uint8_t position = 0;
+    bool converting = false;
+    bool discarding = false;
+    bool sorted = true;
+    uint16_t addressChanges = 0;
+    uint16_t lastAddressChanges = 0;
+    uint8_t conversions = 0;
+    uint8_t lastConversions = 0;
+    uint32_t numScans = 0;
+
+    bool adaptive = false;
+    uint16_t idleTimeout = 0;
+    uint8_t idleInterval = 1;
+    /// Idle channels with `index % idleInterval == idlePhase` are converted
+    /// during the current pass.
+    uint8_t idlePhase = 0;
+    /// Time at the start of the current pass (lower 16 bits of `millis()`).
+    uint16_t passTime = 0;
+
+    static AnalogScannerBase *active;
+};
+
+/**
+ * @brief   Central scheduler that reads all analog inputs in an efficient
+ *          order, and saves the values in a snapshot buffer.
+ *
+ * Without a scanner, every `FilteredAnalog` (and therefore every potentiometer
+ * or fader) reads its own input using a blocking `analogRead`. An input of an
+ * @ref AnalogMultiplex changes the address lines, waits for them to settle,
+ * and optionally discards a first reading, for every single channel.
+ *
+ * The scanner reads the channels of all multiplexers grouped by address:
+ * if multiple multiplexers share their address lines, an address is selected
+ * only once, and the outputs of all multiplexers are converted before moving
+ * on to the next address. With a non-blocking @ref AnalogScanBackend, the main
+ * loop doesn't have to wait for the conversions either.
+ *
+ * While a scanner exists, `FilteredAnalog::update()` uses the value from the
+ * snapshot buffer for the pins that are scanned, and reads the other pins
+ * directly. The scanners are updated in their own `Updatable` group, which
+ * `Control_Surface.loop()` updates before all other inputs. Without Control
+ * Surface, call @ref scan before updating the `FilteredAnalog` objects.
+ *
+ * ~~~cpp
+ * CD74HC4067 muxA {A0, {2, 3, 4, 5}};
+ * CD74HC4067 muxB {A1, {2, 3, 4, 5}};
+ * AnalogScanner<32> scanner;
+ *
+ * void setup() {
+ *     scanner.add(muxA);
+ *     scanner.add(muxB);
+ *     Control_Surface.begin();
+ * }
+ * ~~~
+ *
+ * Only the scanner that was created last is used by `FilteredAnalog`.
+ *
+ * For large consoles, @ref enableAdaptiveSampling lowers the sampling rate of
+ * the faders and potentiometers that aren't being touched, which shortens the
+ * passes, and therefore the latency of the ones that are moving.
+ *
+ * @tparam  MaxChannels
+ *          The maximum number of analog inputs to scan.
+ * @tparam  MaxMultiplexers
+ *          The maximum number of multiplexers.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <uint8_t MaxChannels, uint8_t MaxMultiplexers = 8>
+class AnalogScanner : public AnalogScannerBase {
+  public:
+    AnalogScanner()
+        : AnalogScannerBase(channels, values, scanOrder, pinOrder, MaxChannels,
+                            multiplexers, lineAddresses, MaxMultiplexers) {}
+
+  private:
+    Channel channels[MaxChannels];
+    analog_t values[MaxChannels] = {};
+    uint8_t scanOrder[MaxChannels];
+    uint8_t pinOrder[MaxChannels];
+    Multiplexer multiplexers[MaxMultiplexers];
+    uint8_t lineAddresses[MaxMultiplexers];
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
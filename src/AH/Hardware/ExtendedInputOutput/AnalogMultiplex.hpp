@@ -145,6 +145,17 @@ class AnalogMultiplex : public StaticSizeExtendedIOElement<1 << N> {
     void discardFirstReading(bool discardFirstReading_) {
         this->discardFirstReading_ = discardFirstReading_;
     }
+    /// Check whether the first analog reading after changing the address
+    /// lines is discarded.
+    bool getDiscardFirstReading() const { return discardFirstReading_; }
+
+    /// Get the analog input pin connected to the output of the multiplexer.
+    pin_t getAnalogPin() const { return analogPin; }
+    /// Get the pins connected to the address lines of the multiplexer.
+    const Array<pin_t, N> &getAddressPins() const { return addressPins; }
+    /// Get the pin connected to the enable pin of the multiplexer, or
+    /// `NO_PIN`.
+    pin_t getEnablePin() const { return enablePin; }
 
   protected:
     const pin_t analogPin;
@@ -4,6 +4,7 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 #include "ExtendedIOElement.hpp"
 #include <AH/Error/Error.hpp>
 #include <AH/STL/type_traits> // is_unsigned
+#include <AH/STL/utility>     // std::move
 
 BEGIN_AH_NAMESPACE
 
@@ -15,8 +16,17 @@ ExtendedIOElement::ExtendedIOElement(pin_t length)
                       "recommended."),
                     0x00FF);
     offset = end;
+    ExtIO::invalidatePinIndex();
 }
 
+ExtendedIOElement::ExtendedIOElement(ExtendedIOElement &&other)
+    : UpdatableCRTP<ExtendedIOElement>(std::move(other)), length(other.length),
+      start(other.start), end(other.end) {
+    ExtIO::invalidatePinIndex();
+}
+
+ExtendedIOElement::~ExtendedIOElement() { ExtIO::invalidatePinIndex(); }
+
 void ExtendedIOElement::beginAll() {
     ExtendedIOElement::applyToAll(&ExtendedIOElement::begin);
 }
@@ -76,10 +76,14 @@ class ExtendedIOElement : public UpdatableCRTP<ExtendedIOElement> {
     ExtendedIOElement &operator=(const ExtendedIOElement &) = delete;
 
     /// Move constructor.
-    ExtendedIOElement(ExtendedIOElement &&) = default;
+    ExtendedIOElement(ExtendedIOElement &&);
     /// Move assignment.
     ExtendedIOElement &operator=(ExtendedIOElement &&) = delete;
 
+  public:
+    /// Destructor.
+    ~ExtendedIOElement() override;
+
   public:
     /** 
      * @brief   Set the mode of a given pin.
@@ -4,6 +4,8 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 #include "ExtendedIOElement.hpp"
 #include "ExtendedInputOutput.hpp"
 #include <AH/Error/Error.hpp>
+#include <AH/STL/algorithm> // std::min
+#include <AH/Settings/SettingsWrapper.hpp>
 
 BEGIN_AH_NAMESPACE
 
@@ -14,15 +16,98 @@ static bool inRange(T target, T start, T end) {
     return target >= start && target < end;
 }
 
-ExtendedIOElement *getIOElementOfPinOrNull(pin_t pin) {
+/// Linear search. Doesn't assume that the list is sorted, because elements
+/// that are re-enabled are added to the end.
+static ExtendedIOElement *searchIOElementOfPin(pin_t pin) {
     for (auto &el : ExtendedIOElement::getAll())
-        if (pin < el.getStart())
-            break;
-        else if (inRange(pin, el.getStart(), el.getEnd()))
+        if (inRange(pin, el.getStart(), el.getEnd()))
             return &el;
     return nullptr;
 }
 
+/// Maps pin numbers to elements in (nearly) constant time. The elements are
+/// sorted by their start pin, and the range from the start of the first
+/// element to the end of the last one is divided into a power-of-two number
+/// of buckets of equal size. Each bucket stores the first element that
+/// overlaps with it, so a lookup only checks the elements of a single bucket.
+namespace PinIndex {
+
+static_assert((EXTIO_PIN_INDEX_BUCKETS & (EXTIO_PIN_INDEX_BUCKETS - 1)) == 0,
+              "EXTIO_PIN_INDEX_BUCKETS must be a power of two");
+
+static ExtendedIOElement *elements[EXTIO_PIN_INDEX_SIZE];
+static uint8_t buckets[EXTIO_PIN_INDEX_BUCKETS];
+static uint8_t size = 0;
+static pin_t base = 0;
+static uint8_t shift = 0;
+static bool valid = false;
+
+static void rebuild() {
+    size = 0;
+    for (auto &el : ExtendedIOElement::getAll()) {
+        if (size == EXTIO_PIN_INDEX_SIZE)
+            break;
+        // Insertion sort, the list is usually sorted already
+        uint8_t i = size++;
+        for (; i > 0 && elements[i - 1]->getStart() > el.getStart(); --i)
+            elements[i] = elements[i - 1];
+        elements[i] = &el;
+    }
+    valid = true;
+    if (size == 0)
+        return;
+    base = elements[0]->getStart();
+    pin_t range = 0;
+    for (uint8_t i = 0; i < size; ++i)
+        if (pin_t(elements[i]->getEnd() - base) > range)
+            range = elements[i]->getEnd() - base;
+    shift = 0;
+    while (((range - 1) >> shift) >= EXTIO_PIN_INDEX_BUCKETS)
+        ++shift;
+    uint8_t i = 0;
+    for (uint16_t b = 0; b < EXTIO_PIN_INDEX_BUCKETS; ++b) {
+        uint32_t bucketStart = base + (uint32_t(b) << shift);
+        while (i < size && elements[i]->getEnd() <= bucketStart)
+            ++i;
+        buckets[b] = i;
+    }
+}
+
+static ExtendedIOElement *find(pin_t pin) {
+    if (!valid)
+        rebuild();
+    if (size == 0 || pin < base)
+        return nullptr;
+    uint16_t b = (pin - base) >> shift;
+    if (b >= EXTIO_PIN_INDEX_BUCKETS)
+        return nullptr;
+    for (uint8_t i = buckets[b]; i < size; ++i) {
+        ExtendedIOElement *el = elements[i];
+        if (pin < el->getStart())
+            break;
+        if (pin < el->getEnd())
+            return el;
+    }
+    return nullptr;
+}
+
+} // namespace PinIndex
+
+void invalidatePinIndex() { PinIndex::valid = false; }
+
+ExtendedIOElement *getIOElementOfPinOrNull(pin_t pin) {
+    ExtendedIOElement *el = PinIndex::find(pin);
+    // Elements that were disabled or re-enabled after building the index, and
+    // elements that didn't fit in the index are found using a linear search
+    if (el != nullptr && el->isEnabled())
+        return el;
+    bool disabled = el != nullptr;
+    el = searchIOElementOfPin(pin);
+    if (disabled || (el != nullptr && PinIndex::size < EXTIO_PIN_INDEX_SIZE))
+        invalidatePinIndex();
+    return el;
+}
+
 ExtendedIOElement *getIOElementOfPin(pin_t pin) {
     auto *el = getIOElementOfPinOrNull(pin);
     if (el == nullptr)
@@ -174,6 +259,38 @@ void analogWriteBuffered(pin_t pin, int val) {
     analogWriteBuffered(pin, (analog_t)val);
 }
 
+void digitalReadMany(pin_t start, PinStatus_t *values, pin_t count) {
+    pin_t pin = start;
+    const pin_t end = start + count;
+    while (pin != end) {
+        if (isNativePin(pin)) {
+            *values++ = ::digitalRead(pin++);
+            continue;
+        }
+        auto el = getIOElementOfPin(pin);
+        el->updateBufferedInputs();
+        pin_t n = std::min<pin_t>(end - pin, el->getEnd() - pin);
+        for (pin_t i = 0; i < n; ++i)
+            *values++ = el->digitalReadBuffered(pin++ - el->getStart());
+    }
+}
+
+void digitalWriteMany(pin_t start, const PinStatus_t *values, pin_t count) {
+    pin_t pin = start;
+    const pin_t end = start + count;
+    while (pin != end) {
+        if (isNativePin(pin)) {
+            ::digitalWrite(pin++, *values++);
+            continue;
+        }
+        auto el = getIOElementOfPin(pin);
+        pin_t n = std::min<pin_t>(end - pin, el->getEnd() - pin);
+        for (pin_t i = 0; i < n; ++i)
+            el->digitalWriteBuffered(pin++ - el->getStart(), *values++);
+        el->updateBufferedOutputs();
+    }
+}
+
 void shiftOut(pin_t dataPin, pin_t clockPin, BitOrder_t bitOrder, uint8_t val) {
     if (dataPin == NO_PIN || clockPin == NO_PIN)
         return;
@@ -31,6 +31,9 @@ inline bool isNativePin(pin_t pin) {
 /**
  * @brief   Find the IO element of a given extended IO pin number. 
  * 
+ * Uses an index that is rebuilt after ExtendedIOElement%s are created or
+ * destroyed, see @ref EXTIO_PIN_INDEX_SIZE.
+ * 
  * @param   pin
  *          The extended IO pin number to find the IO element of.
  * @return  A pointer to the extended IO element that the given pin belongs to.
@@ -39,6 +42,10 @@ ExtendedIOElement *getIOElementOfPinOrNull(pin_t pin);
 /// @copydoc getIOElementOfPinOrNull
 /// Throws an error if the element was not found.
 ExtendedIOElement *getIOElementOfPin(pin_t pin);
+/// Mark the pin index of @ref getIOElementOfPinOrNull as outdated, so it is
+/// rebuilt during the next lookup. Called by the constructors and destructor
+/// of ExtendedIOElement.
+void invalidatePinIndex();
 
 /// An ExtIO version of the Arduino function
 /// @see    ExtendedIOElement::pinMode
@@ -74,6 +81,19 @@ void analogWrite(int pin, analog_t val);
 void analogWrite(int pin, int val);
 #endif
 
+/// Read the given number of consecutive pins, starting at @p start.
+/// The element that owns the pins is only looked up once, and its inputs are
+/// only updated once (e.g. a single SPI transfer for a shift register),
+/// instead of once per pin. The range may span multiple elements.
+/// @see    ExtendedIOElement::digitalReadBuffered
+void digitalReadMany(pin_t start, PinStatus_t *values, pin_t count);
+/// Write the given number of consecutive pins, starting at @p start.
+/// The element that owns the pins is only looked up once, and its outputs are
+/// only updated once, after writing all of its pins. The range may span
+/// multiple elements.
+/// @see    ExtendedIOElement::digitalWriteBuffered
+void digitalWriteMany(pin_t start, const PinStatus_t *values, pin_t count);
+
 /// An ExtIO version of the Arduino function
 void shiftOut(pin_t dataPin, pin_t clockPin, BitOrder_t bitOrder, uint8_t val);
 /// Overload to Arduino shiftOut function
@@ -1,3 +1,3 @@
 #ifdef TEST_COMPILE_ALL_HEADERS_SEPARATELY
-// #include "MAX7219.hpp" // TODO
+#include "MAX7219.hpp"
 #endif
\ No newline at end of file
@@ -45,8 +45,7 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
 
   private:
     struct IndexMask {
-        uint8_t row;
-        uint8_t col;
+        uint8_t chip;
         uint8_t rowgrp;
         uint8_t rowmask;
         uint8_t colmask;
@@ -55,10 +54,20 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
     static IndexMask pin2index(pin_t pin) {
         uint8_t row = pin / 8;
         uint8_t col = pin % 8;
+        uint8_t chip = row / 8;
         uint8_t rowgrp = row % 8;
         uint8_t rowmask = 1 << rowgrp;
         uint8_t colmask = 1 << col;
-        return {row, col, rowgrp, rowmask, colmask};
+        return {chip, rowgrp, rowmask, colmask};
+    }
+
+    /// Set or clear a bit in the framebuffer, which marks its row dirty if
+    /// it changed.
+    void writeBuffer(IndexMask i, PinStatus_t val) {
+        uint8_t row = buffer.get(i.chip, i.rowgrp);
+        buffer.set(i.chip, i.rowgrp,
+                   val ? row | i.colmask     // set the pin (high)
+                       : row & ~i.colmask); // clear the pin (low)
     }
 
   public:
@@ -92,8 +101,7 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
      */
     void digitalWrite(pin_t pin, PinStatus_t val) override {
         IndexMask i = pin2index(pin);
-        val ? buffer[i.row] |= i.colmask   // set the pin (high)
-            : buffer[i.row] &= ~i.colmask; // clear the pin (low)
+        writeBuffer(i, val);
         updateBufferedOutputRow(i);
     }
 
@@ -104,10 +112,7 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
      * @copydetails digitalWrite
      */
     void digitalWriteBuffered(pin_t pin, PinStatus_t val) override {
-        IndexMask i = pin2index(pin);
-        val ? buffer[i.row] |= i.colmask   // set the pin (high)
-            : buffer[i.row] &= ~i.colmask; // clear the pin (low)
-        dirty_rows |= i.rowmask;
+        writeBuffer(pin2index(pin), val);
     }
 
     /**
@@ -122,7 +127,7 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
      */
     PinStatus_t digitalRead(pin_t pin) override {
         IndexMask i = pin2index(pin);
-        return bool(buffer[i.row] & i.colmask) ? HIGH : LOW;
+        return bool(buffer.get(i.chip, i.rowgrp) & i.colmask) ? HIGH : LOW;
     }
 
     /**
@@ -130,7 +135,7 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
      */
     PinStatus_t digitalReadBuffered(pin_t pin) override {
         IndexMask i = pin2index(pin);
-        return bool(buffer[i.row] & i.colmask) ? HIGH : LOW;
+        return bool(buffer.get(i.chip, i.rowgrp) & i.colmask) ? HIGH : LOW;
     }
 
     /**
@@ -181,28 +186,19 @@ class MAX7219 : public MAX7219_Base<SPIDriver>,
         digitalWrite(pin, val >= 0x80 ? HIGH : LOW);
     }
 
+    /// Send the given row if it changed in any of the chips.
     void updateBufferedOutputRow(IndexMask i) {
-        this->sendRowAll(i.rowgrp, buffer.data + i.rowgrp, 8);
-        dirty_rows &= ~i.rowmask;
+        this->sendChanged(buffer, i.rowmask);
     }
 
-    void updateBufferedOutputs() override {
-        if (dirty_rows == 0)
-            return;
-        uint8_t row = 8;
-        do {
-            --row;
-            if (dirty_rows & 0x80)
-                this->sendRowAll(row, buffer.data + row, 8);
-            dirty_rows <<= 1;
-        } while (row);
-    }
+    /// Send the rows that changed. Chips whose row didn't change receive a
+    /// No-Op.
+    void updateBufferedOutputs() override { this->sendChanged(buffer); }
 
     void updateBufferedInputs() override {}
 
   private:
-    Array<uint8_t, 8 * NumChips> buffer;
-    uint8_t dirty_rows = 0xFF;
+    MAX7219_FrameBuffer<NumChips> buffer;
 };
 
 END_AH_NAMESPACE
@@ -68,12 +68,61 @@ class SPIShiftRegisterOut : public ShiftRegisterOutBase<N> {
 
     /**
      * @brief   Write the state buffer to the physical outputs.
+     * 
+     * Nothing is sent if none of the outputs changed since the last update,
+     * or if the previous (asynchronous) transfer is still in progress.
+     * Otherwise, the entire chain is shifted out in a single bulk transfer
+     * using @ref startTransfer.
      */
     void updateBufferedOutputs() override;
 
-  private:
+    /**
+     * @brief   Check whether an asynchronous transfer started by
+     *          @ref startTransfer is still in progress.
+     */
+    bool isTransferInProgress() const { return transferInProgress; }
+
+    /**
+     * @brief   Latch the data that was shifted out to the outputs, and end the
+     *          SPI transaction.
+     * 
+     * If @ref startTransfer is overridden to start an asynchronous (DMA)
+     * transfer, this function should be called from its completion callback.
+     */
+    void finishTransfer();
+
+  protected:
+    /**
+     * @brief   Shift out the given bytes, in transmit order.
+     * 
+     * The default implementation does a blocking bulk transfer using
+     * `spi.transfer(data, length)`. Derived classes can override it to start
+     * an asynchronous or DMA transfer instead, and return false. The buffer
+     * is not modified until @ref finishTransfer is called.
+     * 
+     * @param   data
+     *          The bytes to send. May be overwritten by the received data.
+     * @param   length
+     *          The number of bytes to send.
+     * @retval  true
+     *          The transfer is complete, @ref finishTransfer is called
+     *          immediately.
+     * @retval  false
+     *          The transfer is still in progress, the caller of this function
+     *          is responsible for calling @ref finishTransfer when it
+     *          completes.
+     */
+    virtual bool startTransfer(uint8_t *data, uint16_t length);
+
+  protected:
     SPIDriver spi;
 
+  private:
+    /// Copy of the buffer in transmit order, because SPI bulk transfers
+    /// overwrite the data they send.
+    uint8_t txBuffer[(N + 7) / 8];
+    volatile bool transferInProgress = false;
+
   public:
     SPISettings settings{SPI_MAX_SPEED, this->bitOrder, SPI_MODE0};
 };
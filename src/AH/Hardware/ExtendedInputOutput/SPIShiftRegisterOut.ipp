@@ -1,5 +1,3 @@
-#ifdef ARDUINO // TODO: I'm too lazy to mock the SPI library
-
 #include "ExtendedInputOutput.hpp"
 #include "SPIShiftRegisterOut.hpp"
 
@@ -25,22 +23,37 @@ void SPIShiftRegisterOut<N, SPIDriver>::begin() {
 
 template <uint16_t N, class SPIDriver>
 void SPIShiftRegisterOut<N, SPIDriver>::updateBufferedOutputs() {
-    if (!this->dirty)
+    if (!this->dirty || transferInProgress)
         return;
-    spi.beginTransaction(settings);
-    ExtIO::digitalWrite(this->latchPin, LOW);
     const uint16_t bufferLength = this->buffer.getBufferLength();
     if (this->bitOrder == LSBFIRST)
         for (uint16_t i = 0; i < bufferLength; i++)
-            spi.transfer(this->buffer.getByte(i));
+            txBuffer[i] = this->buffer.getByte(i);
     else
-        for (uint16_t i = bufferLength; i-->0;)
-            spi.transfer(this->buffer.getByte(i));
+        for (uint16_t i = 0; i < bufferLength; i++)
+            txBuffer[i] = this->buffer.getByte(bufferLength - 1 - i);
+    // Changes made during an asynchronous transfer make the buffer dirty
+    // again, so they are sent during the next update.
+    this->dirty = false;
+    transferInProgress = true;
+    spi.beginTransaction(settings);
+    ExtIO::digitalWrite(this->latchPin, LOW);
+    if (startTransfer(txBuffer, bufferLength))
+        finishTransfer();
+}
+
+template <uint16_t N, class SPIDriver>
+bool SPIShiftRegisterOut<N, SPIDriver>::startTransfer(uint8_t *data,
+                                                      uint16_t length) {
+    spi.transfer(data, length);
+    return true;
+}
+
+template <uint16_t N, class SPIDriver>
+void SPIShiftRegisterOut<N, SPIDriver>::finishTransfer() {
     ExtIO::digitalWrite(this->latchPin, HIGH);
     spi.endTransaction();
-    this->dirty = false;
+    transferInProgress = false;
 }
 
 END_AH_NAMESPACE
-
-#endif
\ No newline at end of file
@@ -190,6 +190,10 @@ class ShiftRegisterOutBase : public StaticSizeExtendedIOElement<N> {
     const BitOrder_t bitOrder;
 
     BitArray<N> buffer;
+    /// Set when a bit of the buffer changes, cleared when the buffer is
+    /// written to the shift registers. Writing the value a pin already has
+    /// doesn't make the buffer dirty, so @ref updateBufferedOutputs only
+    /// shifts out data when an output actually changed.
     bool dirty = true;
 };
 
@@ -11,14 +11,16 @@ ShiftRegisterOutBase<N>::ShiftRegisterOutBase(pin_t latchPin,
 
 template <uint16_t N>
 void ShiftRegisterOutBase<N>::digitalWrite(pin_t pin, PinStatus_t val) {
-    buffer.set(pin, val);
-    dirty = true;
-    this->updateBufferedOutputs(); // TODO: should I always update?
+    digitalWriteBuffered(pin, val);
+    this->updateBufferedOutputs(); // Does nothing if the pin didn't change
 }
 
 template <uint16_t N>
 void ShiftRegisterOutBase<N>::digitalWriteBuffered(pin_t pin, PinStatus_t val) {
-    buffer.set(pin, val);
+    bool state = val != LOW;
+    if (buffer.get(pin) == state)
+        return;
+    buffer.set(pin, state);
     dirty = true;
 }
 
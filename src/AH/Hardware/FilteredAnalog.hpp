@@ -5,6 +5,7 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
 #include <AH/Filters/EMA.hpp>
 #include <AH/Filters/Hysteresis.hpp>
+#include <AH/Hardware/AnalogScanner.hpp>
 #include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
 #include <AH/Hardware/Hardware-Types.hpp>
 #include <AH/Math/IncreaseBitDepth.hpp>
@@ -113,6 +114,10 @@ class GenericFilteredAnalog {
      * @brief   Read the analog input value, apply the mapping function, and
      *          update the average.
      *
+     * If the pin is scanned by an @ref AnalogScanner with adaptive sampling,
+     * changes are reported to the scanner, see
+     * @ref AnalogScannerBase::enableAdaptiveSampling.
+     *
      * @retval  true
      *          The value changed since last time it was updated.
      * @retval  false
@@ -122,8 +127,10 @@ class GenericFilteredAnalog {
         AnalogType input = getRawValue(); // read the raw analog input value
         input = filter.filter(input);     // apply a low-pass EMA filter
         input = mapFnHelper(input);       // apply the mapping function
-        return hysteresis.update(input);  // apply hysteresis, and return true
-        // if the value changed since last time
+        bool changed = hysteresis.update(input); // apply hysteresis
+        if (changed) // let the scanner know this input is being used
+            AnalogScannerBase::reportActivity(analogPin);
+        return changed; // return true if the value changed since last time
     }
 
     /**
@@ -152,9 +159,15 @@ class GenericFilteredAnalog {
     /**
      * @brief   Read the raw value of the analog input without any filtering or
      *          mapping applied, but with its bit depth increased by @c IncRes.
+     * 
+     * If the pin is scanned by an @ref AnalogScanner, the value from its
+     * snapshot buffer is used, instead of reading the analog input.
      */
     AnalogType getRawValue() const {
-        AnalogType value = ExtIO::analogRead(analogPin);
+        analog_t reading;
+        if (!AnalogScannerBase::getSnapshot(analogPin, reading))
+            reading = ExtIO::analogRead(analogPin);
+        AnalogType value = reading;
 #ifdef ESP8266
         if (value > 1023)
             value = 1023;
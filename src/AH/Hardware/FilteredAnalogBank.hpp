@@ -0,0 +1,308 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Containers/Array.hpp>
+#include <AH/Containers/BitArray.hpp>
+#include <AH/Hardware/FilteredAnalog.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   A bank of analog inputs that are filtered in a single pass, with
+ *          the same results as a @ref FilteredAnalog for each input.
+ *
+ * Every @ref FilteredAnalog object has its own filter, hysteresis and mapping
+ * function, and each one is updated separately. For large numbers of faders
+ * or potentiometers, it's more efficient to store the states of the EMA
+ * filters and the hysteresis levels of all inputs in contiguous arrays, and
+ * update them in one tight loop, which the compiler can unroll or vectorize.
+ *
+ * After each update, a bit mask indicates which of the inputs changed, so
+ * the code that uses the values only has to look at those inputs.
+ *
+ * @tparam  N
+ *          The number of analog inputs.
+ * @tparam  Precision
+ *          The number of bits of precision the output should have.
+ * @tparam  FilterShiftFactor
+ *          The number of bits used for the EMA filters.
+ * @tparam  FilterType
+ *          The type to use for the intermediate types of the filters.
+ * @tparam  AnalogType
+ *          The type to use for the analog values.
+ * @tparam  IncRes
+ *          The number of bits to increase the resolution of the analog reading
+ *          by.
+ *
+ * @see     FilteredAnalog
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <uint8_t N, uint8_t Precision = 10,
+          uint8_t FilterShiftFactor = ANALOG_FILTER_SHIFT_FACTOR,
+          class FilterType = ANALOG_FILTER_TYPE, class AnalogType = analog_t,
+          uint8_t IncRes = MaximumFilteredAnalogIncRes<
+              FilterShiftFactor, FilterType, AnalogType>::value>
+class FilteredAnalogBank {
+  public:
+    /// A function pointer to a mapping function to map analog values.
+    /// @see    map()
+    using MappingFunction = AnalogType (*)(AnalogType);
+
+    /**
+     * @brief   Construct a new FilteredAnalogBank object.
+     *
+     * @param   analogPins
+     *          The analog pins to read from.
+     * @param   initial
+     *          The initial value of the filters.
+     */
+    FilteredAnalogBank(const Array<pin_t, N> &analogPins,
+                       AnalogType initial = 0)
+        : analogPins(analogPins) {
+        AnalogType widevalue = increaseBitDepth<ADC_BITS + IncRes, Precision,
+                                                AnalogType, AnalogType>(initial);
+        for (uint8_t i = 0; i < N; ++i) {
+            resetChannel(i, widevalue);
+            levels[i] = 0; // like FilteredAnalog, hysteresis starts at zero
+        }
+    }
+
+    /// @copydoc FilteredAnalog::reset
+    void reset(AnalogType value = 0) {
+        AnalogType widevalue = increaseBitDepth<ADC_BITS + IncRes, Precision,
+                                                AnalogType, AnalogType>(value);
+        for (uint8_t i = 0; i < N; ++i)
+            resetChannel(i, widevalue);
+    }
+
+    /**
+     * @brief   Reset the filtered values to the values that are currently
+     *          being measured at the analog inputs.
+     *
+     * This is useful to avoid transient effects upon initialization.
+     */
+    void resetToCurrentValue() {
+        for (uint8_t i = 0; i < N; ++i)
+            resetChannel(i, getRawValue(i));
+    }
+
+    /**
+     * @brief   Specify a mapping function that is applied to the analog
+     *          value of the given input after filtering and before applying
+     *          hysteresis.
+     *
+     * Inputs without a mapping function are handled entirely by the batch
+     * loop, the mapping functions are called separately.
+     *
+     * @param   index
+     *          The index of the input.
+     * @param   fn
+     *          The mapping function, or `nullptr` to disable mapping.
+     *
+     * @see     FilteredAnalog::map
+     */
+    void map(uint8_t index, MappingFunction fn) {
+        mapFns[index] = fn;
+        mapped = false;
+        for (MappingFunction f : mapFns)
+            mapped |= f != nullptr;
+    }
+
+    /// Get the mapping function of the given input.
+    MappingFunction getMappingFunction(uint8_t index) const {
+        return mapFns[index];
+    }
+
+    /// Invert the analog value of the given input.
+    /// @note   This overrides the mapping function set by the `map` method.
+    void invert(uint8_t index) {
+        constexpr AnalogType maxval = getMaxRawValue();
+        map(index, [](AnalogType val) -> AnalogType { return maxval - val; });
+    }
+
+    /**
+     * @brief   Read all analog inputs, and update the filters.
+     *
+     * Inputs that are scanned by an @ref AnalogScanner use the value from its
+     * snapshot buffer, and changes are reported to the scanner for adaptive
+     * sampling.
+     *
+     * @retval  true
+     *          At least one of the values changed since the last update.
+     *          Use @ref hasChanged or @ref getChanges to find out which ones.
+     * @retval  false
+     *          All values are still the same.
+     */
+    bool update() {
+        analog_t readings[N];
+        for (uint8_t i = 0; i < N; ++i)
+            readings[i] = read(analogPins[i]);
+        if (!update(readings))
+            return false;
+        for (uint8_t i = 0; i < N; ++i)
+            if (hasChanged(i))
+                AnalogScannerBase::reportActivity(analogPins[i]);
+        return true;
+    }
+
+    /**
+     * @brief   Update the filters using the given analog readings, e.g. from
+     *          a DMA buffer or from an @ref AnalogScanner.
+     *
+     * @param   readings
+     *          Array of @p N raw analog readings of @ref ADC_BITS bits wide.
+     *
+     * @copydetails update()
+     */
+    bool update(const analog_t *readings) {
+        constexpr uint8_t fullBytes = N / 8;
+        uint8_t any = 0;
+        for (uint8_t b = 0; b < fullBytes; ++b) {
+            uint8_t mask = updateChunk(readings, b * 8, 8);
+            changes.setByte(b, mask);
+            any |= mask;
+        }
+        if (N % 8 != 0) {
+            uint8_t mask = updateChunk(readings, fullBytes * 8, N % 8);
+            changes.setByte(fullBytes, mask);
+            any |= mask;
+        }
+        return any != 0;
+    }
+
+    /// Check whether the value of the given input changed during the last
+    /// update.
+    bool hasChanged(uint8_t index) const { return changes.get(index); }
+
+    /// Get the bit mask of inputs that changed during the last update. Bit
+    /// `i % 8` of byte `i / 8` corresponds to input `i`.
+    const BitArray<N> &getChanges() const { return changes; }
+
+    /// Get the filtered value of the given input (with the mapping function
+    /// applied), as a number of `Precision` bits wide.
+    /// @see    FilteredAnalog::getValue
+    AnalogType getValue(uint8_t index) const { return levels[index]; }
+
+    /// Get the filtered value of the given input as a floating point number
+    /// from 0.0 to 1.0.
+    float getFloatValue(uint8_t index) const {
+        return getValue(index) * (1.0f / (ldexpf(1.0f, Precision) - 1.0f));
+    }
+
+    /// Read the raw value of the given input without any filtering or mapping
+    /// applied, but with its bit depth increased by @c IncRes.
+    /// @see    FilteredAnalog::getRawValue
+    AnalogType getRawValue(uint8_t index) const {
+        return increaseBitDepth<ADC_BITS + IncRes, ADC_BITS, AnalogType>(
+            clamp(read(analogPins[index])));
+    }
+
+    /// Get the maximum value that can be returned from @ref getRawValue.
+    constexpr static AnalogType getMaxRawValue() {
+        return (1ul << (ADC_BITS + IncRes)) - 1ul;
+    }
+
+    /// Get the analog pin of the given input.
+    pin_t getPin(uint8_t index) const { return analogPins[index]; }
+
+    /// Get the number of inputs.
+    constexpr static uint8_t length() { return N; }
+
+  private:
+    using EMA_t = EMA<FilterShiftFactor, AnalogType, FilterType>;
+    constexpr static uint8_t HystBits = ADC_BITS + IncRes - Precision;
+    constexpr static AnalogType margin = (1ul << HystBits) - 1ul;
+    constexpr static AnalogType offset = (1ul << HystBits) >> 1;
+    constexpr static AnalogType max_in = static_cast<AnalogType>(-1);
+    constexpr static AnalogType max_out = max_in >> HystBits;
+
+    static analog_t read(pin_t pin) {
+        analog_t reading;
+        if (!AnalogScannerBase::getSnapshot(pin, reading))
+            reading = ExtIO::analogRead(pin);
+        return reading;
+    }
+
+    static AnalogType clamp(AnalogType value) {
+#ifdef ESP8266
+        if (value > 1023)
+            value = 1023;
+#endif
+        return value;
+    }
+
+    void resetChannel(uint8_t i, AnalogType widevalue) {
+        states[i] = EMA_t::zero + (FilterType(widevalue) << FilterShiftFactor) -
+                    widevalue;
+        levels[i] = widevalue >> HystBits;
+    }
+
+    /// Filter and apply hysteresis to at most 8 inputs, starting at @p start.
+    /// Returns a bit mask of the inputs that changed.
+    /// Equivalent to `EMA::filter` followed by `Hysteresis::update` for each
+    /// input, but without branches, so it can be vectorized.
+    uint8_t updateChunk(const analog_t *readings, uint8_t start,
+                        uint8_t count) {
+        AnalogType filtered[8];
+        for (uint8_t j = 0; j < count; ++j) {
+            uint8_t i = start + j;
+            AnalogType input =
+                increaseBitDepth<ADC_BITS + IncRes, ADC_BITS, AnalogType>(
+                    clamp(readings[i]));
+            FilterType state = states[i] + FilterType(input);
+            FilterType output = (state + EMA_t::half) >> FilterShiftFactor;
+            output -= EMA_t::zero >> FilterShiftFactor;
+            states[i] = state - output;
+            filtered[j] = AnalogType(output);
+        }
+        if (mapped)
+            for (uint8_t j = 0; j < count; ++j)
+                if (mapFns[start + j])
+                    filtered[j] = mapFns[start + j](filtered[j]);
+        uint8_t mask = 0;
+        for (uint8_t j = 0; j < count; ++j) {
+            uint8_t i = start + j;
+            AnalogType prev = levels[i];
+            AnalogType prevFull = (prev << HystBits) | offset;
+            AnalogType lower = prev > 0 ? AnalogType(prevFull - margin) : 0;
+            AnalogType upper =
+                prev < max_out ? AnalogType(prevFull + margin) : max_in;
+            bool changed = filtered[j] < lower || filtered[j] > upper;
+            levels[i] = changed ? AnalogType(filtered[j] >> HystBits) : prev;
+            mask |= uint8_t(changed) << j;
+        }
+        return mask;
+    }
+
+  private:
+    static_assert(
+        ADC_BITS + IncRes + FilterShiftFactor <= sizeof(FilterType) * CHAR_BIT,
+        "Error: FilterType is not wide enough to hold the maximum value");
+    static_assert(
+        ADC_BITS + IncRes <= sizeof(AnalogType) * CHAR_BIT,
+        "Error: AnalogType is not wide enough to hold the maximum value");
+    static_assert(
+        Precision <= ADC_BITS + IncRes,
+        "Error: Precision is larger than the increased ADC precision");
+    static_assert(EMA_t::supports_range(AnalogType(0), getMaxRawValue()),
+                  "Error: EMA filter type doesn't support full ADC range");
+    static_assert(std::is_unsigned<AnalogType>::value,
+                  "Error: only unsigned analog types are supported");
+
+    Array<pin_t, N> analogPins;
+    /// The states of the EMA filters.
+    FilterType states[N];
+    /// The output levels of the hysteresis, i.e. the filtered values.
+    AnalogType levels[N];
+    MappingFunction mapFns[N] = {};
+    /// Whether any of the inputs has a mapping function.
+    bool mapped = false;
+    BitArray<N> changes;
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
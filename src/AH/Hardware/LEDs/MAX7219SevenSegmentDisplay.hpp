@@ -44,6 +44,26 @@ static constexpr const uint8_t *NumericChars = &SevenSegmentCharacters[0x30];
 /**
  * @brief   A class for 8-digit 7-segment displays with a MAX7219 driver.
  * 
+ * By default, every digit that is written is sent to the display immediately.
+ * Displays that are redrawn often, e.g. a timecode display, should use a
+ * shadow framebuffer instead: the `display` functions then only update the
+ * framebuffer, and @ref update sends just the digits that changed.
+ * 
+ * ~~~cpp
+ * MAX7219SevenSegmentDisplay<> max7219 {SPI, SS, 2};
+ * MAX7219_FrameBuffer<2> framebuffer;
+ * 
+ * void setup() {
+ *     max7219.setFrameBuffer(&framebuffer);
+ *     max7219.begin();
+ * }
+ * 
+ * void loop() {
+ *     max7219.display(millis() / 10);
+ *     max7219.update();
+ * }
+ * ~~~
+ * 
  * @tparam  SPIDriver
  *          The SPI class to use. Usually, the default is fine.
  * 
@@ -69,11 +89,52 @@ class MAX7219SevenSegmentDisplay : public MAX7219_Base<SPIDriver> {
 
     /// Initialize.
     /// @see    @ref MAX7219_Base::begin
-    void begin() { MAX7219_Base<SPIDriver>::begin(); }
+    void begin() {
+        MAX7219_Base<SPIDriver>::begin();
+        // begin() cleared the display, so restore the framebuffer contents
+        if (framebuffer) {
+            framebuffer->markAllDirty();
+            update();
+        }
+    }
+
+    /**
+     * @brief   Use a shadow framebuffer, so the digits are only sent to the
+     *          display when @ref update is called, and only if they changed.
+     * 
+     * All digits in the framebuffer are marked dirty, so the next update
+     * sends the entire framebuffer.
+     * 
+     * @param   framebuffer
+     *          The framebuffer to use, or `nullptr` to send the digits
+     *          immediately again. Should have at least as many chips as the
+     *          chain.
+     */
+    void setFrameBuffer(MAX7219_FrameBufferBase *framebuffer) {
+        this->framebuffer = framebuffer;
+        if (framebuffer)
+            framebuffer->markAllDirty();
+    }
+    /// Get the shadow framebuffer, or `nullptr` if there is none.
+    MAX7219_FrameBufferBase *getFrameBuffer() { return framebuffer; }
+
+    /**
+     * @brief   Send the digits that changed in the framebuffer to the display.
+     *          Does nothing if there is no framebuffer.
+     * 
+     * @return  The number of digits (rows) that were sent.
+     * @see     MAX7219_Base::sendChanged
+     */
+    uint8_t update() {
+        return framebuffer ? this->sendChanged(*framebuffer) : 0;
+    }
 
     /**
      * @brief   Set the value of a single digit.
      * 
+     * If a framebuffer is used, only the framebuffer is updated, otherwise,
+     * the digit is sent to the display immediately.
+     * 
      * @param   digit
      *          The digit to set the value of. May be greater than 7 if more 
      *          than one chip are daisy-chained.  
@@ -83,7 +144,10 @@ class MAX7219SevenSegmentDisplay : public MAX7219_Base<SPIDriver> {
      *          The value/bit pattern to set the digit to.
      */
     void sendDigit(uint16_t digit, uint8_t value) {
-        this->sendRaw((digit % 8) + 1, value, digit / 8);
+        if (framebuffer)
+            framebuffer->set(digit / 8, digit % 8, value);
+        else
+            this->sendRaw((digit % 8) + 1, value, digit / 8);
     }
 
     /**
@@ -287,6 +351,9 @@ class MAX7219SevenSegmentDisplay : public MAX7219_Base<SPIDriver> {
         }
         return endDigit - startDigit;
     }
+
+  private:
+    MAX7219_FrameBufferBase *framebuffer = nullptr;
 };
 
 END_AH_NAMESPACE
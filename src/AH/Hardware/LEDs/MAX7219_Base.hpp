@@ -5,6 +5,7 @@
 #include <AH/Settings/Warnings.hpp>
 AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
+#include "MAX7219_FrameBuffer.hpp"
 #include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
 
 AH_DIAGNOSTIC_EXTERNAL_HEADER()
@@ -148,6 +149,54 @@ class MAX7219_Base {
             sendRowAll(row, values + row, 8);
     }
 
+    /**
+     * @brief   Send the digits that changed in the given shadow framebuffer,
+     *          and mark them as sent.
+     *
+     * Each digit (row) that changed in at least one chip is sent using a
+     * single transfer over the chain, where the chips whose digit didn't
+     * change receive a No-Op. Digits that didn't change in any chip are not
+     * sent at all. When only a few digits change, this is much less SPI
+     * traffic than @ref sendAll, which sends every row to every chip.
+     *
+     * @param   framebuffer
+     *          The values of all digits of all chips. Chips beyond the end
+     *          of the framebuffer receive No-Ops.
+     * @param   digits
+     *          Bitmap of the digits to consider, the other dirty digits are
+     *          left for a later update.
+     * @return  The number of digits (rows) that were sent.
+     */
+    uint8_t sendChanged(MAX7219_FrameBufferBase &framebuffer,
+                        uint8_t digits = 0xFF) {
+        uint8_t rows = 0;
+        for (uint8_t c = 0; c < chainlength; ++c)
+            rows |= framebuffer.getDirtyDigits(c);
+        rows &= digits;
+        uint8_t count = 0;
+        for (uint8_t digit = 0; rows != 0; ++digit, rows >>= 1) {
+            if ((rows & 1) == 0)
+                continue;
+            uint8_t mask = 1 << digit;
+            ExtIO::digitalWrite(loadPin, LOW);
+            spi.beginTransaction(settings);
+            for (uint8_t c = 0; c < chainlength; ++c) {
+                if (framebuffer.getDirtyDigits(c) & mask) {
+                    spi.transfer(digit + 1);
+                    spi.transfer(framebuffer.get(c, digit));
+                    framebuffer.clearDirtyDigits(c, mask);
+                } else {
+                    spi.transfer(0x00); // No-Op
+                    spi.transfer(0x00);
+                }
+            }
+            ExtIO::digitalWrite(loadPin, HIGH);
+            spi.endTransaction();
+            ++count;
+        }
+        return count;
+    }
+
     /**
      * @brief   Send the same raw opcode and value to all chips in the chain.
      * 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Settings/NamespaceSettings.hpp>
+#include <AH/STL/cstdint>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   Shadow copy of the digit registers of a chain of MAX7219 chips,
+ *          with a bitmap of the digits that changed since they were last
+ *          sent. See @ref MAX7219_FrameBuffer.
+ *
+ * The values are stored in the same layout as the array used by
+ * @ref MAX7219_Base::sendAll: the eight digits (rows) of chip 0, followed by
+ * the eight digits of chip 1, etc.
+ */
+class MAX7219_FrameBufferBase {
+  protected:
+    MAX7219_FrameBufferBase(uint8_t *values, uint8_t *dirty, uint8_t numChips)
+        : values(values), dirty(dirty), numChips(numChips) {}
+
+  public:
+    // The pointers refer to the storage of the derived class.
+    MAX7219_FrameBufferBase(const MAX7219_FrameBufferBase &) = delete;
+    MAX7219_FrameBufferBase &operator=(const MAX7219_FrameBufferBase &) = delete;
+
+    /// Get the number of chips in the buffer.
+    uint8_t getNumberOfChips() const { return numChips; }
+
+    /**
+     * @brief   Set the value of a digit, and mark it dirty if it changed.
+     *
+     * @param   chip
+     *          The chip the digit belongs to.
+     * @param   digit
+     *          The digit or row to set [0, 7].
+     * @param   value
+     *          The new value of the digit.
+     */
+    void set(uint8_t chip, uint8_t digit, uint8_t value) {
+        if (chip >= numChips)
+            return;
+        digit &= 0x7;
+        uint8_t &old = values[8 * chip + digit];
+        if (old == value)
+            return;
+        old = value;
+        dirty[chip] |= 1 << digit;
+    }
+
+    /// Get the value of a digit.
+    uint8_t get(uint8_t chip, uint8_t digit) const {
+        return chip < numChips ? values[8 * chip + (digit & 0x7)] : 0;
+    }
+
+    /// Get a bitmap of the digits of the given chip that changed since they
+    /// were last sent. Bit @f$ i @f$ corresponds to digit @f$ i @f$.
+    uint8_t getDirtyDigits(uint8_t chip) const {
+        return chip < numChips ? dirty[chip] : 0;
+    }
+    /// Mark the digits in the given bitmap as sent.
+    void clearDirtyDigits(uint8_t chip, uint8_t digits) {
+        if (chip < numChips)
+            dirty[chip] &= ~digits;
+    }
+    /// Mark all digits of all chips as changed, so they are all sent during
+    /// the next update, e.g. after the chips were reset.
+    void markAllDirty() {
+        for (uint8_t c = 0; c < numChips; ++c)
+            dirty[c] = 0xFF;
+    }
+    /// Check whether any digit changed since the last update.
+    bool isDirty() const {
+        for (uint8_t c = 0; c < numChips; ++c)
+            if (dirty[c])
+                return true;
+        return false;
+    }
+
+    /// Get the values of all digits, in the layout of
+    /// @ref MAX7219_Base::sendAll.
+    const uint8_t *getValues() const { return values; }
+
+  private:
+    uint8_t *values;
+    uint8_t *dirty;
+    uint8_t numChips;
+};
+
+/**
+ * @brief   Shadow framebuffer for a chain of MAX7219 chips, used to only send
+ *          the digits that changed.
+ *
+ * @see     MAX7219_Base::sendChanged
+ * @see     MAX7219SevenSegmentDisplay::setFrameBuffer
+ *
+ * @tparam  NumChips
+ *          The number of daisy-chained MAX7219 chips.
+ */
+template <uint8_t NumChips>
+class MAX7219_FrameBuffer : public MAX7219_FrameBufferBase {
+  public:
+    /// All digits are initially off and clean, which matches the state of
+    /// the chips after @ref MAX7219_Base::begin.
+    MAX7219_FrameBuffer()
+        : MAX7219_FrameBufferBase(values, dirty, NumChips) {}
+
+  private:
+    uint8_t values[8 * NumChips] = {};
+    uint8_t dirty[NumChips] = {};
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -10,6 +10,7 @@ AH_DIAGNOSTIC_EXTERNAL_HEADER()
 AH_DIAGNOSTIC_POP()
 
 #include <AH/Containers/Array.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
 #include <AH/STL/limits>
 #include <AH/STL/type_traits>
 
@@ -71,6 +72,36 @@ class RegisterEncoders {
     StateStorageType state = std::numeric_limits<RegisterType>::max();
     Array<EncoderPositionStorageType, NumEnc> positions {{}};
 
+    static_assert(2 * NumEnc <= std::numeric_limits<RegisterType>::digits,
+                  "RegisterType is too small for NumEnc encoders");
+
+    /// Mask with the bits of pin A of all encoders: 0b...010101.
+    constexpr static RegisterType encoderMask() {
+        return 2 * NumEnc >= std::numeric_limits<RegisterType>::digits
+                   ? RegisterType(RegisterType(~RegisterType(0)) / 3)
+                   : RegisterType(
+                         RegisterType(RegisterType(~RegisterType(0)) / 3) &
+                         ((RegisterType(1)
+                           << (2 * NumEnc %
+                               std::numeric_limits<RegisterType>::digits)) -
+                          1));
+    }
+
+    /// Type to pass to @ref countTrailingZeros, small types are promoted to
+    /// `unsigned int`.
+    using CTZType =
+        typename std::conditional<sizeof(RegisterType) <= sizeof(unsigned int),
+                                  unsigned int, RegisterType>::type;
+    static uint8_t countTrailingZeros(unsigned int x) {
+        return __builtin_ctz(x);
+    }
+    static uint8_t countTrailingZeros(unsigned long x) {
+        return __builtin_ctzl(x);
+    }
+    static uint8_t countTrailingZeros(unsigned long long x) {
+        return __builtin_ctzll(x);
+    }
+
   public:
     /// Reset the positions to zero and the state to 0xFF...FF.
     void reset() {
@@ -92,6 +123,9 @@ class RegisterEncoders {
      * 
      * Don't call this function both from the ISR and from your main program,
      * only call it from one of the two.
+     * 
+     * Uses @ref updateBitwise or @ref updateLUT, depending on the
+     * @ref REGISTER_ENCODERS_BITWISE_DECODE setting.
      *
      * @retval  true
      *          The new state is different from the old state, positions have
@@ -100,6 +134,16 @@ class RegisterEncoders {
      *          The new state is the same as the old state, nothing updated.
      */
     bool update(RegisterType newstate) {
+        return REGISTER_ENCODERS_BITWISE_DECODE ? updateBitwise(newstate)
+                                                : updateLUT(newstate);
+    }
+
+    /**
+     * @brief   Update the encoder positions based on the new state, by looking
+     *          up the delta of every encoder in a table.
+     * @copydetails update
+     */
+    bool updateLUT(RegisterType newstate) {
         RegisterType oldstate = state;
 
         // If the state didn't change, do nothing
@@ -129,6 +173,59 @@ class RegisterEncoders {
         return true;
     }
 
+    /**
+     * @brief   Update the encoder positions based on the new state, by
+     *          decoding all encoders at once using bitwise operations.
+     * 
+     * The deltas of all encoders are computed in parallel (two bits per
+     * encoder), and then only the encoders that actually moved are visited.
+     * This gives the same result as @ref updateLUT, but it is much faster
+     * when there are many encoders and only a few of them change at a time,
+     * which is usually the case.
+     * 
+     * @copydetails update
+     */
+    bool updateBitwise(RegisterType newstate) {
+        RegisterType oldstate = state;
+
+        // If the state didn't change, do nothing
+        if (newstate == oldstate)
+            return false;
+
+        // Save the new state
+        state = newstate;
+
+        // Pin A of each encoder is the low bit, pin B the high bit. Convert
+        // the Gray code BA to the binary position P = (B, A ^ B), with all
+        // bits aligned to the position of pin A.
+        const RegisterType mask = encoderMask();
+        RegisterType ao = oldstate & mask, bo = (oldstate >> 1) & mask;
+        RegisterType an = newstate & mask, bn = (newstate >> 1) & mask;
+        RegisterType lo_o = ao ^ bo, lo_n = an ^ bn;
+        // Subtract the positions (modulo 4): D = P_old - P_new
+        RegisterType d_lo = lo_o ^ lo_n;
+        RegisterType borrow = ~lo_o & lo_n;
+        RegisterType d_hi = (bo ^ bn ^ borrow) & mask;
+        // D = 1 → +1, D = 3 → -1, D = 2 → ±2 (a missed step, the sign
+        // depends on the old state, to match the lookup table).
+        RegisterType moved = d_lo | d_hi;
+        RegisterType two = d_hi & ~d_lo;
+        RegisterType neg = (d_lo & d_hi) | (two & lo_o);
+
+        // Visit only the encoders that moved
+        while (moved) {
+            uint8_t bit = countTrailingZeros(static_cast<CTZType>(moved));
+            RegisterType bitmask = RegisterType(1) << bit;
+            auto delta = static_cast<EncoderPositionType>((two & bitmask) ? 2 : 1);
+            if (neg & bitmask)
+                positions[bit / 2] -= delta;
+            else
+                positions[bit / 2] += delta;
+            moved &= moved - 1; // clear the lowest set bit
+        }
+        return true;
+    }
+
     /**
      * @brief   Read the position of the given encoder.
      * 
@@ -85,6 +85,21 @@ constexpr unsigned long QTOUCH_BUTTON_THRESHOLD = 500; // milliseconds
 /// Has no effect on AVR.
 constexpr unsigned long SELECT_LINE_DELAY = 10; // microseconds
 
+/// The maximum number of ExtendedIOElement%s in the index that maps ExtIO pin
+/// numbers to elements. Pins of elements that don't fit are still found, but
+/// using the slower linear search.
+constexpr uint8_t EXTIO_PIN_INDEX_SIZE = 32;
+
+/// The number of buckets of the ExtIO pin index, must be a power of two.
+/// The pin range of all elements is divided into this many buckets, so a
+/// lookup only has to check the few elements that overlap a single bucket.
+constexpr uint8_t EXTIO_PIN_INDEX_BUCKETS = 32;
+
+/// Decode all encoders of a @ref RegisterEncoders object at once using
+/// bitwise operations on the entire register, and only visit the encoders
+/// that moved. Set to `false` to use the lookup table for every encoder.
+constexpr bool REGISTER_ENCODERS_BITWISE_DECODE = true;
+
 /// The time in milliseconds before a press is registered as a long press.
 constexpr unsigned long LONG_PRESS_DELAY = 450; // milliseconds
 
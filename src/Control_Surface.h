@@ -36,6 +36,7 @@
 #include <MIDI_Outputs/CCQTouchButton.hpp>
 
 #include <MIDI_Outputs/CCPotentiometer.hpp>
+#include <MIDI_Outputs/CCPotentiometers.hpp>
 
 #include <MIDI_Outputs/NoteButton.hpp>
 #include <MIDI_Outputs/NoteButtonLatched.hpp>
@@ -128,11 +129,15 @@
 // ---------------------------- MIDI Interfaces ----------------------------- //
 #include <MIDI_Interfaces/DebugMIDI_Interface.hpp>
 #include <MIDI_Interfaces/SerialMIDI_Interface.hpp>
+#include <MIDI_Interfaces/RingBufferedSerialMIDI_Interface.hpp>
 #include <MIDI_Interfaces/USBMIDI_Interface.hpp>
 #ifdef ESP32
 #include <MIDI_Interfaces/BluetoothMIDI_Interface.hpp>
 #endif
 #include <MIDI_Interfaces/MIDI_Callbacks.hpp>
+#include <MIDI_Interfaces/BufferedMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/CoalescingMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/InstrumentedMIDI_Pipe.hpp>
 
 // ------------------------- Extended Input Output -------------------------- //
 #include <AH/Hardware/ExtendedInputOutput/AnalogMultiplex.hpp>
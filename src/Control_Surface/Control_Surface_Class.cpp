@@ -12,6 +12,7 @@
 
 BEGIN_CS_NAMESPACE
 
+using AH::AnalogScannerBase;
 using AH::ExtendedIOElement;
 
 Control_Surface_ &Control_Surface_::getInstance() {
@@ -39,7 +40,9 @@ void Control_Surface_::begin() {
     MIDIInputElementCP::beginAll();
     MIDIInputElementPB::beginAll();
     MIDIInputElementSysEx::beginAll();
+    Updatable<AnalogScannerBase>::beginAll();
     Updatable<>::beginAll();
+    Updatable<MIDIOutputStage>::beginAll();
     Updatable<Display>::beginAll();
     displayTimer.begin();
 }
@@ -64,9 +67,11 @@ void Control_Surface_::disconnectMIDI_Interfaces() {
 
 void Control_Surface_::loop() {
     ExtendedIOElement::updateAllBufferedInputs();
+    Updatable<AnalogScannerBase>::updateAll();
     Updatable<>::updateAll();
     updateMidiInput();
     updateInputs();
+    Updatable<MIDIOutputStage>::updateAll();
     if (displayTimer)
         updateDisplays();
     ExtendedIOElement::updateAllBufferedOutputs();
@@ -226,6 +231,17 @@ void Control_Surface_::updateInputs() {
     MIDIInputElementSysEx::updateAll();
 }
 
+void Control_Surface_::setMIDIInputDeliveryPolicy(
+    MIDIInputDeliveryPolicy policy) {
+    MIDIInputElementNote::setDeliveryPolicy(policy);
+    MIDIInputElementKP::setDeliveryPolicy(policy);
+    MIDIInputElementCC::setDeliveryPolicy(policy);
+    MIDIInputElementPC::setDeliveryPolicy(policy);
+    MIDIInputElementCP::setDeliveryPolicy(policy);
+    MIDIInputElementPB::setDeliveryPolicy(policy);
+    MIDIInputElementSysEx::setDeliveryPolicy(policy);
+}
+
 void Control_Surface_::beginDisplays() {
     auto &allElements = DisplayElement::getAll();
     auto it = allElements.begin();
@@ -264,15 +280,8 @@ void Control_Surface_::updateDisplays() {
         if (it == end || &it->getDisplay() != previousDisplay) {
             // If there was at least one element on the previous display that
             // has to be redrawn
-            if (dirty) {
-                // Clear the display
-                previousDisplay->clearAndDrawBackground();
-                // Update all elements on that display
-                for (auto drawIt = prevIt; drawIt != it; ++drawIt)
-                    drawIt->draw();
-                // Write the buffer to the display
-                previousDisplay->display();
-            }
+            if (dirty)
+                updateDisplay(*previousDisplay, prevIt, it);
             if (it == end)
                 break;
             prevIt = it;
@@ -282,6 +291,44 @@ void Control_Surface_::updateDisplays() {
     }
 }
 
+void Control_Surface_::updateDisplay(DisplayInterface &display,
+                                     DisplayElementIterator begin,
+                                     DisplayElementIterator end) {
+    // Find the region covered by the elements that changed
+    PixelRegion bounds = display.getBounds();
+    PixelRegion dirtyRegion = {0, 0, 0, 0};
+    if (!bounds.isEmpty())
+        for (auto it = begin; it != end; ++it)
+            if (it->getDirty())
+                dirtyRegion = dirtyRegion.merge(it->getBoundingBox());
+    dirtyRegion = dirtyRegion.intersection(bounds);
+
+    if (bounds.isEmpty() || dirtyRegion == bounds) {
+        // Clear the display
+        display.clearAndDrawBackground();
+        // Update all elements on that display
+        for (auto it = begin; it != end; ++it)
+            it->draw();
+        // Write the buffer to the display
+        display.display();
+        return;
+    }
+
+    // Only clear and redraw the dirty region
+    const PixelRegion &r = dirtyRegion;
+    if (!r.isEmpty()) {
+        display.clearRegion(r.x, r.y, r.w, r.h);
+        display.drawBackground();
+    }
+    // Redraw the elements that overlap with the region, and the dirty ones
+    // that are off-screen, so their dirty flags are cleared
+    for (auto it = begin; it != end; ++it)
+        if (it->getBoundingBox().intersects(r) || it->getDirty())
+            it->draw();
+    if (!r.isEmpty())
+        display.display(r.x, r.y, r.w, r.h);
+}
+
 #if CS_TRUE_CONTROL_SURFACE_INSTANCE || defined(DOXYGEN)
 Control_Surface_ &Control_Surface = Control_Surface_::getInstance();
 #endif
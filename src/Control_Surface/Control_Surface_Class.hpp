@@ -7,6 +7,7 @@
 #include <AH/Timing/MillisMicrosTimer.hpp>
 #include <Display/DisplayElement.hpp>
 #include <Display/DisplayInterface.hpp>
+#include <MIDI_Inputs/MIDIInputElement.hpp>
 #include <MIDI_Interfaces/MIDI_Interface.hpp>
 #include <Settings/SettingsWrapper.hpp>
 
@@ -67,8 +68,23 @@ class Control_Surface_ : public MIDI_Sender<Control_Surface_>,
     /// Initialize all displays that have at least one display element.
     void beginDisplays();
     /// Clear, draw and display all displays that contain display elements that
-    /// have changed.
+    /// have changed. For displays that support it, only the region covered by
+    /// the elements that changed is cleared, redrawn and written to the
+    /// display.
+    /// @see    DisplayInterface::getBounds
+    /// @see    DisplayElement::getBoundingBox
     void updateDisplays();
+    /// Select whether incoming MIDI messages update only the first matching
+    /// MIDIInputElement, or all matching elements, for all types of
+    /// MIDIInputElement%s.
+    /// @see    MIDIInputElement::setDeliveryPolicy
+    void setMIDIInputDeliveryPolicy(MIDIInputDeliveryPolicy policy);
+
+  private:
+    using DisplayElementIterator = DoublyLinkedList<DisplayElement>::iterator;
+    /// Redraw the given elements of a display, at least one of them is dirty.
+    void updateDisplay(DisplayInterface &display, DisplayElementIterator begin,
+                       DisplayElementIterator end);
 
   private:
     /// Low-level function for sending a MIDI channel voice message.
@@ -57,6 +57,8 @@ constexpr setting_t NO_SETTING =
 struct Potentiometer {};
 struct MotorFader {};
 struct Display {};
+/// Output stages that are flushed at the end of `Control_Surface.loop()`.
+struct MIDIOutputStage {};
 
 /// A simple struct representing a pixel with integer coordinates.
 struct PixelLocation {
@@ -64,4 +66,56 @@ struct PixelLocation {
     int16_t y;
 };
 
+/// A rectangular region of pixels, with its top left corner at (x, y).
+struct PixelRegion {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+
+    /// Check if the region doesn't contain any pixels.
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+
+    /// Check if the two regions have any pixels in common.
+    bool intersects(const PixelRegion &other) const {
+        return !isEmpty() && !other.isEmpty() && //
+               x < other.x + other.w && other.x < x + w &&
+               y < other.y + other.h && other.y < y + h;
+    }
+
+    /// Get the pixels that the two regions have in common.
+    PixelRegion intersection(const PixelRegion &other) const {
+        if (!intersects(other))
+            return {0, 0, 0, 0};
+        int x0 = x > other.x ? x : other.x;
+        int y0 = y > other.y ? y : other.y;
+        int x1 = x + w < other.x + other.w ? x + w : other.x + other.w;
+        int y1 = y + h < other.y + other.h ? y + h : other.y + other.h;
+        return {int16_t(x0), int16_t(y0), int16_t(x1 - x0), int16_t(y1 - y0)};
+    }
+
+    /// Get the smallest region that contains both regions.
+    PixelRegion merge(const PixelRegion &other) const {
+        if (other.isEmpty())
+            return *this;
+        if (isEmpty())
+            return other;
+        int x0 = x < other.x ? x : other.x;
+        int y0 = y < other.y ? y : other.y;
+        int x1 = x + w > other.x + other.w ? x + w : other.x + other.w;
+        int y1 = y + h > other.y + other.h ? y + h : other.y + other.h;
+        return {int16_t(x0), int16_t(y0), int16_t(x1 - x0), int16_t(y1 - y0)};
+    }
+
+    /// Check if all pixels of the other region are in this region.
+    bool contains(const PixelRegion &other) const {
+        return intersection(other) == other;
+    }
+
+    bool operator==(const PixelRegion &o) const {
+        return x == o.x && y == o.y && w == o.w && h == o.h;
+    }
+    bool operator!=(const PixelRegion &o) const { return !(*this == o); }
+};
+
 END_CS_NAMESPACE
@@ -2,6 +2,7 @@
 
 #include <Settings/NamespaceSettings.hpp>
 
+#include <AH/STL/cstddef>
 #include <AH/STL/type_traits>
 #include <AH/STL/utility>
 
@@ -28,4 +29,26 @@ template <class T>
 typename std::enable_if<!has_method_begin<T>::value>::type
 begin_if_possible(T &) {}
 
+template <class, class = void>
+struct has_method_read_packets : std::false_type {};
+
+/// Checks whether `T` has a method `read(T::MIDIUSBPacket_t *, size_t)`, i.e.
+/// whether the USB MIDI backend `T` can read multiple packets at once.
+template <class T>
+struct has_method_read_packets<
+    T, void_t<decltype(std::declval<T &>().read(
+           std::declval<typename T::MIDIUSBPacket_t *>(), size_t()))>>
+    : std::true_type {};
+
+template <class, class = void>
+struct has_method_write_packets : std::false_type {};
+
+/// Checks whether `T` has a method `write(const T::MIDIUSBPacket_t *, size_t)`,
+/// i.e. whether the USB MIDI backend `T` can write multiple packets at once.
+template <class T>
+struct has_method_write_packets<
+    T, void_t<decltype(std::declval<T &>().write(
+           std::declval<const typename T::MIDIUSBPacket_t *>(), size_t()))>>
+    : std::true_type {};
+
 END_CS_NAMESPACE
@@ -28,6 +28,10 @@ class BitmapDisplay : public DisplayElement {
 
     bool getDirty() const override { return value.getDirty(); }
 
+    PixelRegion getBoundingBox() const override {
+        return {x, y, int16_t(xbm.width), int16_t(xbm.height)};
+    }
+
   private:
     Value_t value;
     const XBitmap &xbm;
@@ -91,6 +91,21 @@ class DisplayElement : public DoublyLinkable<DisplayElement> {
     /// Check if this DisplayElement has to be re-drawn.
     virtual bool getDirty() const = 0;
 
+    /**
+     * @brief   Get the region of the display that this element draws to.
+     *
+     * It should contain all pixels that @ref draw could change. When some
+     * elements are dirty, only the union of their bounding boxes is cleared
+     * and written to the display, and only the elements that intersect it
+     * are redrawn.
+     *
+     * The default is the entire display, so every change of this element
+     * causes a full redraw.
+     */
+    virtual PixelRegion getBoundingBox() const {
+        return {-0x4000, -0x4000, 0x7FFF, 0x7FFF};
+    }
+
     /// Get a reference to the display that this element draws to.
     DisplayInterface &getDisplay() { return display; }
     /// Get a const reference to the display that this element draws to.
@@ -99,6 +114,31 @@ class DisplayElement : public DoublyLinkable<DisplayElement> {
     /// Get the list of all DisplayElement instances.
     static DoublyLinkedList<DisplayElement> &getAll() { return elements; }
 
+  protected:
+    /// Get the bounding box of @p length characters of text at the given
+    /// cursor position, using the default 6×8 pixel font of the Adafruit GFX
+    /// library, scaled by @p size. If the text doesn't fit on the display,
+    /// the GFX library wraps it to the next line, so the entire display is
+    /// returned instead.
+    PixelRegion getTextBoundingBox(int16_t x, int16_t y, uint8_t length,
+                                   uint8_t size) const {
+        int w = 6 * size * length;
+        PixelRegion bounds = display.getBounds();
+        if (!bounds.isEmpty() && x + w > bounds.x + bounds.w)
+            return DisplayElement::getBoundingBox();
+        return {x, y, int16_t(w), int16_t(8 * size)};
+    }
+
+    /// Get the number of characters needed to print the given number.
+    static uint8_t getTextLength(long number) {
+        uint8_t length = number < 0 ? 2 : 1;
+        while (number >= 10 || number <= -10) {
+            number /= 10;
+            ++length;
+        }
+        return length;
+    }
+
   protected:
     DisplayInterface &display;
 
@@ -30,6 +30,34 @@ class DisplayInterface : public Print {
     /// this function empty.
     virtual void display() = 0;
 
+    /// @name   Partial redraws
+    /// @{
+
+    /**
+     * @brief   Get the region covered by the display, i.e. (0, 0, width,
+     *          height).
+     *
+     * Partial redraws are only used for displays that return a non-empty
+     * region. By default, the region is empty, and the entire display is
+     * cleared and redrawn when one of its elements changes. Displays that
+     * support partial redraws should override this function, as well as
+     * @ref clearRegion and @ref display(int16_t, int16_t, int16_t, int16_t).
+     */
+    virtual PixelRegion getBounds() const { return {0, 0, 0, 0}; }
+    /// Clear the given region of the frame buffer. The default implementation
+    /// fills it with color 0.
+    virtual void clearRegion(int16_t x, int16_t y, int16_t w, int16_t h) {
+        fillRect(x, y, w, h, 0);
+    }
+    /// Write the given region of the frame buffer to the display. The default
+    /// implementation writes the entire frame buffer.
+    virtual void display(int16_t x, int16_t y, int16_t w, int16_t h) {
+        (void)x, (void)y, (void)w, (void)h;
+        display();
+    }
+
+    /// @}
+
     /// Paint a single pixel with the given color.
     virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
 
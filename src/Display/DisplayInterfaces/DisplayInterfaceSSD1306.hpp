@@ -1,10 +1,37 @@
 #pragma once
 
+#include <AH/Error/Error.hpp>
+#include <AH/STL/algorithm>
 #include <Adafruit_SSD1306.h>
 #include <Display/DisplayInterface.hpp>
 
 BEGIN_CS_NAMESPACE
 
+namespace detail {
+#if defined(SSD1306_BLACK)
+/// Access to the I²C interface of an Adafruit_SSD1306 object, which is
+/// protected in version 2 of the library.
+struct SSD1306Internals : Adafruit_SSD1306 {
+    static TwoWire *getWire(Adafruit_SSD1306 &d) {
+        return d.*(&SSD1306Internals::wire);
+    }
+    static uint8_t getI2CAddress(Adafruit_SSD1306 &d) {
+        return d.*(&SSD1306Internals::i2caddr);
+    }
+#if defined(ARDUINO) && ARDUINO >= 157
+    /// The I²C clock frequency to use for transfers to the display.
+    static uint32_t getWireClock(Adafruit_SSD1306 &d) {
+        return d.*(&SSD1306Internals::wireClk);
+    }
+    /// The I²C clock frequency to restore after a transfer.
+    static uint32_t getRestoreClock(Adafruit_SSD1306 &d) {
+        return d.*(&SSD1306Internals::restoreClk);
+    }
+#endif
+};
+#endif
+} // namespace detail
+
 /**
  * @brief   This class creates a mapping between the Adafruit_SSD1306 display 
  *          driver and the general display interface used by the Control Surface
@@ -24,6 +51,31 @@ class SSD1306_DisplayInterface : public DisplayInterface {
     /// this function empty.
     void display() override { disp.display(); }
 
+    /// Get the size of the display, to enable partial redraws.
+    PixelRegion getBounds() const override {
+        return {0, 0, disp.width(), disp.height()};
+    }
+    /// Clear the given region of the frame buffer.
+    void clearRegion(int16_t x, int16_t y, int16_t w, int16_t h) override {
+        disp.fillRect(x, y, w, h, 0);
+    }
+    /**
+     * @brief   Write the given region of the frame buffer to the display.
+     *
+     * The SSD1306 stores its pixels in pages of eight rows, so the region is
+     * extended to whole pages, and only the columns and pages of that window
+     * are sent. If the display is rotated, or if the window can't be sent
+     * separately (see @ref displayWindow), the entire frame buffer is sent.
+     */
+    void display(int16_t x, int16_t y, int16_t w, int16_t h) override {
+        PixelRegion r = PixelRegion{x, y, w, h}.intersection(getBounds());
+        if (r.isEmpty())
+            return;
+        if (disp.getRotation() != 0 ||
+            !displayWindow(r.y / 8, (r.y + r.h - 1) / 8, r.x, r.x + r.w - 1))
+            disp.display();
+    }
+
     /// Paint a single pixel with the given color.
     void drawPixel(int16_t x, int16_t y, uint16_t color) override {
         disp.drawPixel(x, y, color);
@@ -67,8 +119,278 @@ class SSD1306_DisplayInterface : public DisplayInterface {
         disp.drawXBitmap(x, y, bitmap, w, h, color);
     }
 
+  protected:
+    /**
+     * @brief   Send the given pages and columns of the frame buffer to the
+     *          display.
+     *
+     * The pages and columns are those of the display itself, they don't
+     * depend on the rotation.
+     *
+     * The default implementation supports I²C displays with version 2.2 or
+     * later of the Adafruit_SSD1306 library. Override it to support other
+     * configurations.
+     *
+     * @return  False if the window could not be sent, in which case the
+     *          entire frame buffer is sent instead.
+     */
+    virtual bool displayWindow(uint8_t firstPage, uint8_t lastPage,
+                               uint8_t firstColumn, uint8_t lastColumn) {
+#if defined(SSD1306_BLACK)
+        using detail::SSD1306Internals;
+        TwoWire *wire = SSD1306Internals::getWire(disp);
+        if (wire == nullptr)
+            return false;
+        uint8_t address = SSD1306Internals::getI2CAddress(disp);
+        uint8_t columns = getColumns();
+        disp.ssd1306_command(SSD1306_PAGEADDR);
+        disp.ssd1306_command(firstPage);
+        disp.ssd1306_command(lastPage);
+        disp.ssd1306_command(SSD1306_COLUMNADDR);
+        disp.ssd1306_command(firstColumn);
+        disp.ssd1306_command(lastColumn);
+        const uint8_t *buffer = disp.getBuffer();
+#if defined(ARDUINO) && ARDUINO >= 157
+        // Like the library itself, use a faster clock for the transfer
+        wire->setClock(SSD1306Internals::getWireClock(disp));
+#endif
+        // Send the data in chunks that fit in the I²C buffer (32 bytes on
+        // AVR), each one starting with the data control byte
+        constexpr uint8_t maxChunk = 32;
+        uint8_t count = maxChunk;
+        for (uint8_t page = firstPage; page <= lastPage; ++page) {
+            const uint8_t *row = buffer + page * columns;
+            for (uint8_t col = firstColumn; col <= lastColumn; ++col) {
+                if (count == maxChunk) {
+                    if (col != firstColumn || page != firstPage)
+                        wire->endTransmission();
+                    wire->beginTransmission(address);
+                    wire->write(uint8_t(0x40));
+                    count = 1;
+                }
+                wire->write(row[col]);
+                ++count;
+            }
+        }
+        wire->endTransmission();
+#if defined(ARDUINO) && ARDUINO >= 157
+        wire->setClock(SSD1306Internals::getRestoreClock(disp));
+#endif
+        return true;
+#else
+        (void)firstPage, (void)lastPage, (void)firstColumn, (void)lastColumn;
+        return false;
+#endif
+    }
+
+    /// Get the number of columns of the frame buffer, i.e. the width of the
+    /// display without rotation.
+    uint8_t getColumns() const {
+        return disp.getRotation() & 1 ? disp.height() : disp.width();
+    }
+    /// Get the number of pages (rows of 8 pixels) of the frame buffer.
+    uint8_t getPages() const {
+        int16_t height = disp.getRotation() & 1 ? disp.width() : disp.height();
+        return (height + 7) / 8;
+    }
+
   protected:
     Adafruit_SSD1306 &disp;
 };
 
+/**
+ * @brief   An SSD1306 display interface that only sends the parts of the
+ *          frame buffer that changed since the previous frame.
+ *
+ * A copy of the last frame that was sent to the display is kept in RAM. When
+ * the frame buffer is written to the display, it is compared to this copy, and
+ * only the changed columns of each page are sent, as windows (see
+ * @ref displayWindow). Nearby changes, in the same page or in adjacent pages,
+ * are combined into a single window if sending the unchanged bytes in between
+ * is cheaper than setting up a new window.
+ *
+ * When only small parts of the display change, e.g. VU meters or the time
+ * display, this reduces the time spent on the bus considerably, which matters
+ * when multiple displays share a single I²C bus.
+ *
+ * The first frame, and the first frame after @ref invalidate, are sent in
+ * full. If the windows can't be sent separately (e.g. for SPI displays), the
+ * entire frame buffer is sent, but only if something changed.
+ *
+ * @note    The copy of the frame buffer uses another `Width * Height / 8`
+ *          bytes of RAM, even if the frame buffer itself is shared between
+ *          multiple displays.
+ *
+ * @tparam  Width
+ *          The maximum width of the display in pixels, without rotation.
+ * @tparam  Height
+ *          The maximum height of the display in pixels, without rotation.
+ *
+ * The actual size is taken from the display, so a 128×32 display can use the
+ * default template arguments, at the cost of 512 bytes of unused RAM. A
+ * display that is larger than the template arguments raises an error, and
+ * always receives the entire frame buffer.
+ */
+template <uint8_t Width = 128, uint8_t Height = 64>
+class SSD1306_DiffDisplayInterface : public SSD1306_DisplayInterface {
+  protected:
+    SSD1306_DiffDisplayInterface(Adafruit_SSD1306 &display)
+        : SSD1306_DisplayInterface(display) {}
+
+  public:
+    /// Send the parts of the frame buffer that changed since the previous
+    /// frame.
+    void display() override { flush(0, getPages() - 1, 0, getColumns() - 1); }
+    /// Send the parts of the given region of the frame buffer that changed
+    /// since the previous frame.
+    void display(int16_t x, int16_t y, int16_t w, int16_t h) override {
+        PixelRegion r = PixelRegion{x, y, w, h}.intersection(getBounds());
+        if (r.isEmpty())
+            return;
+        if (disp.getRotation() != 0)
+            display();
+        else
+            flush(r.y / 8, (r.y + r.h - 1) / 8, r.x, r.x + r.w - 1);
+    }
+
+    /// Forget what's on the display, so the next frame is sent in full. Use
+    /// this when the display was reset, or when other code wrote to it.
+    void invalidate() { valid = false; }
+
+    /// @name   Statistics
+    /// @{
+
+    /// Get the number of bytes (commands and pixel data) that were sent for
+    /// the last frame.
+    uint16_t getBytesSent() const { return bytesSent; }
+    /// Get the total number of bytes that were sent since the counters were
+    /// reset.
+    uint32_t getTotalBytesSent() const { return totalBytesSent; }
+    /// Get the number of frames since the counters were reset, including the
+    /// frames where nothing changed.
+    uint32_t getFrameCount() const { return frames; }
+    /// Reset the total number of bytes and the number of frames.
+    void resetCounters() { totalBytesSent = 0, frames = 0; }
+
+    /// @}
+
+    /// The number of command bytes needed to select a window.
+    constexpr static uint8_t WindowOverhead = 6;
+
+  private:
+    constexpr static uint8_t Pages = (Height + 7) / 8;
+    static_assert(Width <= 128, "Error: the SSD1306 has at most 128 columns");
+
+    struct Window {
+        uint8_t firstPage, lastPage, firstColumn, lastColumn;
+        uint16_t size() const {
+            return (lastPage - firstPage + 1) * (lastColumn - firstColumn + 1);
+        }
+    };
+
+    void flush(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn,
+               uint8_t lastColumn) {
+        bytesSent = 0;
+        ++frames;
+        const uint8_t *buffer = disp.getBuffer();
+        if (buffer == nullptr)
+            return;
+        uint8_t columns = getColumns();
+        if (columns > Width || getPages() > Pages) {
+            disp.display();
+            ERROR(F("Display is larger than SSD1306_DiffDisplayInterface"),
+                  0x1306);
+            return;
+        }
+        if (!valid) {
+            sendAll();
+            return;
+        }
+        Window pending {0, 0, 0, 0};
+        bool havePending = false;
+        for (uint8_t page = firstPage; page <= lastPage; ++page) {
+            const uint8_t *row = buffer + page * columns;
+            const uint8_t *old = shadow + page * columns;
+            uint8_t col = firstColumn;
+            while (true) {
+                // Find the next run of changed columns
+                while (col <= lastColumn && row[col] == old[col])
+                    ++col;
+                if (col > lastColumn)
+                    break;
+                Window run {page, page, col, col};
+                while (col <= lastColumn && row[col] != old[col])
+                    ++col;
+                run.lastColumn = col - 1;
+                if (!havePending) {
+                    pending = run;
+                    havePending = true;
+                    continue;
+                }
+                // Combine it with the pending window if that's cheaper
+                Window merged {
+                    pending.firstPage,
+                    page,
+                    std::min(pending.firstColumn, run.firstColumn),
+                    std::max(pending.lastColumn, run.lastColumn),
+                };
+                if (page <= pending.lastPage + 1 &&
+                    merged.size() <=
+                        pending.size() + WindowOverhead + run.size()) {
+                    pending = merged;
+                } else {
+                    if (!send(pending))
+                        return;
+                    pending = run;
+                }
+            }
+        }
+        if (havePending)
+            send(pending);
+    }
+
+    /// Send the given window, and update the copy of the frame buffer.
+    /// If the window can't be sent, the entire frame buffer is sent.
+    bool send(Window w) {
+        if (!displayWindow(w.firstPage, w.lastPage, w.firstColumn,
+                           w.lastColumn)) {
+            sendAll();
+            return false;
+        }
+        const uint8_t *buffer = disp.getBuffer();
+        for (uint8_t page = w.firstPage; page <= w.lastPage; ++page) {
+            uint16_t offset = page * getColumns();
+            std::copy(buffer + offset + w.firstColumn,
+                      buffer + offset + w.lastColumn + 1,
+                      shadow + offset + w.firstColumn);
+        }
+        count(WindowOverhead + w.size());
+        return true;
+    }
+
+    /// Send the entire frame buffer, and update the copy of it.
+    void sendAll() {
+        disp.display();
+        const uint8_t *buffer = disp.getBuffer();
+        uint16_t size = getColumns() * getPages();
+        std::copy(buffer, buffer + size, shadow);
+        valid = true;
+        count(WindowOverhead + size);
+    }
+
+    void count(uint16_t bytes) {
+        bytesSent += bytes;
+        totalBytesSent += bytes;
+    }
+
+  private:
+    /// The pixels that are currently on the display.
+    uint8_t shadow[Width * Pages];
+    /// Whether @ref shadow contains what's on the display.
+    bool valid = false;
+    uint16_t bytesSent = 0;
+    uint32_t totalBytesSent = 0;
+    uint32_t frames = 0;
+};
+
 END_CS_NAMESPACE
\ No newline at end of file
@@ -143,6 +143,11 @@ class LCDDisplay : public DisplayElement {
 
     bool getDirty() const override { return lcd.getDirty(); }
 
+    /// Six characters of text.
+    PixelRegion getBoundingBox() const override {
+        return getTextBoundingBox(x, y, 6, size);
+    }
+
     /**
      * @brief   Check if the display contains a message for each track 
      *          separately.
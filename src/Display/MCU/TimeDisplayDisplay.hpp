@@ -34,6 +34,11 @@ class TimeDisplayDisplay : public DisplayElement {
 
     bool getDirty() const override { return timedisplay.getDirty(); }
 
+    /// "BBBBB bb fff": twelve characters of text.
+    PixelRegion getBoundingBox() const override {
+        return getTextBoundingBox(x, y, 12, size);
+    }
+
     int16_t getX() const { return x; }
     int16_t getY() const { return y; }
     uint8_t getSize() const { return size; }
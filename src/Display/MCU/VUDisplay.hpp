@@ -36,6 +36,15 @@ class VUDisplay : public DisplayElement {
         return vu.getDirty() || shouldStartDecaying() || shouldUpdateDecay();
     }
 
+    PixelRegion getBoundingBox() const override {
+        // From the top of the peak line at its maximum to the bottom of the
+        // first block
+        int16_t top = y + blockheight - spacing -
+                      int16_t(vu.getMax()) * (blockheight + spacing);
+        int16_t bottom = y + blockheight;
+        return {x, top, int16_t(width), int16_t(bottom - top)};
+    }
+
   protected:
     virtual void drawPeak(uint8_t peak) {
         display.drawFastHLine(x,                                //
@@ -132,6 +141,12 @@ class AnalogVUDisplay : public DisplayElement {
 
     bool getDirty() const override { return vu.getDirty(); }
 
+    PixelRegion getBoundingBox() const override {
+        int16_t r = ceil(sqrt(float(r_sq)));
+        return {int16_t(x - r), int16_t(y - r), int16_t(2 * r + 1),
+                int16_t(2 * r + 1)};
+    }
+
   private:
     VU_t &vu;
 
@@ -16,6 +16,12 @@ class SelectorDisplay : public DisplayElement {
                     uint8_t size, uint16_t color)
         : DisplayElement(display), selector(selector), offset(offset),
           multiplier(multiplier), x(loc.x), y(loc.y), size(size), color(color) {
+        // The printed number is linear in the selection, so the longest one
+        // is printed for the first or the last possible selection.
+        uint8_t first = getTextLength(offset);
+        long max = long(NO_SETTING - 1) * multiplier + offset;
+        uint8_t last = getTextLength(max);
+        length = first > last ? first : last;
     }
     void draw() override {
         display.setTextColor(color);
@@ -28,11 +34,16 @@ class SelectorDisplay : public DisplayElement {
 
     bool getDirty() const override { return previous != selector.get(); }
 
+    /// Room for the longest number that can be printed.
+    PixelRegion getBoundingBox() const override {
+        return getTextBoundingBox(x, y, length, size);
+    }
+
   private:
     SelectorBase &selector;
     setting_t previous = NO_SETTING;
     int16_t offset, multiplier, x, y;
-    uint8_t size;
+    uint8_t size, length;
     uint16_t color;
 };
 
@@ -44,7 +55,11 @@ class BankDisplay : public DisplayElement {
     BankDisplay(DisplayInterface &display, OutputBank &bank, int16_t offset,
                 PixelLocation loc, uint8_t size, uint16_t color)
         : DisplayElement(display), bank(bank), offset(offset), x(loc.x),
-          y(loc.y), size(size), color(color) {}
+          y(loc.y), size(size), color(color) {
+        uint8_t first = getTextLength(offset);
+        uint8_t last = getTextLength(long(0xFF) + offset);
+        length = first > last ? first : last;
+    }
 
     void draw() override {
         display.setTextColor(color);
@@ -57,11 +72,16 @@ class BankDisplay : public DisplayElement {
 
     bool getDirty() const override { return previous != bank.getOffset(); }
 
+    /// Room for the longest number that can be printed.
+    PixelRegion getBoundingBox() const override {
+        return getTextBoundingBox(x, y, length, size);
+    }
+
   private:
     OutputBank &bank;
     uint8_t previous = 0xFF;
     int16_t offset, x, y;
-    uint8_t size;
+    uint8_t size, length;
     uint16_t color;
 };
 
@@ -226,6 +226,60 @@ uint8_t getRangeIndex(MIDIAddress tgt, MIDIAddress base,
                : tgt.getAddress() - base.getAddress();
 }
 
+/**
+ * @brief   Add all addresses that could be matched by
+ *          @ref matchBankableInRange to the given MIDI input element index.
+ * 
+ * @param   index
+ *          The index to add the addresses to, see 
+ *          @ref MIDIInputElementIndex::Registrar.
+ * @param   base
+ *          The base address (the address of bank setting 0).
+ * @param   config
+ *          The bank configuration.
+ * @param   length
+ *          The length of the range.
+ * @return  False if the index is full, true otherwise.
+ */
+template <uint8_t BankSize, class Index>
+bool addBankableToIndex(Index &index, MIDIAddress base,
+                        BaseBankConfig<BankSize> config, uint8_t length = 1) {
+    if (!base.isValid())
+        return true;
+    const int N = BankSize;
+    const int B = config.bank.getTracksPerBank();
+    const int F = config.bank.getSelectionOffset();
+    int address = base.getAddress();
+    int channel = base.getRawChannel();
+    int cable = base.getRawCableNumber();
+    // The value that changes with the bank setting, and its maximum
+    int *banked;
+    int max;
+    switch (config.type) {
+        case BankType::CHANGE_ADDRESS: banked = &address, max = 0x7F; break;
+        case BankType::CHANGE_CHANNEL: banked = &channel, max = 0x0F; break;
+        case BankType::CHANGE_CABLENB: banked = &cable, max = 0x0F; break;
+        default: return false; // LCOV_EXCL_LINE
+    }
+    const int first = *banked + F * B;
+    for (int bank = 0; bank < N; ++bank) {
+        // For CHANGE_ADDRESS, the range is part of the banked value, for the
+        // other types, only the address is a range
+        const int rangeLen = config.type == BankType::CHANGE_ADDRESS ? length : 1;
+        for (int i = 0; i < rangeLen; ++i) {
+            *banked = first + bank * B + i;
+            if (*banked < 0 || *banked > max)
+                continue;
+            const int addressRange =
+                config.type == BankType::CHANGE_ADDRESS ? 1 : length;
+            for (int j = 0; j < addressRange && address + j <= 0x7F; ++j)
+                if (!index.add(address + j, channel, cable))
+                    return false;
+        }
+    }
+    return true;
+}
+
 } // namespace BankableMIDIMatcherHelpers
 
 END_CS_NAMESPACE
\ No newline at end of file
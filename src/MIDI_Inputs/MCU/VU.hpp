@@ -123,6 +123,13 @@ struct VUMatcher {
         return {true, data};
     }
 
+    /// Add the channel and cable to the given MIDI input element index (the
+    /// track number is not part of the key for Channel Pressure messages).
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return index.add(address);
+    }
+
     MIDIAddress address; ///< MIDI address to compare incoming messages with.
 };
 
@@ -165,6 +172,13 @@ struct BankableVUMatcher {
     /// @see    @ref Bank<N>::getSelection()
     setting_t getSelection() const { return getBank().getSelection(); }
 
+    /// Add the addresses of all banks to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return BankableMIDIMatcherHelpers::addBankableToIndex(index, address,
+                                                              config);
+    }
+
     BaseBankConfig<BankSize> config; ///< Bank configuration.
     MIDIAddress address; ///< MIDI address to compare incoming messages with.
 };
@@ -4,6 +4,7 @@
 #include <MIDI_Parsers/MIDI_MessageTypes.hpp>
 
 #include <Banks/Bank.hpp> // Bank<N>, BankSettingChangeCallback
+#include <MIDI_Inputs/MIDIInputElementIndex.hpp>
 
 #include <AH/Containers/Updatable.hpp>
 #include <AH/STL/type_traits>
@@ -12,23 +13,51 @@ BEGIN_CS_NAMESPACE
 
 // -------------------------------------------------------------------------- //
 
+/// Determines which MIDI input elements are updated when multiple elements
+/// listen to the address of an incoming message.
+enum class MIDIInputDeliveryPolicy : uint8_t {
+    /// Only update the first element that matches the message.
+    FIRST_MATCH,
+    /// Update all elements that match the message.
+    /// @note   Only efficient if @ref MIDI_INPUT_ELEMENT_INDEX is enabled:
+    ///         then only the elements that registered the address of the
+    ///         message are checked. Without the index, every element is
+    ///         checked for every message, because the search can't stop at
+    ///         the first match.
+    ALL_MATCHES,
+};
+
 /**
  * @brief   A class for objects that listen for incoming MIDI events.
  * 
  * They can either update some kind of display, or they can just save the state.
+ * 
+ * If @ref MIDI_INPUT_ELEMENT_INDEX is enabled, incoming channel messages are
+ * only passed to the elements that registered the address of the message in
+ * the @ref MIDIInputElementIndex. Elements that can't be indexed are still
+ * checked one by one, after the indexed elements.
+ * 
+ * By default, a message is only passed to the first element that matches it,
+ * use @ref setDeliveryPolicy to update all matching elements instead.
  */
 template <MIDIMessageType Type>
 class MIDIInputElement : public AH::UpdatableCRTP<MIDIInputElement<Type>> {
   protected:
-    MIDIInputElement() = default;
+    MIDIInputElement() { invalidateIndex(); }
+    MIDIInputElement(const MIDIInputElement &other)
+        : AH::UpdatableCRTP<MIDIInputElement>(other) {
+        invalidateIndex();
+    }
+    MIDIInputElement &operator=(const MIDIInputElement &) = default;
 
   public:
-    virtual ~MIDIInputElement() = default;
+    virtual ~MIDIInputElement() { invalidateIndex(); }
 
   public:
     using MessageType =
         typename std::conditional<Type == MIDIMessageType::SYSEX_START,
                                   SysExMessage, ChannelMessage>::type;
+    using Index = MIDIInputElementIndex<Type>;
 
     /// Initialize the input element.
     virtual void begin() {} // LCOV_EXCL_LINE
@@ -42,15 +71,34 @@ class MIDIInputElement : public AH::UpdatableCRTP<MIDIInputElement<Type>> {
     /// Receive a new MIDI message and update the internal state.
     virtual bool updateWith(MessageType midimsg) = 0;
 
-    /// Update all
+    /// Add all addresses this element listens to to the given index.
+    /// @return False if this element can't be indexed, in which case it will
+    ///         be checked for each incoming message.
+    virtual bool addToIndex(typename Index::Registrar &) { return false; }
+
+    /// Select whether incoming messages are passed to the first matching
+    /// element only, or to all matching elements.
+    /// @note   @ref MIDIInputDeliveryPolicy::ALL_MATCHES requires
+    ///         @ref MIDI_INPUT_ELEMENT_INDEX to avoid checking all elements
+    ///         for each message.
+    static void setDeliveryPolicy(MIDIInputDeliveryPolicy policy) {
+        deliveryPolicy = policy;
+    }
+    /// Get the current delivery policy.
+    /// @see    setDeliveryPolicy
+    static MIDIInputDeliveryPolicy getDeliveryPolicy() {
+        return deliveryPolicy;
+    }
+
+    /// Update the element(s) that match the given message, depending on the
+    /// delivery policy.
+    /// @return True if at least one element matched the message.
     static bool updateAllWith(MessageType midimsg) {
-        for (auto &el : MIDIInputElement::updatables) {
-            if (el.updateWith(midimsg)) {
-                el.moveDown();
-                return true;
-            }
-        }
-        return false;
+#if MIDI_INPUT_ELEMENT_INDEX
+        return updateIndexedWith(midimsg);
+#else
+        return updateLinearWith(midimsg);
+#endif
     }
 
     /// Update all
@@ -67,8 +115,147 @@ class MIDIInputElement : public AH::UpdatableCRTP<MIDIInputElement<Type>> {
     static void resetAll() {
         MIDIInputElement::applyToAll(&MIDIInputElement::reset);
     }
+
+    /// @name Enabling and disabling updatables
+    /// @{
+
+    /// @copydoc AH::UpdatableCRTP::enable()
+    void enable() {
+        AH::UpdatableCRTP<MIDIInputElement>::enable();
+        invalidateIndex();
+    }
+    /// @copydoc AH::UpdatableCRTP::disable()
+    void disable() {
+        AH::UpdatableCRTP<MIDIInputElement>::disable();
+        invalidateIndex();
+    }
+
+    /// @copydoc enable()
+    static void enable(MIDIInputElement *element) { element->enable(); }
+    /// @copydoc enable()
+    static void enable(MIDIInputElement &element) { element.enable(); }
+    /// @copydoc enable()
+    template <class U, size_t N>
+    static void enable(U (&array)[N]) {
+        for (U &el : array)
+            enable(el);
+    }
+
+    /// @copydoc disable()
+    static void disable(MIDIInputElement *element) { element->disable(); }
+    /// @copydoc disable()
+    static void disable(MIDIInputElement &element) { element.disable(); }
+    /// @copydoc disable()
+    template <class U, size_t N>
+    static void disable(U (&array)[N]) {
+        for (U &el : array)
+            disable(el);
+    }
+
+    /// @}
+
+    /// Rebuild the index of all enabled elements. This is done automatically
+    /// when the first message arrives after the list of elements has changed.
+    static void rebuildIndex() {
+#if MIDI_INPUT_ELEMENT_INDEX
+        Index::clear();
+        unindexedCount = 0;
+        // Nodes are inserted at the front of their bucket, so iterate in
+        // reverse to preserve the order of the list of elements.
+        auto &els = MIDIInputElement::updatables;
+        for (auto it = els.rbegin(); it != els.rend(); ++it) {
+            uint16_t previousSize = Index::getSize();
+            typename Index::Registrar registrar = &*it;
+            it->indexed = it->addToIndex(registrar);
+            if (!it->indexed) {
+                Index::truncate(previousSize);
+                ++unindexedCount;
+            }
+        }
+        indexValid = true;
+#endif
+    }
+
+  private:
+    /// Check the elements one by one until one of them matches the message,
+    /// or check all of them if the delivery policy is
+    /// @ref MIDIInputDeliveryPolicy::ALL_MATCHES.
+    static bool updateLinearWith(MessageType midimsg) {
+        bool all = deliveryPolicy == MIDIInputDeliveryPolicy::ALL_MATCHES;
+        bool matched = false;
+        for (auto &el : MIDIInputElement::updatables) {
+#if MIDI_INPUT_ELEMENT_INDEX
+            if (el.indexed)
+                continue;
+#endif
+            if (el.updateWith(midimsg)) {
+                if (!all) {
+                    el.moveDown();
+                    return true;
+                }
+                matched = true;
+            }
+        }
+        return matched;
+    }
+
+#if MIDI_INPUT_ELEMENT_INDEX
+    /// Look up the elements with the address of the message in the index,
+    /// fall back to checking the elements that couldn't be indexed.
+    static bool updateIndexedWith(ChannelMessage midimsg) {
+        if (!indexValid)
+            rebuildIndex();
+        bool all = deliveryPolicy == MIDIInputDeliveryPolicy::ALL_MATCHES;
+        bool matched = false;
+        // The bucket is the list of all elements that listen to this key (and
+        // some that listen to other keys with the same hash)
+        uint16_t key = Index::getKey(midimsg);
+        for (auto node = Index::getBucket(key); node; node = node->next) {
+            if (node->key == key && node->element->updateWith(midimsg)) {
+                if (!all)
+                    return true;
+                matched = true;
+            }
+        }
+        if (unindexedCount > 0)
+            matched |= updateLinearWith(midimsg);
+        return matched;
+    }
+    /// System Exclusive messages have no address, they are not indexed.
+    static bool updateIndexedWith(SysExMessage midimsg) {
+        return updateLinearWith(midimsg);
+    }
+#endif
+
+    static void invalidateIndex() {
+#if MIDI_INPUT_ELEMENT_INDEX
+        indexValid = false;
+#endif
+    }
+
+    static MIDIInputDeliveryPolicy deliveryPolicy;
+
+#if MIDI_INPUT_ELEMENT_INDEX
+    /// Whether this element was added to the index.
+    bool indexed = false;
+    /// Whether the index is up to date with the list of elements.
+    static bool indexValid;
+    /// Number of enabled elements that are not in the index.
+    static uint16_t unindexedCount;
+#endif
 };
 
+template <MIDIMessageType Type>
+MIDIInputDeliveryPolicy MIDIInputElement<Type>::deliveryPolicy =
+    MIDIInputDeliveryPolicy::FIRST_MATCH;
+
+#if MIDI_INPUT_ELEMENT_INDEX
+template <MIDIMessageType Type>
+bool MIDIInputElement<Type>::indexValid = false;
+template <MIDIMessageType Type>
+uint16_t MIDIInputElement<Type>::unindexedCount = 0;
+#endif
+
 // -------------------------------------------------------------------------- //
 
 /// The @ref MIDIInputElement base class is very general: you give it a MIDI
@@ -101,6 +288,11 @@ class MatchingMIDIInputElement : public MIDIInputElement<Type> {
 
     virtual void handleUpdate(typename Matcher::Result match) = 0;
 
+    bool addToIndex(typename MIDIInputElement<Type>::Index::Registrar
+                        &registrar) override {
+        return MIDIInputElement<Type>::Index::addMatcher(matcher, registrar);
+    }
+
   protected:
     Matcher matcher;
 };
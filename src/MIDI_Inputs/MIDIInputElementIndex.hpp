@@ -0,0 +1,178 @@
+#pragma once
+
+#include <Def/MIDIAddress.hpp>
+#include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+#include <Settings/SettingsWrapper.hpp>
+
+BEGIN_CS_NAMESPACE
+
+template <MIDIMessageType Type>
+class MIDIInputElement;
+
+/**
+ * @brief   Hash table that maps MIDI addresses to the MIDI input elements that
+ *          listen to them, so incoming channel messages can be dispatched
+ *          without asking every single element whether it's interested.
+ *
+ * The keys consist of the MIDI USB cable number, the MIDI channel and, for
+ * Note, Key Pressure and Control Change messages, the first data byte.
+ * The matchers (see @ref MIDIInputMatchers) add all addresses they could
+ * possibly match using the @ref Registrar class. The index is only used to
+ * select the candidates, the elements still check the address of the message
+ * using their matcher, so a matcher may register more addresses than it
+ * actually matches, but never fewer.
+ *
+ * All memory is allocated statically, see @ref MIDI_INPUT_INDEX_SIZE and
+ * @ref MIDI_INPUT_INDEX_BUCKETS. The index is rebuilt from the list of enabled
+ * elements whenever an element is created, destroyed, enabled or disabled.
+ *
+ * @tparam  Type
+ *          The type of MIDI input element.
+ */
+template <MIDIMessageType Type>
+class MIDIInputElementIndex {
+    static_assert((MIDI_INPUT_INDEX_BUCKETS & (MIDI_INPUT_INDEX_BUCKETS - 1)) ==
+                      0,
+                  "MIDI_INPUT_INDEX_BUCKETS must be a power of two");
+
+  public:
+    using Element = MIDIInputElement<Type>;
+
+    /// A single entry of the index, linking a key to an element.
+    struct Node {
+        Node *next;
+        Element *element;
+        uint16_t key;
+    };
+
+    /// Whether the first data byte of the message is part of the key.
+    constexpr static bool KeyHasAddress =
+        Type == MIDIMessageType::NOTE_ON ||
+        Type == MIDIMessageType::KEY_PRESSURE ||
+        Type == MIDIMessageType::CONTROL_CHANGE;
+
+    /// Combine the address, channel and cable number into a single key.
+    static uint16_t getKey(uint8_t address, uint8_t channel, uint8_t cable) {
+        return (KeyHasAddress ? (address & 0x7F) : 0) | //
+               uint16_t(channel & 0x0F) << 7 |          //
+               uint16_t(cable & 0x0F) << 11;
+    }
+    /// Get the key of an incoming channel message.
+    static uint16_t getKey(ChannelMessage msg) {
+        return getKey(msg.data1, msg.header & 0x0F, msg.cable.getRaw());
+    }
+
+    /// Get the first node of the bucket that the given key belongs to.
+    /// Follow the `next` pointers and compare the keys to find all elements
+    /// that listen to this key.
+    static Node *getBucket(uint16_t key) { return buckets[getHash(key)]; }
+
+    /// Remove all elements from the index.
+    static void clear() {
+        for (Node *&bucket : buckets)
+            bucket = nullptr;
+        size = 0;
+    }
+
+    /// Get the number of nodes currently in use.
+    static uint16_t getSize() { return size; }
+
+    /**
+     * @brief   Remove all nodes that were inserted after the size was equal to
+     *          @p newSize.
+     *
+     * Used to undo a partial registration if an element doesn't fit into the
+     * index.
+     */
+    static void truncate(uint16_t newSize) {
+        while (size > newSize) {
+            Node &node = nodes[--size];
+            // Nodes are always inserted at the front of their bucket, so the
+            // most recently inserted node is the first one in its bucket.
+            buckets[getHash(node.key)] = node.next;
+        }
+    }
+
+    /// Helper class that is passed to the matchers, so they can add all
+    /// addresses they listen to to the index.
+    class Registrar {
+      public:
+        Registrar(Element *element) : element(element) {}
+
+        /// Add the given raw address, channel [0, 15] and cable number
+        /// [0, 15] to the index.
+        /// @return False if the index is full, true otherwise.
+        bool add(uint8_t address, uint8_t channel, uint8_t cable) {
+            return insert(element, getKey(address, channel, cable));
+        }
+        /// Add the given MIDI address to the index.
+        /// @return False if the index is full, true otherwise.
+        bool add(MIDIAddress address) {
+            if (!address.isValid())
+                return true; // Never matches anything
+            return add(address.getAddress(), address.getRawChannel(),
+                       address.getRawCableNumber());
+        }
+        /// Add the given MIDI channel and cable number to the index.
+        /// @return False if the index is full, true otherwise.
+        bool add(MIDIChannelCable address) { return add(MIDIAddress(address)); }
+
+      private:
+        Element *element;
+    };
+
+    /// Add the addresses of the given matcher to the index, if the matcher
+    /// supports it (i.e. if it has an `addToIndex` method).
+    /// @return True if all addresses of the matcher were added, false if the
+    ///         matcher doesn't support the index or if the index is full.
+    template <class Matcher>
+    static bool addMatcher(const Matcher &matcher, Registrar &registrar) {
+        return addMatcherImpl(matcher, registrar, 0);
+    }
+
+  private:
+    static uint8_t getHash(uint16_t key) {
+        return (key ^ (key >> 7)) & (MIDI_INPUT_INDEX_BUCKETS - 1);
+    }
+
+    static bool insert(Element *element, uint16_t key) {
+        Node *&bucket = buckets[getHash(key)];
+        // Some matchers register the same key multiple times, e.g. if the
+        // address isn't part of the key
+        for (Node *node = bucket; node != nullptr; node = node->next)
+            if (node->key == key && node->element == element)
+                return true;
+        if (size >= MIDI_INPUT_INDEX_SIZE)
+            return false;
+        Node &node = nodes[size++];
+        node = {bucket, element, key};
+        bucket = &node;
+        return true;
+    }
+
+    template <class Matcher>
+    static auto addMatcherImpl(const Matcher &matcher, Registrar &registrar,
+                               int) -> decltype(matcher.addToIndex(registrar)) {
+        return matcher.addToIndex(registrar);
+    }
+    template <class Matcher>
+    static bool addMatcherImpl(const Matcher &, Registrar &, long) {
+        return false;
+    }
+
+  private:
+    static Node *buckets[MIDI_INPUT_INDEX_BUCKETS];
+    static Node nodes[MIDI_INPUT_INDEX_SIZE];
+    static uint16_t size;
+};
+
+template <MIDIMessageType Type>
+typename MIDIInputElementIndex<Type>::Node
+    *MIDIInputElementIndex<Type>::buckets[MIDI_INPUT_INDEX_BUCKETS] = {};
+template <MIDIMessageType Type>
+typename MIDIInputElementIndex<Type>::Node
+    MIDIInputElementIndex<Type>::nodes[MIDI_INPUT_INDEX_SIZE];
+template <MIDIMessageType Type>
+uint16_t MIDIInputElementIndex<Type>::size = 0;
+
+END_CS_NAMESPACE
@@ -27,6 +27,12 @@ struct OneByteMIDIMatcher {
         return {true, value};
     }
 
+    /// Add the address to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return index.add(address);
+    }
+
     MIDIChannelCable address;
 };
 
@@ -50,6 +56,12 @@ struct TwoByteMIDIMatcher {
         return {true, value};
     }
 
+    /// Add the address to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return index.add(address);
+    }
+
     MIDIAddress address;
 };
 
@@ -71,6 +83,12 @@ struct PitchBendMIDIMatcher {
         return {true, value};
     }
 
+    /// Add the address to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return index.add(address);
+    }
+
     MIDIChannelCable address;
 };
 
@@ -98,6 +116,15 @@ struct TwoByteRangeMIDIMatcher {
         return {true, value, index};
     }
 
+    /// Add all addresses of the range to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        for (uint8_t i = 0; i < length; ++i)
+            if (!index.add(address + i))
+                return false;
+        return true;
+    }
+
     MIDIAddress address;
     uint8_t length;
 };
@@ -138,6 +165,13 @@ struct BankableOneByteMIDIMatcher {
     /// @see    @ref Bank<N>::getSelection()
     setting_t getSelection() const { return getBank().getSelection(); }
 
+    /// Add the addresses of all banks to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return BankableMIDIMatcherHelpers::addBankableToIndex(index, address,
+                                                              config);
+    }
+
     BaseBankConfig<BankSize> config;
     MIDIChannelCable address;
 };
@@ -177,6 +211,13 @@ struct BankableTwoByteMIDIMatcher {
     /// @see    @ref Bank<N>::getSelection()
     setting_t getSelection() const { return getBank().getSelection(); }
 
+    /// Add the addresses of all banks to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return BankableMIDIMatcherHelpers::addBankableToIndex(index, address,
+                                                              config);
+    }
+
     BaseBankConfig<BankSize> config;
     MIDIAddress address;
 };
@@ -217,6 +258,13 @@ struct BankablePitchBendMIDIMatcher {
     /// @see    @ref Bank<N>::getSelection()
     setting_t getSelection() const { return getBank().getSelection(); }
 
+    /// Add the addresses of all banks to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return BankableMIDIMatcherHelpers::addBankableToIndex(index, address,
+                                                              config);
+    }
+
     BaseBankConfig<BankSize> config;
     MIDIChannelCable address;
 };
@@ -259,6 +307,13 @@ struct BankableTwoByteRangeMIDIMatcher {
     /// @see    @ref Bank<N>::getSelection()
     setting_t getSelection() const { return config.bank.getSelection(); }
 
+    /// Add the addresses of all banks to the given MIDI input element index.
+    template <class Index>
+    bool addToIndex(Index &index) const {
+        return BankableMIDIMatcherHelpers::addBankableToIndex(index, address,
+                                                              config, length);
+    }
+
     BaseBankConfig<BankSize> config;
     MIDIAddress address;
     uint8_t length;
@@ -42,12 +42,19 @@ bool BLEMIDIPacketBuilder::addImpl(uint8_t header, uint8_t data1, uint8_t data2,
         if (ThreeBytes)
             buffer.push_back(data2);
     }
+    ++numMessages;
     return true;
 }
 
 void BLEMIDIPacketBuilder::reset() {
+    if (!buffer.empty()) {
+        ++stats.packets;
+        stats.messages += numMessages;
+        stats.bytes += buffer.size();
+    }
     buffer.resize(0);
     runningHeader = 0;
+    numMessages = 0;
 }
 
 void BLEMIDIPacketBuilder::setCapacity(uint16_t capacity) {
@@ -75,9 +82,11 @@ bool BLEMIDIPacketBuilder::addRealTime(uint8_t rt, uint16_t timestamp) {
     if (!hasSpaceFor(2))
         return false; // Buffer full
 
-    buffer.push_back(getTimestampLSB(timestamp));
+    uint8_t timestampLSB = getTimestampLSB(timestamp);
+    buffer.push_back(timestampLSB);
     buffer.push_back(rt);
-    runningTimestamp = 0; // Re-send the timestamp next time
+    updateRunningTimestampSystem(timestampLSB);
+    ++numMessages;
 
     return true;
 }
@@ -97,7 +106,8 @@ bool BLEMIDIPacketBuilder::addSysCommon(uint8_t num_data, uint8_t header,
         buffer.push_back(data1);
     if (num_data >= 2)
         buffer.push_back(data2);
-    runningTimestamp = 0; // Re-send the timestamp next time
+    updateRunningTimestampSystem(timestampLSB);
+    ++numMessages;
 
     return true;
 }
@@ -127,6 +137,7 @@ bool BLEMIDIPacketBuilder::addSysEx(const uint8_t *&data, size_t &length,
         buffer.push_back(SysExStart);
         ++data; // First byte was added
         --length;
+        ++numMessages;
     }
 
     // Copy the rest of the data, and terminate the message if necessary
@@ -8,10 +8,47 @@ BEGIN_CS_NAMESPACE
 
 /// Class for building MIDI over Bluetooth Low Energy packets.
 class BLEMIDIPacketBuilder {
+  public:
+    /// Determines which bytes are omitted from the packets.
+    enum class Packing : uint8_t {
+        /// Use running status, and omit the timestamp of running status
+        /// messages with the same timestamp as the previous message. The
+        /// timestamp is always repeated after a system message, as in the
+        /// figures of the BLE-MIDI specification. This is the default.
+        Compatible,
+        /// Also omit the timestamp of running status messages that follow a
+        /// system real-time or system common message with the same timestamp.
+        /// System messages don't cancel running status, and the timestamp of
+        /// the system message still applies, so this is allowed by the
+        /// specification, but some receivers might not expect it.
+        Optimal,
+    };
+
+    /// Statistics about the packets built so far.
+    struct Stats {
+        /// Number of complete packets, i.e. the number of times @ref reset()
+        /// was called for a non-empty packet.
+        uint32_t packets = 0;
+        /// Number of messages in these packets. Every SysEx message counts
+        /// as a single message, including its continuation packets.
+        uint32_t messages = 0;
+        /// Number of bytes in these packets.
+        uint32_t bytes = 0;
+
+        /// Get the average number of bytes per message, including the packet
+        /// headers and timestamps.
+        float getBytesPerMessage() const {
+            return messages == 0 ? 0.f : float(bytes) / float(messages);
+        }
+    };
+
   private:
     uint8_t runningHeader = 0;
     uint8_t runningTimestamp = 0;
     std::vector<uint8_t> buffer = std::vector<uint8_t>(0);
+    Packing packing = Packing::Compatible;
+    uint16_t numMessages = 0;
+    Stats stats;
 
     constexpr static const uint8_t SysExStart =
         static_cast<uint8_t>(MIDIMessageType::SYSEX_START);
@@ -39,6 +76,13 @@ class BLEMIDIPacketBuilder {
             buffer.push_back(getTimestampMSB(timestamp));
     }
 
+    /// Update the running timestamp after adding a system message with the
+    /// given timestamp.
+    void updateRunningTimestampSystem(uint8_t timestampLSB) {
+        // Re-send the timestamp next time, unless optimal packing is enabled
+        runningTimestamp = packing == Packing::Optimal ? timestampLSB : 0;
+    }
+
     /** 
      * @brief   Try adding a 2-byte or 3-byte MIDI channel voice message to the
      *          packet.
@@ -71,6 +115,11 @@ class BLEMIDIPacketBuilder {
     /// Reset the builder to start a new packet.
     void reset();
 
+    /// Select which bytes are omitted from the packets.
+    void setPacking(Packing packing) { this->packing = packing; }
+    /// @copydoc setPacking
+    Packing getPacking() const { return packing; }
+
     /// Set the maximum capacity of the buffer. Set this to the MTU of the BLE
     /// link minus three bytes (for notify overhead).
     void setCapacity(uint16_t capacity);
@@ -85,6 +134,14 @@ class BLEMIDIPacketBuilder {
     /// Return the packet as a vector of bytes.
     const std::vector<uint8_t> &getPacket() const { return buffer; }
 
+    /// Get the number of messages in the current packet.
+    uint16_t getMessageCount() const { return numMessages; }
+    /// Get the statistics of all complete packets so far. Use them to compare
+    /// the number of bytes per message of the different @ref Packing modes.
+    const Stats &getStats() const { return stats; }
+    /// Reset the statistics to zero.
+    void resetStats() { stats = {}; }
+
     /** 
      * @brief   Try adding a 3-byte MIDI channel voice message to the packet.
      * 
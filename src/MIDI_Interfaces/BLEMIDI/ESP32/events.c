@@ -48,7 +48,9 @@ void gap_event_handler(esp_gap_ble_cb_event_t event,
             }
             break;
 
-        case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT: break;
+        case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+            midi_handle_conn_params_event(param);
+            break;
 
         case ESP_GAP_BLE_PASSKEY_REQ_EVT: break;
         case ESP_GAP_BLE_OOB_REQ_EVT: break;
@@ -0,0 +1,31 @@
+#ifdef ESP32
+
+/**
+ * @file
+ * 
+ * Handling connection parameter updates for MIDI over BLE.
+ */
+
+#include "midi-private.h"
+#include "logging.h"
+
+static midi_conn_interval_callback_t midi_conn_interval_callback = NULL;
+static uint16_t midi_conn_interval = 0;
+
+void midi_set_conn_interval_callback(midi_conn_interval_callback_t cb) {
+    midi_conn_interval_callback = cb;
+}
+
+void midi_handle_conn_params_event(esp_ble_gap_cb_param_t *param) {
+    if (param->update_conn_params.status != ESP_BT_STATUS_SUCCESS)
+        return;
+    midi_conn_interval = param->update_conn_params.conn_int;
+    ESP_LOGI("MIDIBLE", "Connection interval: %d", midi_conn_interval);
+    if (midi_conn_interval_callback) {
+        midi_conn_interval_callback(midi_conn_interval);
+    }
+}
+
+uint16_t midi_get_conn_interval(void) { return midi_conn_interval; }
+
+#endif
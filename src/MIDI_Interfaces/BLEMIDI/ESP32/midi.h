@@ -25,6 +25,18 @@ void midi_set_mtu_callback(midi_mtu_callback_t cb);
 /// client.
 uint16_t midi_get_mtu(void);
 
+/// Type for the connection interval callback. The argument is the connection
+/// interval in units of 1.25 ms.
+/// @warning    Used in C code, use C calling convention (use `extern "C"` to
+///             declare this function in C++ code).
+typedef void (*midi_conn_interval_callback_t)(uint16_t);
+/// Set the callback that is to be called when the connection parameters of the
+/// link with the BLE client are updated.
+void midi_set_conn_interval_callback(midi_conn_interval_callback_t cb);
+/// Get the current connection interval of the link with the BLE client, in
+/// units of 1.25 ms, or zero if not yet known.
+uint16_t midi_get_conn_interval(void);
+
 /// Type for the BLE MIDI write callback.
 /// @warning    Used in C code, use C calling convention (use `extern "C"` to
 ///             declare this function in C++ code).
@@ -28,8 +28,12 @@ bool BluetoothMIDI_Interface::handleSendEvents() {
     // Wait for a packet to be started (or for a stop signal)
     cv.wait(lock, [this] { return !packetbuilder.empty() || stop_sending; });
     bool keep_going = !stop_sending;
-    // Wait for flush signal or timeout
-    bool flushing = cv.wait_for(lock, timeout, [this] { return flushnow; });
+    // Wait for flush signal or timeout/next connection interval
+    auto flush_requested = [this] { return flushnow; };
+    bool flushing = flush_mode == FlushMode::Timeout
+                        ? cv.wait_for(lock, timeout, flush_requested)
+                        : cv.wait_until(lock, getNextConnectionEvent(),
+                                        flush_requested);
 
     // Send the packet over BLE, empty the buffer, and update the buffer size
     // based on the MTU of the connected clients.
@@ -37,6 +41,8 @@ bool BluetoothMIDI_Interface::handleSendEvents() {
         notifyMIDIBLE(packetbuilder.getPacket());
     packetbuilder.reset();
     packetbuilder.setCapacity(min_mtu - 3);
+    // Start the next packet with the messages that didn't fit in this one
+    fillPacketFromQueue();
 
     // Notify the main thread that the flush was done
     if (flushing) {
@@ -47,6 +53,16 @@ bool BluetoothMIDI_Interface::handleSendEvents() {
     return keep_going;
 }
 
+auto BluetoothMIDI_Interface::getNextConnectionEvent()
+    -> std::chrono::steady_clock::time_point {
+    auto now = std::chrono::steady_clock::now();
+    auto interval = getConnectionInterval();
+    // Skip the intervals that passed while the sender was idle
+    if (next_conn_event <= now)
+        next_conn_event += ((now - next_conn_event) / interval + 1) * interval;
+    return next_conn_event;
+}
+
 void BluetoothMIDI_Interface::flushImpl(lock_t &lock) {
     assert(lock.owns_lock());
     // No need to send empty packets
@@ -102,14 +118,7 @@ void BluetoothMIDI_Interface::sendChannelMessageImpl3Bytes(ChannelMessage msg) {
     // packet buffer
     lock_t lock(mtx);
     uint16_t timestamp = millis();
-    // Try adding the message to the current packet
-    if (!packetbuilder.add3B(msg.header, msg.data1, msg.data2, timestamp)) {
-        // If that doesn't work, flush the packet (send it now and wait until
-        // it is sent)
-        flushImpl(lock);
-        // And then add it to the (now emtpy) buffer
-        packetbuilder.add3B(msg.header, msg.data1, msg.data2, timestamp);
-    }
+    addMessage(lock, {msg, MIDIReadEvent::CHANNEL_MESSAGE, timestamp});
     // Notify the packet sender that data has been added to the buffer
     lock.unlock();
     cv.notify_one();
@@ -120,10 +129,7 @@ void BluetoothMIDI_Interface::sendChannelMessageImpl2Bytes(ChannelMessage msg) {
     //   sendChannelMessageImpl3Bytes() above
     lock_t lock(mtx);
     uint16_t timestamp = millis();
-    if (!packetbuilder.add2B(msg.header, msg.data1, timestamp)) {
-        flushImpl(lock);
-        packetbuilder.add2B(msg.header, msg.data1, timestamp);
-    }
+    addMessage(lock, {msg, MIDIReadEvent::CHANNEL_MESSAGE, timestamp});
     lock.unlock();
     cv.notify_one();
 }
@@ -133,10 +139,8 @@ void BluetoothMIDI_Interface::sendRealTimeImpl(RealTimeMessage msg) {
     //   sendChannelMessageImpl3Bytes() above
     lock_t lock(mtx);
     uint16_t timestamp = millis();
-    if (!packetbuilder.addRealTime(msg.message, timestamp)) {
-        flushImpl(lock);
-        packetbuilder.addRealTime(msg.message, timestamp);
-    }
+    MIDIMessage m {msg.message, 0x00, 0x00, msg.cable};
+    addMessage(lock, {m, MIDIReadEvent::REALTIME_MESSAGE, timestamp});
     lock.unlock();
     cv.notify_one();
 }
@@ -146,19 +150,101 @@ void BluetoothMIDI_Interface::sendSysCommonImpl(SysCommonMessage msg) {
     //   sendChannelMessageImpl3Bytes() above
     lock_t lock(mtx);
     uint16_t timestamp = millis();
-    uint8_t num_data = msg.getNumberOfDataBytes();
-    if (!packetbuilder.addSysCommon(num_data, msg.header, msg.data1, msg.data2,
-                                    timestamp)) {
-        flushImpl(lock);
-        packetbuilder.addSysCommon(num_data, msg.header, msg.data1, msg.data2,
-                                   timestamp);
-    }
+    addMessage(lock, {msg, MIDIReadEvent::SYSCOMMON_MESSAGE, timestamp});
     lock.unlock();
     cv.notify_one();
 }
 
+void BluetoothMIDI_Interface::addMessage(lock_t &lock,
+                                         const PendingMessage &msg) {
+    assert(lock.owns_lock());
+    // Try adding the message to the current packet (unless older messages are
+    // still waiting in the queue)
+    if (send_queue.empty() && addToPacket(msg))
+        return;
+    if (flush_mode == FlushMode::Timeout) {
+        // If that doesn't work, flush the packet (send it now and wait until
+        // it is sent)
+        flushImpl(lock);
+        // And then add it to the (now emtpy) buffer
+        addToPacket(msg);
+    } else {
+        // Don't block, the sender thread will add it to one of the next
+        // packets
+        enqueue(lock, msg);
+    }
+}
+
+bool BluetoothMIDI_Interface::addToPacket(const PendingMessage &msg) {
+    const MIDIMessage &m = msg.message;
+    switch (msg.type) {
+        case MIDIReadEvent::CHANNEL_MESSAGE:
+            return ChannelMessage(m).hasTwoDataBytes()
+                       ? packetbuilder.add3B(m.header, m.data1, m.data2,
+                                             msg.timestamp)
+                       : packetbuilder.add2B(m.header, m.data1, msg.timestamp);
+        case MIDIReadEvent::SYSCOMMON_MESSAGE:
+            return packetbuilder.addSysCommon(
+                SysCommonMessage(m).getNumberOfDataBytes(), m.header, m.data1,
+                m.data2, msg.timestamp);
+        case MIDIReadEvent::REALTIME_MESSAGE:
+            return packetbuilder.addRealTime(m.header, msg.timestamp);
+        case MIDIReadEvent::NO_MESSAGE:
+        case MIDIReadEvent::SYSEX_MESSAGE:
+        case MIDIReadEvent::SYSEX_CHUNK:
+        default: return true; // LCOV_EXCL_LINE
+    }
+}
+
+void BluetoothMIDI_Interface::enqueue(lock_t &lock,
+                                      const PendingMessage &msg) {
+    if (send_queue.full()) {
+        if (send_queue.dropSupersededControlChange(msg)) {
+            ++dropped;
+        } else {
+            // Nothing can be dropped, wait for the sender to make room
+            while (send_queue.full())
+                flushImpl(lock);
+        }
+    }
+    send_queue.push(msg);
+}
+
+void BluetoothMIDI_Interface::fillPacketFromQueue() {
+    while (!send_queue.empty() && addToPacket(send_queue.front()))
+        send_queue.pop();
+}
+
+bool BluetoothMIDI_Interface::SendQueue::dropSupersededControlChange(
+    const PendingMessage &newest) {
+    auto isSuperseded = [&](uint8_t i) {
+        const PendingMessage &msg = buffer[(head + i) % SendQueueSize];
+        if (msg.isSameController(newest))
+            return true;
+        for (uint8_t j = i + 1; j < size; ++j)
+            if (msg.isSameController(buffer[(head + j) % SendQueueSize]))
+                return true;
+        return false;
+    };
+    for (uint8_t i = 0; i < size; ++i) {
+        if (isSuperseded(i)) {
+            // Shift the newer messages to fill the gap
+            for (uint8_t j = i; j + 1 < size; ++j)
+                buffer[(head + j) % SendQueueSize] =
+                    buffer[(head + j + 1) % SendQueueSize];
+            --size;
+            return true;
+        }
+    }
+    return false;
+}
+
 void BluetoothMIDI_Interface::sendSysExImpl(SysExMessage msg) {
     lock_t lock(mtx);
+    // The SysEx data is not owned by the queue, so send the queued messages
+    // first, and then send the SysEx message directly
+    while (!send_queue.empty())
+        flushImpl(lock);
 
     size_t length = msg.length;
     const uint8_t *data = msg.data;
@@ -192,31 +278,56 @@ void BluetoothMIDI_Interface::sendSysExImpl(SysExMessage msg) {
 void BluetoothMIDI_Interface::parse(const uint8_t *const data,
                                     const size_t len) {
     auto mididata = BLEMIDIParser(data, len);
+#if MIDI_TIMESTAMPS
+    // All messages in a BLE packet are received at the same time, so use the
+    // BLE-MIDI timestamps (13-bit, in milliseconds) to restore the timing
+    // between the messages, relative to the last message in the packet.
+    const uint32_t now = getMIDITimestamp();
+    uint16_t lastBLETimestamp;
+    {
+        auto scan = mididata;
+        uint8_t midiByte;
+        while (scan.pull(midiByte))
+            ;
+        lastBLETimestamp = scan.getTimestamp();
+    }
+    auto getTimestamp = [&] {
+        uint16_t age = (lastBLETimestamp - mididata.getTimestamp()) & 0x1FFF;
+        uint32_t timestamp = now - uint32_t(age) * 1000;
+        return timestamp == 0 ? 1 : timestamp;
+    };
+#else
+    auto getTimestamp = [] { return uint32_t(0); };
+#endif
     MIDIReadEvent event = parser.pull(mididata);
     // TODO: add a timeout instead of busy waiting?
     while (event != MIDIReadEvent::NO_MESSAGE) {
         switch (event) {
-            case MIDIReadEvent::CHANNEL_MESSAGE:
-                while (!queue.push(parser.getChannelMessage(),
-                                   mididata.getTimestamp()))
+            case MIDIReadEvent::CHANNEL_MESSAGE: {
+                ChannelMessage msg = parser.getChannelMessage();
+                msg.setTimestamp(getTimestamp());
+                while (!queue.push(msg, mididata.getTimestamp()))
                     std::this_thread::yield();
-                break;
+            } break;
             case MIDIReadEvent::SYSEX_CHUNK: // fallthrough
-            case MIDIReadEvent::SYSEX_MESSAGE:
-                while (!queue.push(parser.getSysExMessage(),
-                                   mididata.getTimestamp()))
+            case MIDIReadEvent::SYSEX_MESSAGE: {
+                SysExMessage msg = parser.getSysExMessage();
+                msg.setTimestamp(getTimestamp());
+                while (!queue.push(msg, mididata.getTimestamp()))
                     std::this_thread::yield();
-                break;
-            case MIDIReadEvent::REALTIME_MESSAGE:
-                while (!queue.push(parser.getRealTimeMessage(),
-                                   mididata.getTimestamp()))
+            } break;
+            case MIDIReadEvent::REALTIME_MESSAGE: {
+                RealTimeMessage msg = parser.getRealTimeMessage();
+                msg.setTimestamp(getTimestamp());
+                while (!queue.push(msg, mididata.getTimestamp()))
                     std::this_thread::yield();
-                break;
-            case MIDIReadEvent::SYSCOMMON_MESSAGE:
-                while (!queue.push(parser.getSysCommonMessage(),
-                                   mididata.getTimestamp()))
+            } break;
+            case MIDIReadEvent::SYSCOMMON_MESSAGE: {
+                SysCommonMessage msg = parser.getSysCommonMessage();
+                msg.setTimestamp(getTimestamp());
+                while (!queue.push(msg, mididata.getTimestamp()))
                     std::this_thread::yield();
-                break;
+            } break;
             case MIDIReadEvent::NO_MESSAGE: break; // LCOV_EXCL_LINE
             default: break;                        // LCOV_EXCL_LINE
         }
@@ -276,6 +387,16 @@ void BluetoothMIDI_Interface::updateMTU(uint16_t mtu) {
         packetbuilder.setCapacity(min_mtu - 3);
 }
 
+void BluetoothMIDI_Interface::updateConnectionInterval(uint16_t interval) {
+    DEBUGFN(NAMEDVALUE(interval));
+    if (interval == 0)
+        return;
+    lock_t lock(mtx);
+    conn_interval = interval;
+    // Restart the grid of connection intervals
+    next_conn_event = std::chrono::steady_clock::now();
+}
+
 void BluetoothMIDI_Interface::forceMinMTU(uint16_t mtu) {
     force_min_mtu = mtu;
     updateMTU(min_mtu);
@@ -287,6 +408,11 @@ extern "C" void BluetoothMIDI_Interface_midi_mtu_callback(uint16_t mtu) {
     BluetoothMIDI_Interface::midi_mtu_callback(mtu);
 }
 
+extern "C" void
+BluetoothMIDI_Interface_midi_conn_interval_callback(uint16_t interval) {
+    BluetoothMIDI_Interface::midi_conn_interval_callback(interval);
+}
+
 extern "C" void BluetoothMIDI_Interface_midi_write_callback(const uint8_t *data,
                                                             size_t length) {
     BluetoothMIDI_Interface::midi_write_callback(data, length);
@@ -305,6 +431,8 @@ void BluetoothMIDI_Interface::setName(const char *name) {
 void BluetoothMIDI_Interface::begin() {
 #ifdef ARDUINO
     midi_set_mtu_callback(BluetoothMIDI_Interface_midi_mtu_callback);
+    midi_set_conn_interval_callback(
+        BluetoothMIDI_Interface_midi_conn_interval_callback);
     midi_set_write_callback(BluetoothMIDI_Interface_midi_write_callback);
     DEBUGFN(F("Initializing BLE MIDI Interface"));
     if (!midi_init()) {
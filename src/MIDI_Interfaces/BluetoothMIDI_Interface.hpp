@@ -3,9 +3,9 @@
 #include <AH/Error/Error.hpp>
 
 #include "BLEMIDI/BLEMIDIPacketBuilder.hpp"
-#include "BLEMIDI/MIDIMessageQueue.hpp"
 #include "MIDI_Interface.hpp"
 #include "Util/ESP32Threads.hpp"
+#include "Util/MIDIMessageQueue.hpp"
 #include <MIDI_Parsers/BLEMIDIParser.hpp>
 #include <MIDI_Parsers/SerialMIDI_Parser.hpp>
 
@@ -24,6 +24,10 @@ BEGIN_CS_NAMESPACE
 /**
  * @brief   Bluetooth Low Energy MIDI Interface for the ESP32.
  * 
+ * Outgoing messages are collected in a BLE packet, which is sent by a
+ * background thread. When and how the packets are sent depends on the
+ * @ref FlushMode, see @ref setFlushMode().
+ * 
  * @ingroup MIDIInterfaces
  */
 class BluetoothMIDI_Interface : public MIDI_Interface {
@@ -41,10 +45,71 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     }
 
   public:
-    /// Send the buffered MIDI BLE packet immediately.
+    /// Determines when the buffered MIDI BLE packets are sent.
+    enum class FlushMode : uint8_t {
+        /// Send the packet after a timeout (see @ref setTimeout()), or as soon
+        /// as it is full. When the packet is full, the sending functions block
+        /// until it has been sent. This is the default.
+        Timeout,
+        /// Send at most one packet per connection interval of the BLE link.
+        /// The packets are sent on a periodic grid with the interval that was
+        /// negotiated with the client, starting when the interval was last
+        /// updated. The BLE stack doesn't report the individual connection
+        /// events, so the grid is not synchronized to them, it only limits
+        /// the packet rate to what the link can carry.
+        /// Messages that don't fit in the current packet are added to a queue
+        /// of @ref SendQueueSize messages, and are packed into the following
+        /// packets, as many as the MTU allows. When the queue is full, the
+        /// oldest queued Control Change message that is superseded by a newer
+        /// value for the same controller, channel and cable (queued, or the
+        /// message that is being sent) is dropped, so the final value of a
+        /// controller is never lost.
+        /// If there is no such message, the sending function waits for the
+        /// next packet to be sent. System Exclusive messages are not queued,
+        /// they wait for the queue to be sent first.
+        ConnectionInterval,
+    };
+
+    /// The maximum number of messages that are queued in the
+    /// @ref FlushMode::ConnectionInterval mode.
+    static constexpr uint8_t SendQueueSize = 32;
+
+    /// Send the buffered MIDI BLE packet immediately, as well as all queued
+    /// messages. Blocks until everything has been sent.
     void flush() {
         lock_t lock(mtx);
-        flushImpl(lock);
+        while (!packetbuilder.empty())
+            flushImpl(lock);
+    }
+
+    /// Select when the buffered MIDI BLE packets are sent.
+    void setFlushMode(FlushMode mode) {
+        lock_t lock(mtx);
+        // The timeout mode never queues messages, so send them first
+        if (mode == FlushMode::Timeout)
+            while (!send_queue.empty())
+                flushImpl(lock);
+        flush_mode = mode;
+    }
+    /// @copydoc setFlushMode
+    FlushMode getFlushMode() const { return flush_mode; }
+
+    /// Get the number of superseded Control Change messages that were dropped
+    /// because the send queue was full (only in
+    /// @ref FlushMode::ConnectionInterval mode).
+    uint32_t getDroppedCount() const { return dropped; }
+
+    /// Select which bytes are omitted from the MIDI BLE packets.
+    /// @see    @ref BLEMIDIPacketBuilder::Packing
+    void setPacking(BLEMIDIPacketBuilder::Packing packing) {
+        lock_t lock(mtx);
+        packetbuilder.setPacking(packing);
+    }
+    /// Get the statistics of the MIDI BLE packets sent so far, e.g. the
+    /// average number of bytes per message.
+    BLEMIDIPacketBuilder::Stats getPackingStats() {
+        lock_t lock(mtx);
+        return packetbuilder.getStats();
     }
 
     /// Set the timeout, the number of milliseconds to buffer the outgoing MIDI
@@ -81,6 +146,16 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     /// Get the BLE-MIDI timestamp of the latest MIDI message.
     /// @note Invalid for SysEx chunks (except the last chunk of a message).
     uint16_t getTimestamp() const;
+#if !IGNORE_SYSEX
+    /// Stream all incoming SysEx data to the given sink. Messages that fit in
+    /// the SysEx buffer are still sent to the MIDI callbacks and pipes as
+    /// well, longer messages only go to the sink. Pass `nullptr` to go back
+    /// to buffering all messages.
+    /// @note   The sink is called from the BLE stack's callback, not from
+    ///         @ref update().
+    /// @see @ref SysExSink
+    void setSysExSink(SysExSink *sink) { parser.setSysExSink(sink); }
+#endif
 
   protected:
     // MIDI send implementations
@@ -108,6 +183,16 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     /// the MIDI BLE packet size.
     void updateMTU(uint16_t mtu);
 
+    /// The connection interval of the BLE link, in units of 1.25 ms. The
+    /// default is the interval requested when advertising (15 ms).
+    std::atomic_uint_fast16_t conn_interval{12};
+
+    /// Set the connection interval of the Bluetooth link, in units of 1.25 ms.
+    /// Used as the period of the packets in the
+    /// @ref FlushMode::ConnectionInterval mode, the grid is restarted at the
+    /// time of this call.
+    void updateConnectionInterval(uint16_t interval);
+
   public:
     /// Get the minimum MTU of all connected clients.
     uint16_t getMinMTU() const { return min_mtu; }
@@ -115,6 +200,11 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     /// Force the MTU to an artificially small value (used for testing).
     void forceMinMTU(uint16_t mtu);
 
+    /// Get the connection interval of the Bluetooth link.
+    std::chrono::microseconds getConnectionInterval() const {
+        return std::chrono::microseconds(conn_interval * 1250);
+    }
+
   private:
     /// Only one active instance.
     static BluetoothMIDI_Interface *instance;
@@ -122,12 +212,18 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     SerialMIDI_Parser parser{false};
     /// Builds outgoing MIDI BLE packets.
     BLEMIDIPacketBuilder packetbuilder;
-    /// Queue for incoming MIDI messages.
-    MIDIMessageQueue queue{64};
+    /// Lock-free queue type for incoming MIDI messages, with room for 64
+    /// messages and 1 KiB of SysEx data.
+    using Queue = MIDIMessageQueue<64, 1024>;
+    static_assert(SYSEX_BUFFER_SIZE <= 512,
+                  "SysEx chunks should fit in half of the queue's arena");
+    /// Queue for incoming MIDI messages, filled by the BLE stack, emptied by
+    /// @ref update().
+    Queue queue;
     /// Incoming message that can be from retrieved using the
     /// `getChannelMessage()`, `getSysCommonMessage()`, `getRealTimeMessage()`
     /// and `getSysExMessage()` methods.
-    MIDIMessageQueue::MIDIMessageQueueElement incomingMessage;
+    Queue::MIDIMessageQueueElement incomingMessage;
 
   private:
     // Synchronization for asynchronous BLE sending
@@ -149,6 +245,13 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     /// Timeout before the sender thread sends a packet.
     /// @see    @ref setTimeout()
     std::chrono::milliseconds timeout{10};
+    /// @see    @ref setFlushMode()
+    FlushMode flush_mode = FlushMode::Timeout;
+    /// Time of the next point on the grid of connection intervals the sender
+    /// thread aligns to.
+    std::chrono::steady_clock::time_point next_conn_event;
+    /// Number of Control Change messages dropped from the send queue.
+    uint32_t dropped = 0;
 
   private:
     /// Launch a thread that sends the BLE packets in the background.
@@ -156,10 +259,15 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
 
     /// Function that waits for BLE packets and sends them in the background.
     /// It either sends them after a timeout (a given number of milliseconds
-    /// after the first data was added to the packet), or immediately when it
-    /// receives a flush signal from the main thread.
+    /// after the first data was added to the packet) or at the next connection
+    /// event, depending on the @ref FlushMode, or immediately when it receives
+    /// a flush signal from the main thread.
     bool handleSendEvents();
 
+    /// Get the time of the next point on the grid of connection intervals
+    /// after now. The grid starts at the last connection interval update.
+    std::chrono::steady_clock::time_point getNextConnectionEvent();
+
     /// Tell the background BLE sender thread to send the current packet.
     /// Blocks until the packet is sent.
     ///
@@ -167,6 +275,77 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     ///         Lock should be locked at entry, will still be locked on exit.
     void flushImpl(lock_t &lock);
 
+  private:
+    /// A message that is waiting to be added to a BLE packet.
+    struct PendingMessage {
+        PendingMessage() : message(0x00, 0x00, 0x00) {}
+        PendingMessage(MIDIMessage message, MIDIReadEvent type,
+                       uint16_t timestamp)
+            : message(message), type(type), timestamp(timestamp) {}
+        MIDIMessage message;
+        MIDIReadEvent type = MIDIReadEvent::NO_MESSAGE;
+        uint16_t timestamp = 0;
+
+        bool isControlChange() const {
+            return type == MIDIReadEvent::CHANNEL_MESSAGE &&
+                   (message.header & 0xF0) ==
+                       uint8_t(MIDIMessageType::CONTROL_CHANGE);
+        }
+        /// Check if both are Control Change messages for the same controller,
+        /// channel and cable.
+        bool isSameController(const PendingMessage &other) const {
+            return isControlChange() && other.isControlChange() &&
+                   message.header == other.message.header &&
+                   message.data1 == other.message.data1 &&
+                   message.cable == other.message.cable;
+        }
+    };
+
+    /// Fixed-size FIFO of messages that didn't fit in the current packet.
+    class SendQueue {
+      public:
+        bool empty() const { return size == 0; }
+        bool full() const { return size == SendQueueSize; }
+        const PendingMessage &front() const { return buffer[head]; }
+        void push(const PendingMessage &msg) {
+            buffer[(head + size++) % SendQueueSize] = msg;
+        }
+        void pop() {
+            head = (head + 1) % SendQueueSize;
+            --size;
+        }
+        /// Remove the oldest Control Change message that is superseded by a
+        /// newer message for the same controller, either in the queue or the
+        /// given message that is about to be added.
+        /// @return False if the queue doesn't contain any superseded Control
+        ///         Change messages.
+        bool dropSupersededControlChange(const PendingMessage &newest);
+
+      private:
+        PendingMessage buffer[SendQueueSize];
+        uint8_t head = 0;
+        uint8_t size = 0;
+    };
+    /// Messages that didn't fit in the current packet, in the
+    /// @ref FlushMode::ConnectionInterval mode.
+    SendQueue send_queue;
+
+    /// Add the message to the current packet, or if it doesn't fit, send the
+    /// packet first (@ref FlushMode::Timeout) or add it to the send queue
+    /// (@ref FlushMode::ConnectionInterval).
+    ///
+    /// @param  lock
+    ///         Lock should be locked at entry, will still be locked on exit.
+    /// @param  msg
+    ///         The message to send.
+    void addMessage(lock_t &lock, const PendingMessage &msg);
+    /// Try to add the message to the current packet.
+    bool addToPacket(const PendingMessage &msg);
+    /// Add the message to the send queue, making room if necessary.
+    void enqueue(lock_t &lock, const PendingMessage &msg);
+    /// Move as many queued messages to the current packet as will fit.
+    void fillPacketFromQueue();
+
 #if !defined(ARDUINO) && !defined(DOXYGEN)
     public:
 #endif
@@ -184,6 +363,11 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
             instance->updateMTU(mtu);
     }
 
+    static void midi_conn_interval_callback(uint16_t interval) {
+        if (instance)
+            instance->updateConnectionInterval(interval);
+    }
+
 #ifdef ARDUINO
   private:
     void notifyMIDIBLE(const std::vector<uint8_t> &packet);
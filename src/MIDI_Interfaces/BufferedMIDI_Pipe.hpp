@@ -0,0 +1,226 @@
+#pragma once
+
+#include "MIDI_Pipes.hpp"
+#include "MIDI_Staller.hpp"
+#include <AH/Containers/Updatable.hpp>
+#include <MIDI_Parsers/MIDIReadEvent.hpp>
+#include <Settings/SettingsWrapper.hpp>
+#include <string.h> // memcpy
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/// @addtogroup MIDI_Routing
+/// @{
+
+/**
+ * @brief   A MIDI pipe that decouples its source from its sink using a bounded
+ *          queue.
+ *
+ * Messages from the source are added to the queue, and the queue is drained
+ * to the sink in the @ref update method, which is called by
+ * `Control_Surface.loop()` (or by `AH::Updatable<>::updateAll()` if you don't
+ * use the Control_Surface singleton). This way, a slow sink (e.g. a Bluetooth
+ * or USB interface that has to wait for the host) doesn't block the
+ * `update()` of the source, and the rest of the loop (e.g. scanning buttons)
+ * stays responsive.
+ *
+ * **Backpressure**
+ *
+ * When the queue is full, the pipe stalls its sink using the normal staller
+ * mechanism (see @ref MIDI_Pipe), so the source can check whether it should
+ * hold off using `isStalled()`, and `getStallerName()` reports the pipe. The
+ * pipe is un-stalled when the queue has been drained to half of its capacity.
+ * The queue is only ever drained in @ref update (or by an explicit call to
+ * @ref flush), never from the context of a source, so sending to a full pipe
+ * never blocks: messages that don't fit in the queue are dropped and
+ * counted, see @ref getOverflowCount.
+ * The queue is not drained while the sink is stalled by a different source
+ * (e.g. while another interface is in the middle of a chunked SysEx message),
+ * to prevent interleaving the messages.
+ *
+ * System Exclusive messages (and chunks) are queued like all other messages.
+ * Their data is copied into a separate buffer of @p SysExCapacity bytes, which
+ * is reused as soon as all queued SysEx messages have been forwarded.
+ * SysEx messages that don't fit in the remaining space are dropped as well.
+ *
+ * ~~~cpp
+ * HardwareSerialMIDI_Interface midiA = Serial1;
+ * BluetoothMIDI_Interface midiBLE;
+ * BufferedMIDI_PipeFactory<1, 32> pipes;
+ *
+ * midiA >> pipes >> midiBLE;
+ * ~~~
+ *
+ * @tparam  Capacity
+ *          The maximum number of messages in the queue.
+ * @tparam  SysExCapacity
+ *          The number of bytes of SysEx data that can be queued.
+ */
+template <uint16_t Capacity, uint16_t SysExCapacity = SYSEX_BUFFER_SIZE>
+class BufferedMIDI_Pipe : public MIDI_Pipe,
+                          public AH::Updatable<>,
+                          private MIDIStaller {
+    static_assert(Capacity >= 2, "Capacity must be at least 2");
+
+  public:
+    /// Destructor. Discards any queued messages.
+    ~BufferedMIDI_Pipe() override { unstallSink(); }
+
+    /// Does nothing.
+    void begin() override {}
+    /// Forward (at most @ref getMaxMessagesPerUpdate) queued messages to the
+    /// sink, unless the sink is stalled by a different source.
+    void update() override {
+        MIDIStaller *staller = getSinkStaller();
+        if (staller != nullptr && staller != this)
+            return;
+        forward(maxMessagesPerUpdate);
+    }
+    /// Forward all queued messages to the sink.
+    void flush() { forward(Capacity); }
+
+    /// Get the number of messages that are currently queued.
+    uint16_t getQueueSize() const { return size; }
+    /// Get the maximum number of messages in the queue.
+    static constexpr uint16_t getCapacity() { return Capacity; }
+
+    /// Limit the number of messages that are forwarded to the sink during a
+    /// single call to @ref update.
+    void setMaxMessagesPerUpdate(uint16_t max) { maxMessagesPerUpdate = max; }
+    /// @copydoc setMaxMessagesPerUpdate
+    uint16_t getMaxMessagesPerUpdate() const { return maxMessagesPerUpdate; }
+
+    /// Get the number of messages that were dropped because the queue (or
+    /// the SysEx buffer) was full.
+    uint32_t getOverflowCount() const { return overflows; }
+
+  private:
+    void mapForwardMIDI(ChannelMessage msg) override {
+        enqueue(msg, MIDIReadEvent::CHANNEL_MESSAGE);
+    }
+    void mapForwardMIDI(SysExMessage msg) override {
+        if (size == Capacity || msg.length > SysExCapacity - sysexSize) {
+            ++overflows;
+            return;
+        }
+        if (msg.length > 0)
+            memcpy(sysexData + sysexSize, msg.data, msg.length);
+        sysexSize += msg.length;
+        MIDIMessage m {0x00, uint8_t(msg.length), uint8_t(msg.length >> 8),
+                       msg.cable};
+        m.setTimestamp(msg.getTimestamp());
+        enqueue(m, MIDIReadEvent::SYSEX_MESSAGE);
+    }
+    void mapForwardMIDI(SysCommonMessage msg) override {
+        enqueue(msg, MIDIReadEvent::SYSCOMMON_MESSAGE);
+    }
+    void mapForwardMIDI(RealTimeMessage msg) override {
+        MIDIMessage m {msg.message, 0x00, 0x00, msg.cable};
+        m.setTimestamp(msg.getTimestamp());
+        enqueue(m, MIDIReadEvent::REALTIME_MESSAGE);
+    }
+
+    /// Called when a source sends a message to a pipe that is stalled because
+    /// this queue is full. The queue is only drained in @ref update, so the
+    /// message is dropped if there's still no room for it.
+    void handleStall() override {}
+    const char *getName() const override { return "BufferedMIDI_Pipe"; }
+
+  private:
+    /// A queued message, Real-Time messages are stored in the header.
+    /// For SysEx messages, the data bytes hold the length, and the data itself
+    /// is stored in @ref sysexData.
+    struct Element {
+        Element() : message(0x00, 0x00, 0x00) {}
+        Element(MIDIMessage message, MIDIReadEvent type)
+            : message(message), type(type) {}
+        MIDIMessage message;
+        MIDIReadEvent type = MIDIReadEvent::NO_MESSAGE;
+    };
+
+    void enqueue(MIDIMessage message, MIDIReadEvent type) {
+        if (size == Capacity) {
+            ++overflows;
+            return;
+        }
+        queue[(head + size) % Capacity] = {message, type};
+        if (++size == Capacity)
+            stallSink();
+    }
+
+    void forward(uint16_t count) {
+        while (count-- > 0 && size > 0) {
+            Element element = queue[head];
+            head = (head + 1) % Capacity;
+            --size;
+            send(element);
+        }
+        if (size <= Capacity / 2)
+            unstallSink();
+    }
+
+    void send(const Element &element) {
+        switch (element.type) {
+            case MIDIReadEvent::CHANNEL_MESSAGE:
+                sourceMIDItoSink(ChannelMessage(element.message));
+                break;
+            case MIDIReadEvent::SYSCOMMON_MESSAGE:
+                sourceMIDItoSink(SysCommonMessage(element.message));
+                break;
+            case MIDIReadEvent::REALTIME_MESSAGE: {
+                RealTimeMessage msg {element.message.header,
+                                     element.message.cable};
+                msg.setTimestamp(element.message.getTimestamp());
+                sourceMIDItoSink(msg);
+            } break;
+            case MIDIReadEvent::SYSEX_MESSAGE: {
+                uint16_t length = element.message.data1 |
+                                  uint16_t(element.message.data2 << 8);
+                SysExMessage msg {sysexData + sysexHead, length,
+                                  element.message.cable};
+                msg.setTimestamp(element.message.getTimestamp());
+                sourceMIDItoSink(msg);
+                sysexHead += length;
+                // All queued SysEx data has been sent, reuse the buffer
+                if (sysexHead == sysexSize)
+                    sysexHead = sysexSize = 0;
+            } break;
+            case MIDIReadEvent::NO_MESSAGE:
+            case MIDIReadEvent::SYSEX_CHUNK:
+            default: break; // LCOV_EXCL_LINE
+        }
+    }
+
+    /// Report backpressure by stalling the sink, unless it's already stalled.
+    void stallSink() {
+        if (getSinkStaller() == nullptr)
+            stallDownstream(this, nullptr);
+    }
+    /// Undo @ref stallSink.
+    void unstallSink() {
+        if (getSinkStaller() == this)
+            unstallDownstream(this, nullptr);
+    }
+
+  private:
+    Element queue[Capacity];
+    uint16_t head = 0;
+    uint16_t size = 0;
+    uint16_t maxMessagesPerUpdate = Capacity;
+    uint32_t overflows = 0;
+    uint8_t sysexData[SysExCapacity];
+    uint16_t sysexHead = 0;
+    uint16_t sysexSize = 0;
+};
+
+/// Factory that produces @ref BufferedMIDI_Pipe%s.
+template <size_t N, uint16_t Capacity>
+using BufferedMIDI_PipeFactory = MIDI_PipeFactory<N, BufferedMIDI_Pipe<Capacity>>;
+
+/// @}
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
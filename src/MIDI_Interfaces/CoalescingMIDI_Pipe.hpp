@@ -0,0 +1,168 @@
+#pragma once
+
+#include "MIDI_Pipes.hpp"
+#include <AH/Arduino-Wrapper.h> // millis
+#include <AH/Containers/Updatable.hpp>
+#include <Def/Def.hpp>
+#include <MIDI_Constants/Control_Change.hpp>
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/// @addtogroup MIDI_Routing
+/// @{
+
+/**
+ * @brief   A MIDI pipe that merges redundant Control Change and Pitch Bend
+ *          messages, so only the latest value of each controller is sent.
+ *
+ * When a fader or potentiometer moves quickly, it can send multiple values for
+ * the same controller during a single iteration of the main loop. This pipe
+ * holds on to the latest value for each (cable, channel, controller) or
+ * (cable, channel) for Pitch Bend, and forwards them to the sink at the end of
+ * `Control_Surface.loop()`, which saves bandwidth on slow links such as
+ * 5-pin DIN MIDI or Bluetooth.
+ *
+ * Other messages are never coalesced: when a Note, Program Change, SysEx or
+ * System Common message arrives, the pending values are forwarded first, so
+ * the order of all messages is preserved, only the intermediate values are
+ * dropped. Real-Time messages are forwarded immediately.
+ *
+ * By default, RPN/NRPN, Data Increment/Decrement and Channel Mode controllers
+ * are never coalesced, because their order and multiplicity matter. Override
+ * @ref shouldCoalesce to change this, e.g. if some controllers send relative
+ * values.
+ *
+ * ~~~cpp
+ * BluetoothMIDI_Interface midiBLE;
+ * CoalescingMIDI_Pipe<16> pipe;
+ *
+ * void setup() {
+ *     Control_Surface >> pipe >> midiBLE;
+ *     Control_Surface.begin();
+ * }
+ * ~~~
+ *
+ * @tparam  N
+ *          The maximum number of different controllers that can be pending at
+ *          the same time. If more controllers change within a single loop,
+ *          the pending values are forwarded early.
+ */
+template <uint8_t N>
+class CoalescingMIDI_Pipe : public MIDI_Pipe,
+                            public AH::Updatable<MIDIOutputStage> {
+    static_assert(N > 0, "Number of controllers must be greater than zero");
+
+  public:
+    /// Does nothing.
+    void begin() override {}
+    /// Forward the pending values if the coalescing window has passed, unless
+    /// the sink is stalled by a different source.
+    void update() override {
+        if (size == 0 || getSinkStaller() != nullptr)
+            return;
+        if (window == 0 || millis() - windowStart >= window)
+            flush();
+    }
+    /// Forward all pending values to the sink.
+    void flush() {
+        for (uint8_t i = 0; i < size; ++i)
+            sourceMIDItoSink(pending[i].message);
+        size = 0;
+    }
+
+    /// Set the minimum time (in milliseconds) between the first value of a
+    /// controller being received and the pending values being forwarded.
+    /// The default is zero, which means that the pending values are forwarded
+    /// at the end of every iteration of the main loop.
+    void setWindow(unsigned long window) { this->window = window; }
+    /// @copydoc setWindow
+    unsigned long getWindow() const { return window; }
+
+    /// Get the number of values that are currently pending.
+    uint8_t getPendingCount() const { return size; }
+    /// Get the number of messages that were dropped because they were replaced
+    /// by a newer value of the same controller.
+    uint32_t getCoalescedCount() const { return coalesced; }
+
+  protected:
+    /// Check whether the given Control Change or Pitch Bend message can be
+    /// replaced by a later value for the same controller.
+    virtual bool shouldCoalesce(ChannelMessage msg) const {
+        if (msg.getMessageType() == MIDIMessageType::PITCH_BEND)
+            return true;
+        uint8_t controller = msg.getData1();
+        bool dataEntry = controller == MIDI_CC::Data_Entry_MSB ||
+                         controller == MIDI_CC::Data_Entry_MSB_LSB;
+        bool parameterNumber = controller >= MIDI_CC::Data_Increment &&
+                               controller <= MIDI_CC::RPN_MSB;
+        bool channelMode = controller >= MIDI_CC::All_Sound_Off;
+        return !dataEntry && !parameterNumber && !channelMode;
+    }
+
+  private:
+    void mapForwardMIDI(ChannelMessage msg) override {
+        auto type = msg.getMessageType();
+        bool isCCorPB = type == MIDIMessageType::CONTROL_CHANGE ||
+                        type == MIDIMessageType::PITCH_BEND;
+        if (isCCorPB && shouldCoalesce(msg)) {
+            add(msg);
+        } else {
+            flush();
+            sourceMIDItoSink(msg);
+        }
+    }
+    void mapForwardMIDI(SysExMessage msg) override {
+        flush();
+        sourceMIDItoSink(msg);
+    }
+    void mapForwardMIDI(SysCommonMessage msg) override {
+        flush();
+        sourceMIDItoSink(msg);
+    }
+    void mapForwardMIDI(RealTimeMessage msg) override { sourceMIDItoSink(msg); }
+
+    static bool sameController(ChannelMessage a, ChannelMessage b) {
+        return a.header == b.header && a.cable == b.cable &&
+               (a.getMessageType() == MIDIMessageType::PITCH_BEND ||
+                a.data1 == b.data1);
+    }
+
+    void add(ChannelMessage msg) {
+        for (uint8_t i = 0; i < size; ++i) {
+            if (sameController(pending[i].message, msg)) {
+                pending[i].message = msg;
+                ++coalesced;
+                return;
+            }
+        }
+        if (size == N)
+            flush();
+        if (size == 0 && window != 0)
+            windowStart = millis();
+        pending[size++].message = msg;
+    }
+
+  private:
+    struct Pending {
+        Pending() : message(0x00, 0x00, 0x00) {}
+        ChannelMessage message;
+    };
+    Pending pending[N];
+    uint8_t size = 0;
+    unsigned long window = 0;
+    unsigned long windowStart = 0;
+    uint32_t coalesced = 0;
+};
+
+/// Factory that produces @ref CoalescingMIDI_Pipe%s.
+template <size_t NumPipes, uint8_t N>
+using CoalescingMIDI_PipeFactory =
+    MIDI_PipeFactory<NumPipes, CoalescingMIDI_Pipe<N>>;
+
+/// @}
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
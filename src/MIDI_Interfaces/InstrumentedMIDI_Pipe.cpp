@@ -0,0 +1,52 @@
+#include "InstrumentedMIDI_Pipe.hpp"
+#include <AH/PrintStream/PrintStream.hpp>
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+void InstrumentedMIDI_Pipe::stallDownstream(MIDIStaller *cause,
+                                             TrueMIDI_Source *src) {
+    bool sinkWasStalled = getSinkStaller() != nullptr;
+    bool throughWasStalled = getThroughStaller() != nullptr;
+    MIDI_Pipe::stallDownstream(cause, src);
+    countStalls(sinkWasStalled, throughWasStalled);
+}
+
+void InstrumentedMIDI_Pipe::stallUpstream(MIDIStaller *cause,
+                                          TrueMIDI_Sink *src) {
+    bool sinkWasStalled = getSinkStaller() != nullptr;
+    bool throughWasStalled = getThroughStaller() != nullptr;
+    MIDI_Pipe::stallUpstream(cause, src);
+    countStalls(sinkWasStalled, throughWasStalled);
+}
+
+void InstrumentedMIDI_Pipe::countStalls(bool sinkWasStalled,
+                                        bool throughWasStalled) {
+    if (!sinkWasStalled && getSinkStaller() != nullptr)
+        ++stats.sinkStalls;
+    if (!throughWasStalled && getThroughStaller() != nullptr)
+        ++stats.throughStalls;
+}
+
+static Print &operator<<(Print &os, const MIDI_PipeStats::Counter &c) {
+    return os << c.messages << F(" msg, ") << c.bytes << F(" B");
+}
+
+Print &operator<<(Print &os, const MIDI_PipeStats &stats) {
+    return os << F("Channel: ") << stats.channel              //
+              << F("\r\nSysEx: ") << stats.sysex              //
+              << F("\r\nSysCommon: ") << stats.syscommon      //
+              << F("\r\nRealTime: ") << stats.realtime        //
+              << F("\r\nStalls: ") << stats.sinkStalls        //
+              << F(" sink, ") << stats.throughStalls          //
+              << F(" through\r\nDrops: ") << stats.drops      //
+              << F("\r\nForward time: ")                      //
+              << stats.getMinForwardTime() << F(" / ")        //
+              << stats.getAverageForwardTime() << F(" / ")    //
+              << stats.maxForwardTime << F(" µs (min/avg/max)");
+}
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
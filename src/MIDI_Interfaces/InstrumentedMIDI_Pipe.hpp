@@ -0,0 +1,165 @@
+#pragma once
+
+#include "MIDI_Pipes.hpp"
+#include <AH/Arduino-Wrapper.h> // Print, micros
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/// @addtogroup MIDI_Routing
+/// @{
+
+/// Statistics about the traffic through a single MIDI pipe.
+/// @see    @ref InstrumentedMIDI_Pipe
+struct MIDI_PipeStats {
+    /// Message and byte counters for a single type of MIDI message.
+    struct Counter {
+        uint32_t messages = 0;
+        uint32_t bytes = 0;
+
+        void add(uint32_t numBytes) {
+            ++messages;
+            bytes += numBytes;
+        }
+    };
+
+    Counter channel;   ///< Channel Voice/Mode messages.
+    Counter sysex;     ///< System Exclusive messages (or chunks).
+    Counter syscommon; ///< System Common messages.
+    Counter realtime;  ///< System Real-Time messages.
+
+    /// Number of times the sink of the pipe was stalled.
+    uint32_t sinkStalls = 0;
+    /// Number of times the “through” output of the pipe was stalled.
+    uint32_t throughStalls = 0;
+    /// Number of messages that were accepted by the pipe but not forwarded
+    /// to a sink.
+    uint32_t drops = 0;
+
+    /// Shortest time it took to forward a message to the sink (µs).
+    uint32_t minForwardTime = std::numeric_limits<uint32_t>::max();
+    /// Longest time it took to forward a message to the sink (µs).
+    uint32_t maxForwardTime = 0;
+    /// Sum of the time it took to forward all messages to the sink (µs).
+    uint32_t totalForwardTime = 0;
+    /// Number of messages that were forwarded to the sink.
+    uint32_t forwarded = 0;
+
+    /// Get the total number of messages that were accepted by the pipe.
+    uint32_t getMessageCount() const {
+        return channel.messages + sysex.messages + syscommon.messages +
+               realtime.messages;
+    }
+    /// Get the total number of bytes that were accepted by the pipe.
+    uint32_t getByteCount() const {
+        return channel.bytes + sysex.bytes + syscommon.bytes + realtime.bytes;
+    }
+    /// Get the average time it took to forward a message to the sink (µs).
+    uint32_t getAverageForwardTime() const {
+        return forwarded == 0 ? 0 : totalForwardTime / forwarded;
+    }
+    /// Get the shortest time it took to forward a message to the sink (µs),
+    /// or zero if no messages were forwarded yet.
+    uint32_t getMinForwardTime() const {
+        return forwarded == 0 ? 0 : minForwardTime;
+    }
+
+    /// Record the time it took to forward a single message.
+    void addForwardTime(uint32_t duration) {
+        ++forwarded;
+        totalForwardTime += duration;
+        if (duration < minForwardTime)
+            minForwardTime = duration;
+        if (duration > maxForwardTime)
+            maxForwardTime = duration;
+    }
+
+    /// Reset all counters to zero.
+    void reset() { *this = {}; }
+};
+
+/// Print the statistics of a pipe in a human-readable format.
+Print &operator<<(Print &os, const MIDI_PipeStats &stats);
+
+/**
+ * @brief   A MIDI pipe that keeps track of the number of messages and bytes
+ *          it routes, the number of stalls and drops, and the time it takes to
+ *          forward messages to its sink.
+ *
+ * It's a drop-in replacement for a normal @ref MIDI_Pipe, so you only pay for
+ * the instrumentation on the routes you're interested in:
+ *
+ * ~~~cpp
+ * MIDI_PipeFactory<2, InstrumentedMIDI_Pipe> pipes;
+ *
+ * midiA >> pipes >> midiB;
+ * midiC >> pipes >> midiB;
+ *
+ * void loop() {
+ *     // ...
+ *     Serial << pipes[0].getStats() << endl;
+ * }
+ * ~~~
+ *
+ * The forward time is measured using `micros()` and includes the time spent in
+ * the sink (e.g. writing the message to a serial port), which makes it easy to
+ * find the route that's saturated.
+ */
+class InstrumentedMIDI_Pipe : public MIDI_Pipe {
+  public:
+    /// Get the statistics of this pipe.
+    const MIDI_PipeStats &getStats() const { return stats; }
+    /// Reset all statistics of this pipe.
+    void resetStats() { stats.reset(); }
+
+  protected:
+    /// Record the given message and forward it to the sink, measuring how long
+    /// it takes. Messages that arrive when there is no sink are counted as
+    /// drops.
+    template <class Message>
+    void forwardAndMeasure(Message msg) {
+        if (!hasSink()) {
+            ++stats.drops;
+            return;
+        }
+        uint32_t start = micros();
+        sourceMIDItoSink(msg);
+        stats.addForwardTime(micros() - start);
+    }
+
+  private:
+    void mapForwardMIDI(ChannelMessage msg) override {
+        stats.channel.add(msg.hasTwoDataBytes() ? 3 : 2);
+        forwardAndMeasure(msg);
+    }
+    void mapForwardMIDI(SysExMessage msg) override {
+        stats.sysex.add(msg.length);
+        forwardAndMeasure(msg);
+    }
+    void mapForwardMIDI(SysCommonMessage msg) override {
+        stats.syscommon.add(1 + msg.getNumberOfDataBytes());
+        forwardAndMeasure(msg);
+    }
+    void mapForwardMIDI(RealTimeMessage msg) override {
+        stats.realtime.add(1);
+        forwardAndMeasure(msg);
+    }
+
+  protected:
+    void stallDownstream(MIDIStaller *cause, TrueMIDI_Source *src) override;
+    void stallUpstream(MIDIStaller *cause, TrueMIDI_Sink *src) override;
+
+  private:
+    /// Count the stallers that were added since the given previous state.
+    void countStalls(bool sinkWasStalled, bool throughWasStalled);
+
+  private:
+    MIDI_PipeStats stats;
+};
+
+/// @}
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -33,24 +33,28 @@ MIDI_Interface *MIDI_Interface::DefaultMIDI_Interface = nullptr;
 // Handling incoming MIDI events
 
 void MIDI_Interface::onChannelMessage(ChannelMessage message) {
+    timestampIncoming(message);
     sourceMIDItoPipe(message);
     if (callbacks)
         callbacks->onChannelMessage(*this, message);
 }
 
 void MIDI_Interface::onSysExMessage(SysExMessage message) {
+    timestampIncoming(message);
     sourceMIDItoPipe(message);
     if (callbacks)
         callbacks->onSysExMessage(*this, message);
 }
 
 void MIDI_Interface::onSysCommonMessage(SysCommonMessage message) {
+    timestampIncoming(message);
     sourceMIDItoPipe(message);
     if (callbacks)
         callbacks->onSysCommonMessage(*this, message);
 }
 
 void MIDI_Interface::onRealTimeMessage(RealTimeMessage message) {
+    timestampIncoming(message);
     sourceMIDItoPipe(message);
     if (callbacks)
         callbacks->onRealTimeMessage(*this, message);
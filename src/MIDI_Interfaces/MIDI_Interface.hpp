@@ -67,6 +67,12 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
     friend class MIDI_Sender<MIDI_Interface>;
     /// Low-level function for sending a MIDI channel voice message.
     virtual void sendChannelMessageImpl(ChannelMessage) = 0;
+    /// Low-level function for sending multiple MIDI channel voice messages.
+    /// Sends them one by one by default.
+    virtual void sendChannelMessagesImpl(const ChannelMessage *messages,
+                                         size_t count) {
+        MIDI_Sender::sendChannelMessagesImpl(messages, count);
+    }
     /// Low-level function for sending a MIDI system common message.
     virtual void sendSysCommonImpl(SysCommonMessage) = 0;
     /// Low-level function for sending a system exclusive MIDI message.
@@ -98,6 +104,25 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
     /// pipe.
     void onRealTimeMessage(RealTimeMessage message);
 
+    /// Set the timestamp of an incoming message to the current time, unless
+    /// the interface already captured a more accurate timestamp earlier.
+    /// Does nothing if @ref MIDI_TIMESTAMPS is disabled.
+    template <class Message>
+    static void timestampIncoming(Message &message) {
+#if MIDI_TIMESTAMPS
+        if (!message.hasTimestamp())
+            message.setTimestamp(getMIDITimestamp());
+#else
+        (void)message;
+#endif
+    }
+    /// Get the current time to use as the timestamp of an incoming message.
+    /// Never returns zero, because that means “no timestamp”.
+    static uint32_t getMIDITimestamp() {
+        uint32_t now = micros();
+        return now == 0 ? 1 : now;
+    }
+
   public:
     /// Read, parse and dispatch incoming MIDI messages on the given interface.
     template <class MIDIInterface_t>
@@ -105,12 +130,47 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
     /// Dispatch the given type of MIDI message from the given interface.
     template <class MIDIInterface_t>
     static void dispatchIncoming(MIDIInterface_t *iface, MIDIReadEvent event);
+    /// Dispatch the given type of MIDI message, reading the message itself
+    /// from @p messages, which provides the same getters as the interfaces
+    /// and parsers (`getChannelMessage()`, `getSysExMessage()` etc.).
+    template <class MIDIInterface_t, class Messages>
+    static void dispatchIncoming(MIDIInterface_t *iface, MIDIReadEvent event,
+                                 const Messages &messages);
+    /// Dispatch a single message decoded by the block parsing functions of
+    /// the parsers (e.g. @ref SerialMIDI_Parser::parseBlock). SysEx messages
+    /// are read from the given parser.
+    template <class MIDIInterface_t, class Parser>
+    static void dispatchBlockEvent(MIDIInterface_t *iface,
+                                   const MIDI_Parser::BlockEvent &evt,
+                                   const Parser &parser);
     /// Un-stall the given MIDI interface. Assumes the interface has been
     /// stalled because of a chunked SysEx messages. Waits untill that message
     /// is finished.
     template <class MIDIInterface_t>
     static void handleStall(MIDIInterface_t *iface);
 
+  private:
+    /// Provides the message getters for @ref dispatchIncoming, given a
+    /// message decoded by a block parsing function.
+    template <class Parser>
+    struct BlockEventMessages {
+        const MIDI_Parser::BlockEvent &evt;
+        const Parser &parser;
+
+        ChannelMessage getChannelMessage() const {
+            return ChannelMessage(evt.message);
+        }
+        SysExMessage getSysExMessage() const {
+            return parser.getSysExMessage();
+        }
+        SysCommonMessage getSysCommonMessage() const {
+            return SysCommonMessage(evt.message);
+        }
+        RealTimeMessage getRealTimeMessage() const {
+            return RealTimeMessage(evt.message.header, evt.message.cable);
+        }
+    };
+
   private:
     MIDI_Callbacks *callbacks = nullptr;
 
@@ -142,25 +202,40 @@ void MIDI_Interface::updateIncoming(MIDIInterface_t *iface) {
 template <class MIDIInterface_t>
 void MIDI_Interface::dispatchIncoming(MIDIInterface_t *iface,
                                       MIDIReadEvent event) {
+    dispatchIncoming(iface, event, *iface);
+}
+
+template <class MIDIInterface_t, class Messages>
+void MIDI_Interface::dispatchIncoming(MIDIInterface_t *iface,
+                                      MIDIReadEvent event,
+                                      const Messages &messages) {
     switch (event) {
         case MIDIReadEvent::CHANNEL_MESSAGE:
-            iface->onChannelMessage(iface->getChannelMessage());
+            iface->onChannelMessage(messages.getChannelMessage());
             break;
         case MIDIReadEvent::SYSEX_CHUNK: // fallthrough
         case MIDIReadEvent::SYSEX_MESSAGE:
-            iface->onSysExMessage(iface->getSysExMessage());
+            iface->onSysExMessage(messages.getSysExMessage());
             break;
         case MIDIReadEvent::SYSCOMMON_MESSAGE:
-            iface->onSysCommonMessage(iface->getSysCommonMessage());
+            iface->onSysCommonMessage(messages.getSysCommonMessage());
             break;
         case MIDIReadEvent::REALTIME_MESSAGE:
-            iface->onRealTimeMessage(iface->getRealTimeMessage());
+            iface->onRealTimeMessage(messages.getRealTimeMessage());
             break;
         case MIDIReadEvent::NO_MESSAGE: break; // LCOV_EXCL_LINE
         default: break;                        // LCOV_EXCL_LINE
     }
 }
 
+template <class MIDIInterface_t, class Parser>
+void MIDI_Interface::dispatchBlockEvent(MIDIInterface_t *iface,
+                                        const MIDI_Parser::BlockEvent &evt,
+                                        const Parser &parser) {
+    BlockEventMessages<Parser> messages {evt, parser};
+    dispatchIncoming(iface, evt.event, messages);
+}
+
 template <class MIDIInterface_t>
 void MIDI_Interface::handleStall(MIDIInterface_t *iface) {
     iface->unstall(iface);
@@ -543,8 +543,10 @@ class MIDI_Pipe : private MIDI_Sink, private MIDI_Source {
         sourceMIDItoSink(msg);
     }
 
-  private:
-    /// @name Private functions to stall and un-stall pipes
+  protected:
+    /// @name Functions to stall and un-stall pipes
+    /// Can be overridden to observe stall events, overrides must call the
+    /// base class implementation.
     /// @{
 
     /// Stall this pipe and all other pipes further downstream (following the
@@ -15,6 +15,16 @@ class MIDI_Sender {
 
     /// Send a MIDI %Channel Voice message.
     void send(ChannelMessage message);
+    /// Send multiple MIDI %Channel Voice messages at once. Interfaces that
+    /// support it (e.g. USB MIDI) encode all messages into a single buffer and
+    /// hand it to the hardware at once, instead of message per message.
+    /// Invalid messages are skipped.
+    void send(const ChannelMessage *messages, size_t count);
+    /// @copydoc send(const ChannelMessage *, size_t)
+    template <size_t N>
+    void send(const ChannelMessage (&messages)[N]) {
+        send(messages, N);
+    }
 
     /**
      * @brief   Send a 3-byte MIDI %Channel Voice message.
@@ -172,6 +182,12 @@ class MIDI_Sender {
     sendPB(MIDIChannelCable address, uint16_t value);
 
     /// @}
+
+  protected:
+    /// Low-level function for sending multiple MIDI channel voice messages.
+    /// The default implementation sends them one by one. Derived classes can
+    /// hide it with a more efficient version.
+    void sendChannelMessagesImpl(const ChannelMessage *messages, size_t count);
 };
 
 END_CS_NAMESPACE
@@ -129,6 +129,19 @@ void MIDI_Sender<Derived>::send(ChannelMessage message) {
     }
 }
 
+template <class Derived>
+void MIDI_Sender<Derived>::send(const ChannelMessage *messages, size_t count) {
+    if (count > 0)
+        CRTP(Derived).sendChannelMessagesImpl(messages, count);
+}
+
+template <class Derived>
+void MIDI_Sender<Derived>::sendChannelMessagesImpl(
+    const ChannelMessage *messages, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        send(messages[i]);
+}
+
 template <class Derived>
 void MIDI_Sender<Derived>::send(SysCommonMessage message) {
     if (message.hasValidSystemCommonHeader()) {
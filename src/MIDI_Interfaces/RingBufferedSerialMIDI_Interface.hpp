@@ -0,0 +1,196 @@
+#pragma once
+
+#include "SerialMIDI_Interface.hpp"
+#include "Util/ByteRingBuffer.hpp"
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   A class for MIDI interfaces that receive MIDI data through a ring
+ *          buffer that is filled asynchronously, e.g. by the UART receive
+ *          interrupt or a DMA transfer, and send MIDI data over a Stream.
+ *
+ * @ref StreamMIDI_Interface only reads from the Stream during `update()`. If
+ * the main loop is busy for a long time (e.g. while updating a display), the
+ * receive buffer of the serial driver can overflow at high baud rates, and
+ * MIDI data is lost. This interface decouples the reception of the data from
+ * the main loop: the receive side of the serial port hands its bytes to
+ * @ref receive (or writes them to the ring directly, see
+ * @ref getReceiveRing), and @ref update parses them in place, in contiguous
+ * blocks.
+ *
+ * How the ring is filled depends on the platform:
+ *
+ *  - From the UART receive interrupt handler, if your core lets you install
+ *    one, call `receive(byte)` for every byte.
+ *  - From a DMA “half transfer” or “transfer complete” interrupt, call
+ *    `receive(data, length)`, or let the DMA engine write to
+ *    `getReceiveRing().getWriteSpan()` and call `getReceiveRing().commit()`.
+ *  - Otherwise, call @ref poll regularly from a timer interrupt or from a
+ *    place where the main loop blocks (e.g. `yield()`), to move the bytes from
+ *    the Stream's buffer into the (larger) ring.
+ *
+ * The producer side must only be used from one context at a time, and the
+ * consumer side (@ref update and @ref read) only from the main loop.
+ * If the ring overflows, the excess bytes are dropped and counted, see
+ * @ref getOverflowCount.
+ *
+ * @note    Incoming messages are timestamped when they are parsed, not when
+ *          they are received.
+ *
+ * @tparam  Capacity
+ *          The size of the receive ring in bytes. Must be a power of two.
+ *
+ * @ingroup MIDIInterfaces
+ */
+template <uint16_t Capacity = SERIAL_MIDI_RX_RING_SIZE>
+class RingBufferedStreamMIDI_Interface : public StreamMIDI_Interface {
+  public:
+    /// Constructor.
+    /// @param   stream
+    ///          Reference to the Stream interface to send MIDI data to, and to
+    ///          read MIDI data from in @ref poll.
+    RingBufferedStreamMIDI_Interface(Stream &stream)
+        : StreamMIDI_Interface(stream) {}
+
+    /// @name   Receiving (producer)
+    /// @{
+
+    /// Add a received byte to the ring. Can be called from an interrupt
+    /// handler.
+    /// @return False if the ring is full and the byte was dropped.
+    bool receive(uint8_t byte) {
+        if (ring.push(byte))
+            return true;
+        overflows = overflows + 1;
+        return false;
+    }
+    /// Add a block of received bytes to the ring. Can be called from an
+    /// interrupt handler.
+    /// @return The number of bytes that were added, the others were dropped.
+    uint16_t receive(const uint8_t *data, uint16_t length) {
+        uint16_t added = ring.push(data, length);
+        if (added < length)
+            overflows = overflows + (length - added);
+        return added;
+    }
+    /// Move all bytes that are available in the Stream to the ring.
+    /// Bytes that don't fit are left in the Stream.
+    void poll() {
+        int available;
+        while ((available = stream.available()) > 0) {
+            uint8_t *span;
+            uint16_t length = ring.getWriteSpan(span);
+            if (length == 0)
+                break;
+            if (size_t(available) < length)
+                length = available;
+            length = stream.readBytes(span, length);
+            if (length == 0)
+                break;
+            ring.commit(length);
+        }
+    }
+
+    /// Get direct access to the receive ring, e.g. to let a DMA engine write
+    /// into it.
+    ByteRingBuffer<Capacity> &getReceiveRing() { return ring; }
+
+    /// Get the number of received bytes that were dropped because the ring
+    /// was full.
+    uint32_t getOverflowCount() const { return overflows; }
+
+    /// @}
+
+    /// @name   Reading (consumer)
+    /// @{
+
+    /// Try reading and parsing a single incoming MIDI message from the ring.
+    /// @return  Returns the type of the read message, or
+    ///          `MIDIReadEvent::NO_MESSAGE` if no MIDI message was available.
+    MIDIReadEvent read() { return parser.pull(RingPuller {ring}); }
+
+    /// Parse all bytes that were in the ring when this function was called,
+    /// in place, in contiguous blocks, and dispatch the messages.
+    /// Bytes that arrive while parsing are handled during the next call, so
+    /// a fast producer cannot block the main loop.
+    void update() override {
+        if (getStaller() == this)
+            unstall(this);
+        bool chunked = false;
+        uint16_t remaining = ring.available();
+        uint16_t length;
+        do {
+            const uint8_t *data;
+            length = std::min(ring.getReadSpan(data), remaining);
+            parseAndDispatch(data, length, chunked);
+            ring.release(length);
+            remaining -= length;
+        } while (length > 0);
+        if (chunked)
+            stall(this);
+    }
+
+    /// @}
+
+  private:
+    /// Pulls bytes out of the receive ring, for @ref SerialMIDI_Parser::pull.
+    struct RingPuller {
+        ByteRingBuffer<Capacity> &ring;
+        bool pull(uint8_t &c) { return ring.pop(c); }
+    };
+
+  private:
+    ByteRingBuffer<Capacity> ring;
+    volatile uint32_t overflows = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+/**
+ * @brief   A wrapper class for @ref RingBufferedStreamMIDI_Interface on a
+ *          Serial port of generic class S.
+ *
+ * ~~~cpp
+ * RingBufferedSerialMIDI_Interface<HardwareSerial, 1024> midi {Serial1};
+ *
+ * void serialEvent1() { midi.poll(); } // or from a UART/DMA interrupt
+ * ~~~
+ *
+ * @tparam  S
+ *          The type of the Serial object.
+ * @tparam  Capacity
+ *          The size of the receive ring in bytes. Must be a power of two.
+ *
+ * @ingroup MIDIInterfaces
+ */
+template <class S, uint16_t Capacity = SERIAL_MIDI_RX_RING_SIZE>
+class RingBufferedSerialMIDI_Interface
+    : public RingBufferedStreamMIDI_Interface<Capacity> {
+  public:
+    /**
+     * @brief   Create a new MIDI Interface on the given Serial interface
+     *          with the given baud rate.
+     *
+     * @param   serial
+     *          The Serial interface.
+     * @param   baud
+     *          The baud rate for the Serial interface.
+     */
+    RingBufferedSerialMIDI_Interface(S &serial, unsigned long baud = MIDI_BAUD)
+        : RingBufferedStreamMIDI_Interface<Capacity>(serial), baud(baud) {}
+
+    /**
+     * @brief   Start the Serial interface at the predefined baud rate.
+     */
+    void begin() override { static_cast<S &>(this->stream).begin(baud); }
+
+  private:
+    const unsigned long baud;
+};
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -1,4 +1,5 @@
 #include "SerialMIDI_Interface.hpp"
+#include <AH/STL/algorithm> // std::min
 #include <MIDI_Parsers/StreamPuller.hpp>
 
 BEGIN_CS_NAMESPACE
@@ -11,7 +12,45 @@ MIDIReadEvent StreamMIDI_Interface::read() {
     return parser.pull(StreamPuller(stream));
 }
 
-void StreamMIDI_Interface::update() { MIDI_Interface::updateIncoming(this); }
+void StreamMIDI_Interface::update() {
+    if (getStaller() == this)
+        unstall(this);
+    bool chunked = false;
+    uint8_t data[SERIAL_MIDI_BLOCK_SIZE];
+    // Read blocks of bytes from the stream until it runs out of data. Every
+    // block is parsed completely before reading the next one.
+    size_t length;
+    do {
+        int available = stream.available();
+        length = std::min(available > 0 ? size_t(available) : size_t(0),
+                          size_t(SERIAL_MIDI_BLOCK_SIZE));
+        if (length > 0)
+            length = stream.readBytes(data, length);
+        parseAndDispatch(data, length, chunked);
+    } while (length > 0);
+    if (chunked)
+        stall(this);
+}
+
+void StreamMIDI_Interface::parseAndDispatch(const uint8_t *data, size_t length,
+                                            bool &chunked) {
+    SerialMIDI_Parser::BlockEvent events[SERIAL_MIDI_BLOCK_SIZE];
+    // The parser has to be called one more time after consuming all bytes,
+    // because it might still have a stored byte to resume.
+    SerialMIDI_Parser::BlockResult result;
+    do {
+        result = parser.parseBlock(data, length, events, SERIAL_MIDI_BLOCK_SIZE);
+        data += result.bytesConsumed;
+        length -= result.bytesConsumed;
+        for (size_t i = 0; i < result.numEvents; ++i) {
+            dispatchBlockEvent(this, events[i], parser);
+            if (events[i].event == MIDIReadEvent::SYSEX_CHUNK)
+                chunked = true;
+            if (events[i].event == MIDIReadEvent::SYSEX_MESSAGE)
+                chunked = false;
+        }
+    } while (length > 0 || result.numEvents > 0);
+}
 
 void StreamMIDI_Interface::handleStall() { MIDI_Interface::handleStall(this); }
 
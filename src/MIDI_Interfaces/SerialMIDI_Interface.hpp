@@ -36,9 +36,31 @@ class StreamMIDI_Interface : public MIDI_Interface {
     RealTimeMessage getRealTimeMessage() const;
     /// Return the received system exclusive message.
     SysExMessage getSysExMessage() const;
+#if !IGNORE_SYSEX
+    /// Stream all incoming SysEx data to the given sink. Messages that fit in
+    /// the SysEx buffer are still sent to the MIDI callbacks and pipes as
+    /// well, longer messages only go to the sink. Pass `nullptr` to go back
+    /// to buffering all messages.
+    /// @see @ref SysExSink
+    void setSysExSink(SysExSink *sink) { parser.setSysExSink(sink); }
+#endif
 
+    /// Read all available bytes from the stream in blocks of
+    /// @ref SERIAL_MIDI_BLOCK_SIZE, parse them, and dispatch the messages.
     void update() override;
 
+  protected:
+    /// Parse a block of bytes and dispatch all messages in it.
+    /// @param  data
+    ///         The bytes to parse.
+    /// @param  length
+    ///         The number of bytes to parse, may be zero to resume a byte that
+    ///         was stored by the parser.
+    /// @param[in,out]  chunked
+    ///         Set to true if the block ends in the middle of a SysEx message,
+    ///         to false if it contains the end of a SysEx message.
+    void parseAndDispatch(const uint8_t *data, size_t length, bool &chunked);
+
   protected:
     void sendChannelMessageImpl(ChannelMessage) override;
     void sendSysCommonImpl(SysCommonMessage) override;
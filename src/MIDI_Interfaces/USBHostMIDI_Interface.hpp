@@ -2,6 +2,7 @@
 
 #include "USBMIDI/Teensy-host/TeensyHostMIDI.hpp"
 #include "USBMIDI_Interface.hpp"
+#include <AH/STL/algorithm> // std::min
 
 AH_DIAGNOSTIC_WERROR()
 
@@ -18,6 +19,17 @@ class USBHostMIDIBackend {
     using MIDIUSBPacket_t = AH::Array<uint8_t, 4>;
     MIDIUSBPacket_t read() { return u32_to_bytes(backend.read()); }
     void write(MIDIUSBPacket_t data) { backend.write(bytes_to_u32(data)); }
+    void write(const MIDIUSBPacket_t *packets, size_t num_packets) {
+        uint32_t msgs[USB_MIDI_BLOCK_SIZE];
+        while (num_packets > 0) {
+            size_t n = std::min(num_packets, sizeof(msgs) / sizeof(*msgs));
+            for (size_t i = 0; i < n; ++i)
+                msgs[i] = bytes_to_u32(packets[i]);
+            backend.write(msgs, n);
+            packets += n;
+            num_packets -= n;
+        }
+    }
     void sendNow() { backend.send_now(); }
     bool preferImmediateSend() { return false; }
 
@@ -17,4 +17,18 @@ struct USBDeviceMIDIBackend {
     static bool preferImmediateSend() { return false; }
 };
 
+/// Mock backend that can read multiple packets at once, like the backends that
+/// receive entire USB endpoint buffers (e.g. @ref PluggableUSBMIDI).
+struct USBDeviceMIDIBulkBackend : USBDeviceMIDIBackend {
+    using USBDeviceMIDIBackend::read;
+    MOCK_METHOD(size_t, read, (MIDIUSBPacket_t *, size_t));
+};
+
+/// Mock backend that can write multiple packets at once, like the backends
+/// that fill entire USB endpoint buffers (e.g. @ref PluggableUSBMIDI).
+struct USBDeviceMIDIBulkWriteBackend : USBDeviceMIDIBackend {
+    using USBDeviceMIDIBackend::write;
+    MOCK_METHOD(void, write, (const MIDIUSBPacket_t *, size_t));
+};
+
 END_CS_NAMESPACE
\ No newline at end of file
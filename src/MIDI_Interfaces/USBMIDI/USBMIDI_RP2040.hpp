@@ -1,4 +1,5 @@
 #include <AH/Containers/Array.hpp>
+#include <AH/STL/algorithm> // std::min
 #include <Settings/NamespaceSettings.hpp>
 
 #include "mbed-m0/PluggableUSBMIDI.hpp"
@@ -8,7 +9,26 @@ BEGIN_CS_NAMESPACE
 struct RP2040_USBDeviceMIDIBackend {
     using MIDIUSBPacket_t = AH::Array<uint8_t, 4>;
     MIDIUSBPacket_t read() { return u32_to_bytes(backend.read()); }
+    size_t read(MIDIUSBPacket_t *packets, size_t max_packets) {
+        uint32_t msgs[PluggableUSBMIDI::PacketSize / 4];
+        max_packets = std::min(max_packets, sizeof(msgs) / sizeof(*msgs));
+        size_t num_read = backend.read(msgs, max_packets);
+        for (size_t i = 0; i < num_read; ++i)
+            packets[i] = u32_to_bytes(msgs[i]);
+        return num_read;
+    }
     void write(MIDIUSBPacket_t data) { backend.write(bytes_to_u32(data)); }
+    void write(const MIDIUSBPacket_t *packets, size_t num_packets) {
+        uint32_t msgs[PluggableUSBMIDI::PacketSize / 4];
+        while (num_packets > 0) {
+            size_t n = std::min(num_packets, sizeof(msgs) / sizeof(*msgs));
+            for (size_t i = 0; i < n; ++i)
+                msgs[i] = bytes_to_u32(packets[i]);
+            backend.write(msgs, n);
+            packets += n;
+            num_packets -= n;
+        }
+    }
     void sendNow() { backend.send_now(); }
     bool preferImmediateSend() { return false; } // TODO
 
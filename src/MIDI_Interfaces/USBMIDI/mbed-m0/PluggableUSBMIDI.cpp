@@ -3,7 +3,8 @@
 #include "PluggableUSBMIDI.hpp"
 #include <AH/Debug/Debug.hpp>
 
-#include <cstring> // memcpy
+#include <algorithm> // std::min
+#include <cstring>   // memcpy
 
 BEGIN_CS_NAMESPACE
 
@@ -404,37 +405,48 @@ void PluggableUSBMIDI::in_callback() {
 // ---------------------------------- READING ----------------------------------
 
 uint32_t PluggableUSBMIDI::read() {
+    uint32_t data = 0;
+    read(&data, 1);
+    return data;
+}
+
+uint32_t PluggableUSBMIDI::read(uint32_t *msgs, uint32_t num_msgs) {
     this->lock();
-    // Check if there are any bytes available for reading
-    uint32_t available = reading.available;
-    if (available == 0)
-        return this->unlock(), 0;
-
-    // Get the buffer with received data
-    uint32_t r = reading.read_idx;
-    rbuffer_t &readbuffer = reading.buffers[r];
-
-    // Read the data from the buffer (data is at least as new as available)
-    uint32_t data;
-    memcpy(&data, &readbuffer.buffer[readbuffer.index], 4);
-
-    readbuffer.index += 4;
-    // If we've read all messages from this buffer
-    if (readbuffer.index == readbuffer.size) {
-        // Increment the read index (and wrap around)
-        r = (r + 1 == NumRxPackets) ? 0 : r + 1;
-        reading.read_idx = r;
-        reading.available -= 1;
-        // There is now space in the queue
-        // Check if the next read is already in progress
-        bool inprogress = std::exchange(reading.reading, true);
-        if (!inprogress) {
-            // If not, start the next read now
-            uint32_t w = reading.write_idx;
-            read_start(bulk_out_ep, reading.buffers[w].buffer, PacketSize);
+    uint32_t num_read = 0;
+    while (num_read < num_msgs) {
+        // Check if there are any bytes available for reading
+        uint32_t available = reading.available;
+        if (available == 0)
+            break;
+
+        // Get the buffer with received data
+        uint32_t r = reading.read_idx;
+        rbuffer_t &readbuffer = reading.buffers[r];
+
+        // Read as many messages as possible from the buffer
+        uint32_t num_avail = (readbuffer.size - readbuffer.index) / 4;
+        uint32_t n = std::min(num_avail, num_msgs - num_read);
+        memcpy(msgs + num_read, &readbuffer.buffer[readbuffer.index], 4 * n);
+        readbuffer.index += 4 * n;
+        num_read += n;
+
+        // If we've read all messages from this buffer
+        if (readbuffer.index == readbuffer.size) {
+            // Increment the read index (and wrap around)
+            r = (r + 1 == NumRxPackets) ? 0 : r + 1;
+            reading.read_idx = r;
+            reading.available -= 1;
+            // There is now space in the queue
+            // Check if the next read is already in progress
+            bool inprogress = std::exchange(reading.reading, true);
+            if (!inprogress) {
+                // If not, start the next read now
+                uint32_t w = reading.write_idx;
+                read_start(bulk_out_ep, reading.buffers[w].buffer, PacketSize);
+            }
         }
     }
-    return this->unlock(), data;
+    return this->unlock(), num_read;
 }
 
 void PluggableUSBMIDI::out_callback() {
@@ -63,6 +63,15 @@ class PluggableUSBMIDI : protected arduino::internal::PluggableUSBModule {
     /// @return The message or 0x00000000 if no messages available.
     uint32_t read();
 
+    /// Try reading multiple 4-byte MIDI USB messages at once.
+    ///
+    /// @param  msgs
+    ///         The array to write the messages to.
+    /// @param  num_msgs
+    ///         The maximum number of messages to read.
+    /// @return The number of messages that were actually read.
+    uint32_t read(uint32_t *msgs, uint32_t num_msgs);
+
     /// Try sending the buffered data now.
     /// Start transmitting the latest packet if possible, even if it isn't full
     /// yet. If the latest packet is empty, this function has no effect.
@@ -3,7 +3,8 @@
 #include "PluggableUSBMIDI.hpp"
 #include <AH/Debug/Debug.hpp>
 
-#include <cstring> // memcpy
+#include <algorithm> // std::min
+#include <cstring>   // memcpy
 
 BEGIN_CS_NAMESPACE
 
@@ -408,36 +409,47 @@ void PluggableUSBMIDI::in_callback() {
 // ---------------------------------- READING ----------------------------------
 
 uint32_t PluggableUSBMIDI::read() {
-    // Check if there are any bytes available for reading
-    uint32_t available = reading.available.load(mo_acq);
-    if (available == 0)
-        return 0;
-
-    // Get the buffer with received data
-    uint32_t r = reading.read_idx.load(mo_rlx);
-    rbuffer_t &readbuffer = reading.buffers[r];
-
-    // Read the data from the buffer (data is at least as new as available)
-    uint32_t data;
-    memcpy(&data, &readbuffer.buffer[readbuffer.index], 4);
-
-    readbuffer.index += 4;
-    // If we've read all messages from this buffer
-    if (readbuffer.index == readbuffer.size) {
-        // Increment the read index (and wrap around)
-        r = (r + 1 == NumRxPackets) ? 0 : r + 1;
-        reading.read_idx.store(r, mo_rlx);
-        reading.available.fetch_sub(1, mo_rel);
-        // There is now space in the queue
-        // Check if the next read is already in progress
-        if (reading.reading.exchange(true, mo_acq) == false) {
-            // If not, start the next read now
-            uint32_t w = reading.write_idx.load(mo_rlx);
-            read_start(bulk_out_ep, reading.buffers[w].buffer, PacketSize);
+    uint32_t data = 0;
+    read(&data, 1);
+    return data;
+}
+
+uint32_t PluggableUSBMIDI::read(uint32_t *msgs, uint32_t num_msgs) {
+    uint32_t num_read = 0;
+    while (num_read < num_msgs) {
+        // Check if there are any bytes available for reading
+        uint32_t available = reading.available.load(mo_acq);
+        if (available == 0)
+            break;
+
+        // Get the buffer with received data
+        uint32_t r = reading.read_idx.load(mo_rlx);
+        rbuffer_t &readbuffer = reading.buffers[r];
+
+        // Read as many messages as possible from the buffer (data is at least
+        // as new as available)
+        uint32_t num_avail = (readbuffer.size - readbuffer.index) / 4;
+        uint32_t n = std::min(num_avail, num_msgs - num_read);
+        memcpy(msgs + num_read, &readbuffer.buffer[readbuffer.index], 4 * n);
+        readbuffer.index += 4 * n;
+        num_read += n;
+
+        // If we've read all messages from this buffer
+        if (readbuffer.index == readbuffer.size) {
+            // Increment the read index (and wrap around)
+            r = (r + 1 == NumRxPackets) ? 0 : r + 1;
+            reading.read_idx.store(r, mo_rlx);
+            reading.available.fetch_sub(1, mo_rel);
+            // There is now space in the queue
+            // Check if the next read is already in progress
+            if (reading.reading.exchange(true, mo_acq) == false) {
+                // If not, start the next read now
+                uint32_t w = reading.write_idx.load(mo_rlx);
+                read_start(bulk_out_ep, reading.buffers[w].buffer, PacketSize);
+            }
         }
     }
-
-    return data;
+    return num_read;
 }
 
 void PluggableUSBMIDI::out_callback() {
@@ -2,9 +2,11 @@
 
 #include "MIDI_Interface.hpp"
 #include "USBMIDI/USBMIDI.hpp"
+#include "USBMIDI_OutputScheduler.hpp"
 #include "USBMIDI_Sender.hpp"
 #include <AH/Error/Error.hpp>
 #include <AH/Teensy/TeensyUSBTypes.hpp>
+#include <Def/TypeTraits.hpp>
 #include <MIDI_Parsers/USBMIDI_Parser.hpp>
 
 AH_DIAGNOSTIC_WERROR()
@@ -29,18 +31,34 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
   private:
     // MIDI send implementations
     void sendChannelMessageImpl(ChannelMessage) override;
+    void sendChannelMessagesImpl(const ChannelMessage *messages,
+                                 size_t count) override;
     void sendSysCommonImpl(SysCommonMessage) override;
     void sendSysExImpl(SysExMessage) override;
     void sendRealTimeImpl(RealTimeMessage) override;
-    void sendNowImpl() override { backend.sendNow(); }
+    void sendNowImpl() override;
+    /// Validate the given channel messages and encode them using the given
+    /// sender.
+    template <class Send>
+    void encodeChannelMessages(const ChannelMessage *messages, size_t count,
+                               Send &send);
 
   private:
     void handleStall() override;
 
   public:
     void begin() override;
+    /// Read, parse and dispatch all incoming MIDI messages. If the backend can
+    /// read multiple packets at once, they are read in blocks of
+    /// @ref USB_MIDI_BLOCK_SIZE packets, otherwise, one packet at a time.
     void update() override;
 
+  private:
+    /// Read and dispatch the incoming messages one packet at a time.
+    void updateIncoming(std::false_type);
+    /// Read and dispatch the incoming messages in blocks of packets.
+    void updateIncoming(std::true_type);
+
   public:
     /// @name   Reading incoming MIDI messages
     /// @{
@@ -58,6 +76,14 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
     RealTimeMessage getRealTimeMessage() const;
     /// Return the received system exclusive message.
     SysExMessage getSysExMessage() const;
+#if !IGNORE_SYSEX
+    /// Stream all incoming SysEx data to the given sink. Messages that fit in
+    /// the SysEx buffer are still sent to the MIDI callbacks and pipes as
+    /// well, longer messages only go to the sink. Pass `nullptr` to go back
+    /// to buffering all messages.
+    /// @see @ref SysExSink
+    void setSysExSink(SysExSink *sink) { parser.setSysExSink(sink); }
+#endif
 
     /// @}
 
@@ -77,7 +103,51 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
             uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
             iface->backend.write({cn_cin, d0, d1, d2});
         }
+        void flush() {}
     };
+    /// Functor to send USB MIDI packets, collecting them in a buffer so they
+    /// can be written to the backend @ref USB_MIDI_BLOCK_SIZE packets at a
+    /// time. Call @ref flush to write the remaining packets.
+    struct BulkSender {
+        using MIDIUSBPacket_t = typename Backend::MIDIUSBPacket_t;
+        BulkSender(GenericUSBMIDI_Interface *iface) : iface(iface) {}
+        GenericUSBMIDI_Interface *iface;
+        MIDIUSBPacket_t packets[USB_MIDI_BLOCK_SIZE];
+        size_t size = 0;
+        void operator()(Cable cn, MIDICodeIndexNumber cin, uint8_t d0,
+                        uint8_t d1, uint8_t d2) {
+            uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
+            packets[size++] = {cn_cin, d0, d1, d2};
+            if (size == USB_MIDI_BLOCK_SIZE)
+                flush();
+        }
+        void flush() {
+            if (size > 0)
+                iface->backend.write(packets, size);
+            size = 0;
+        }
+    };
+    /// Functor to add USB MIDI packets to the queues of the
+    /// @ref USBMIDI_PacketScheduler. If a queue is full, packets are sent to
+    /// the backend until there is space.
+    struct ScheduledSender {
+        GenericUSBMIDI_Interface *iface;
+        USBMIDIPacketClass cls;
+        void operator()(Cable cn, MIDICodeIndexNumber cin, uint8_t d0,
+                        uint8_t d1, uint8_t d2) {
+            uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
+            while (!iface->scheduler->push({cn_cin, d0, d1, d2}, cls))
+                iface->sendScheduledPackets(1);
+        }
+    };
+#ifndef __SAM3X8E__ // Due compiler too old, see begin()
+    /// Functor used for sending multiple packets at once: @ref BulkSender if
+    /// the backend can write multiple packets at once, @ref Sender otherwise.
+    using BatchSender = typename std::conditional<
+        has_method_write_packets<Backend>::value, BulkSender, Sender>::type;
+#else
+    using BatchSender = Sender;
+#endif
     /// @}
 
   private:
@@ -85,6 +155,8 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
     USBMIDI_Parser parser;
     /// Sends USB MIDI messages.
     USBMIDI_Sender sender;
+    /// Optional output queues, see @ref setOutputScheduler().
+    USBMIDI_PacketScheduler *scheduler = nullptr;
     /// @see neverSendImmediately()
     bool alwaysSendImmediately_ = true;
 
@@ -108,6 +180,27 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
     /// @see @ref neverSendImmediately()
     void alwaysSendImmediately() { alwaysSendImmediately_ = true; }
 
+    /// @}
+
+  public:
+    /// @name   Prioritizing outgoing messages
+    /// @{
+
+    /// Queue all outgoing messages in the given scheduler, so Real-Time and
+    /// Channel messages can overtake long SysEx messages, see
+    /// @ref USBMIDI_OutputScheduler. Pass `nullptr` to send all messages
+    /// immediately again (after sending the queued packets).
+    void setOutputScheduler(USBMIDI_PacketScheduler *scheduler);
+    /// Get the output scheduler, or `nullptr` if none was set.
+    USBMIDI_PacketScheduler *getOutputScheduler() const { return scheduler; }
+
+  private:
+    /// Send the queued Real-Time and Channel packets, and at most the given
+    /// number of SysEx packets, to the backend.
+    void sendScheduledPackets(uint16_t sysexBudget);
+    /// Send all queued packets to the backend.
+    void sendAllScheduledPackets();
+
     /// @}
 };
 
@@ -24,9 +24,59 @@ void GenericUSBMIDI_Interface<Backend>::begin() {
 
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::update() {
+#ifndef __SAM3X8E__ // Due compiler too old, see begin()
+    updateIncoming(has_method_read_packets<Backend> {});
+#else
+    updateIncoming(std::false_type {});
+#endif
+    if (scheduler != nullptr && !scheduler->empty()) {
+        sendScheduledPackets(scheduler->getMaxSysExPacketsPerUpdate());
+        if (alwaysSendImmediately_)
+            backend.sendNow();
+    }
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::updateIncoming(std::false_type) {
     MIDI_Interface::updateIncoming(this);
 }
 
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::updateIncoming(std::true_type) {
+    using MIDIUSBPacket_t = typename Backend::MIDIUSBPacket_t;
+    if (getStaller() == this)
+        unstall(this);
+    bool chunked = false;
+    MIDIUSBPacket_t packets[USB_MIDI_BLOCK_SIZE];
+    USBMIDI_Parser::BlockEvent events[USB_MIDI_BLOCK_SIZE];
+    // Read blocks of packets from the backend until it runs out of data. Every
+    // block is parsed completely before reading the next one. The parser has
+    // to be called one more time after consuming all packets, because it might
+    // still have a stored packet to resume.
+    size_t count;
+    do {
+        count = backend.read(packets, size_t(USB_MIDI_BLOCK_SIZE));
+        const MIDIUSBPacket_t *begin = packets;
+        size_t remaining = count;
+        USBMIDI_Parser::BlockResult result;
+        do {
+            result = parser.parseBlock(begin, remaining, events,
+                                       USB_MIDI_BLOCK_SIZE);
+            begin += result.packetsConsumed;
+            remaining -= result.packetsConsumed;
+            for (size_t i = 0; i < result.numEvents; ++i) {
+                dispatchBlockEvent(this, events[i], parser);
+                if (events[i].event == MIDIReadEvent::SYSEX_CHUNK)
+                    chunked = true;
+                if (events[i].event == MIDIReadEvent::SYSEX_MESSAGE)
+                    chunked = false;
+            }
+        } while (remaining > 0 || result.numEvents > 0);
+    } while (count > 0);
+    if (chunked)
+        stall(this);
+}
+
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::handleStall() {
     MIDI_Interface::handleStall(this);
@@ -62,31 +112,121 @@ SysExMessage GenericUSBMIDI_Interface<Backend>::getSysExMessage() const {
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendChannelMessageImpl(
     ChannelMessage msg) {
-    sender.sendChannelMessage(msg, Sender {this});
+    if (scheduler != nullptr) {
+        sender.sendChannelMessage(
+            msg, ScheduledSender {this, USBMIDIPacketClass::Channel});
+        sendScheduledPackets(0);
+    } else {
+        sender.sendChannelMessage(msg, Sender {this});
+    }
     if (alwaysSendImmediately_)
         backend.sendNow();
 }
 
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::sendChannelMessagesImpl(
+    const ChannelMessage *messages, size_t count) {
+    if (scheduler != nullptr) {
+        ScheduledSender send {this, USBMIDIPacketClass::Channel};
+        encodeChannelMessages(messages, count, send);
+        sendScheduledPackets(0);
+    } else {
+        BatchSender send {this};
+        encodeChannelMessages(messages, count, send);
+        send.flush();
+    }
+    if (alwaysSendImmediately_)
+        backend.sendNow();
+}
+
+template <class Backend>
+template <class Send>
+void GenericUSBMIDI_Interface<Backend>::encodeChannelMessages(
+    const ChannelMessage *messages, size_t count, Send &send) {
+    for (size_t i = 0; i < count; ++i) {
+        ChannelMessage msg = messages[i];
+        if (!msg.hasValidChannelMessageHeader())
+            continue;
+        msg.sanitize();
+        sender.sendChannelMessage(msg, send);
+    }
+}
+
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendSysCommonImpl(
     SysCommonMessage msg) {
-    sender.sendSysCommonMessage(msg, Sender {this});
+    if (scheduler != nullptr) {
+        sender.sendSysCommonMessage(
+            msg, ScheduledSender {this, USBMIDIPacketClass::Channel});
+        sendScheduledPackets(0);
+    } else {
+        sender.sendSysCommonMessage(msg, Sender {this});
+    }
     if (alwaysSendImmediately_)
         backend.sendNow();
 }
 
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendSysExImpl(const SysExMessage msg) {
-    sender.sendSysEx(msg, Sender {this});
+    if (scheduler != nullptr) {
+        // The SysEx packets are sent to the backend during update()
+        sender.sendSysEx(msg, ScheduledSender {this, USBMIDIPacketClass::SysEx});
+        sendScheduledPackets(0);
+    } else {
+        BatchSender send {this};
+        sender.sendSysEx(msg, send);
+        send.flush();
+    }
     if (alwaysSendImmediately_)
         backend.sendNow();
 }
 
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendRealTimeImpl(RealTimeMessage msg) {
-    sender.sendRealTimeMessage(msg, Sender {this});
+    if (scheduler != nullptr) {
+        sender.sendRealTimeMessage(
+            msg, ScheduledSender {this, USBMIDIPacketClass::RealTime});
+        sendScheduledPackets(0);
+    } else {
+        sender.sendRealTimeMessage(msg, Sender {this});
+    }
     if (alwaysSendImmediately_)
         backend.sendNow();
 }
 
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::sendNowImpl() {
+    if (scheduler != nullptr)
+        sendAllScheduledPackets();
+    backend.sendNow();
+}
+
+// Output scheduling
+// -----------------------------------------------------------------------------
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::setOutputScheduler(
+    USBMIDI_PacketScheduler *scheduler) {
+    if (this->scheduler != nullptr)
+        sendAllScheduledPackets();
+    this->scheduler = scheduler;
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::sendScheduledPackets(
+    uint16_t sysexBudget) {
+    BatchSender send {this};
+    USBMIDI_PacketScheduler::MIDIUSBPacket_t packet;
+    while (scheduler->pop(packet, sysexBudget))
+        send(Cable(packet[0] >> 4), MIDICodeIndexNumber(packet[0] & 0x0F),
+             packet[1], packet[2], packet[3]);
+    send.flush();
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::sendAllScheduledPackets() {
+    while (!scheduler->empty())
+        sendScheduledPackets(0xFFFF);
+}
+
 END_CS_NAMESPACE
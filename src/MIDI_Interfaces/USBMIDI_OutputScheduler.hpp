@@ -0,0 +1,201 @@
+#pragma once
+
+#include <AH/Containers/Array.hpp>
+#include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/// The priority class of an outgoing USB MIDI packet, in order of decreasing
+/// priority.
+enum class USBMIDIPacketClass : uint8_t {
+    RealTime, ///< System Real-Time messages.
+    Channel,  ///< Channel Voice/Mode and System Common messages.
+    SysEx,    ///< System Exclusive data.
+};
+
+/**
+ * @brief   Abstract interface of the output queues of a USB MIDI interface.
+ *          See @ref USBMIDI_OutputScheduler.
+ */
+class USBMIDI_PacketScheduler {
+  public:
+    using MIDIUSBPacket_t = AH::Array<uint8_t, 4>;
+
+    virtual ~USBMIDI_PacketScheduler() = default;
+
+    /// Add a packet to the queue of its class and cable.
+    /// @return False if the queue is full, true otherwise.
+    virtual bool push(MIDIUSBPacket_t packet, USBMIDIPacketClass cls) = 0;
+    /// Remove the packet with the highest priority from the queues.
+    /// @param[out] packet
+    ///             The next packet to send.
+    /// @param[in,out]  sysexBudget
+    ///             The maximum number of SysEx packets that may be removed,
+    ///             decremented by one if the removed packet is a SysEx packet.
+    /// @return False if there are no (allowed) packets left to send.
+    virtual bool pop(MIDIUSBPacket_t &packet, uint16_t &sysexBudget) = 0;
+    /// Check whether all queues are empty.
+    virtual bool empty() const = 0;
+
+    /// Set the maximum number of SysEx packets that are handed to the USB
+    /// backend during a single `update()` of the interface.
+    /// Real-Time messages never have to wait behind more than this many SysEx
+    /// packets, so it determines the worst-case Real-Time latency: at
+    /// USB full speed, the host reads at most one endpoint buffer
+    /// (@ref USB_MIDI_BLOCK_SIZE packets) per millisecond.
+    void setMaxSysExPacketsPerUpdate(uint16_t max) {
+        maxSysExPacketsPerUpdate = max;
+    }
+    /// @copydoc setMaxSysExPacketsPerUpdate
+    uint16_t getMaxSysExPacketsPerUpdate() const {
+        return maxSysExPacketsPerUpdate;
+    }
+
+  protected:
+    uint16_t maxSysExPacketsPerUpdate = USB_MIDI_BLOCK_SIZE;
+};
+
+/**
+ * @brief   Output queues for a USB MIDI interface that let Real-Time and
+ *          Channel messages overtake long System Exclusive messages.
+ *
+ * Without a scheduler, a USB MIDI interface writes a SysEx message to the USB
+ * backend in one go, and a Timing Clock message that is sent after it has to
+ * wait until the host has read the entire SysEx message. With a scheduler, the
+ * messages are first encoded into USB MIDI packets and added to queues:
+ *
+ *  - Real-Time messages (for all cables) go to a separate queue, and are
+ *    always sent first, even in the middle of a SysEx message on the same
+ *    cable (which the USB MIDI and MIDI 1.0 specifications allow).
+ *  - All other messages go to the queue of their cable, so their order within
+ *    a cable is preserved. Channel and System Common packets at the front of
+ *    a queue are sent immediately. SysEx packets are sent during the
+ *    interface's `update()`, at most
+ *    @ref getMaxSysExPacketsPerUpdate "getMaxSysExPacketsPerUpdate()" per
+ *    update, taking turns between the cables one packet at a time.
+ *
+ * Calling `sendNow()` on the interface sends all queued packets.
+ *
+ * ~~~cpp
+ * USBMIDI_Interface midi;
+ * USBMIDI_OutputScheduler<1, 64> scheduler;
+ *
+ * void setup() {
+ *     midi.setOutputScheduler(&scheduler);
+ *     Control_Surface.begin();
+ * }
+ * ~~~
+ *
+ * @tparam  NumCables
+ *          The number of cables that get their own queue. Messages for cable
+ *          index `c` use the queue `c % NumCables`.
+ * @tparam  QueueSize
+ *          The number of packets in the queue of each cable. A SysEx message
+ *          of @f$ n @f$ bytes needs @f$ \lceil n / 3 \rceil @f$ packets. When
+ *          a queue is full, the sender blocks until the queued packets have
+ *          been handed to the USB backend.
+ * @tparam  RealTimeQueueSize
+ *          The number of packets in the Real-Time queue.
+ *
+ * @ingroup MIDIInterfaces
+ */
+template <uint8_t NumCables, uint16_t QueueSize,
+          uint16_t RealTimeQueueSize = 8>
+class USBMIDI_OutputScheduler : public USBMIDI_PacketScheduler {
+    static_assert(NumCables >= 1 && NumCables <= 16,
+                  "NumCables must be between 1 and 16");
+    static_assert(QueueSize >= 1, "QueueSize must be at least 1");
+    static_assert(RealTimeQueueSize >= 1,
+                  "RealTimeQueueSize must be at least 1");
+
+  public:
+    bool push(MIDIUSBPacket_t packet, USBMIDIPacketClass cls) override {
+        if (cls == USBMIDIPacketClass::RealTime)
+            return realtime.push({packet, cls});
+        return cables[(packet[0] >> 4) % NumCables].push({packet, cls});
+    }
+
+    bool pop(MIDIUSBPacket_t &packet, uint16_t &sysexBudget) override {
+        Element element;
+        if (realtime.pop(element)) {
+            packet = element.packet;
+            return true;
+        }
+        // Channel and System Common messages go before SysEx data
+        for (auto &queue : cables) {
+            if (queue.size > 0 &&
+                queue.front().cls != USBMIDIPacketClass::SysEx) {
+                queue.pop(element);
+                packet = element.packet;
+                return true;
+            }
+        }
+        if (sysexBudget == 0)
+            return false;
+        // Take turns between the cables with pending SysEx data
+        for (uint8_t i = 0; i < NumCables; ++i) {
+            auto &queue = cables[nextCable];
+            nextCable = (nextCable + 1) % NumCables;
+            if (queue.pop(element)) {
+                packet = element.packet;
+                --sysexBudget;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool empty() const override {
+        for (auto &queue : cables)
+            if (queue.size > 0)
+                return false;
+        return realtime.size == 0;
+    }
+
+    /// Get the number of packets in the queue of the given cable.
+    uint16_t getQueueSize(Cable cable) const {
+        return cables[cable.getRaw() % NumCables].size;
+    }
+    /// Get the number of packets in the Real-Time queue.
+    uint16_t getRealTimeQueueSize() const { return realtime.size; }
+
+  private:
+    struct Element {
+        MIDIUSBPacket_t packet;
+        USBMIDIPacketClass cls;
+    };
+    /// Bounded FIFO of packets.
+    template <uint16_t Capacity>
+    struct Queue {
+        Element elements[Capacity];
+        uint16_t head = 0;
+        uint16_t size = 0;
+
+        bool push(Element element) {
+            if (size == Capacity)
+                return false;
+            elements[(head + size) % Capacity] = element;
+            ++size;
+            return true;
+        }
+        bool pop(Element &element) {
+            if (size == 0)
+                return false;
+            element = elements[head];
+            head = (head + 1) % Capacity;
+            --size;
+            return true;
+        }
+        const Element &front() const { return elements[head]; }
+    };
+
+    Queue<RealTimeQueueSize> realtime;
+    Queue<QueueSize> cables[NumCables];
+    uint8_t nextCable = 0;
+};
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
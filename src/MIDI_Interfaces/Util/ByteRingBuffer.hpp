@@ -0,0 +1,172 @@
+#pragma once
+
+#include <AH/STL/algorithm> // std::min
+#include <AH/STL/cstdint>
+#include <Settings/NamespaceSettings.hpp>
+
+#ifdef __AVR__
+#include <util/atomic.h>
+#else
+#include <atomic>
+#endif
+#include <string.h> // memcpy
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   Lock-free single-producer, single-consumer ring buffer of bytes,
+ *          e.g. to pass the bytes received by a UART interrupt handler or DMA
+ *          transfer to the main loop.
+ *
+ * The producer either adds bytes one by one or as a block using @ref push,
+ * or it writes directly into the ring memory: @ref getWriteSpan returns the
+ * largest contiguous free region, and @ref commit makes the bytes that were
+ * written to it visible to the consumer. This is useful for DMA engines that
+ * can only write to contiguous memory.
+ *
+ * The consumer can do the same using @ref getReadSpan and @ref release, which
+ * allows parsing the data in place without copying it, or it can copy it out
+ * using @ref pop.
+ *
+ * The two indices are only ever written by one side each. On AVR, they are
+ * read and written with interrupts disabled, because 16-bit accesses are not
+ * atomic, on other architectures, `std::atomic` is used.
+ *
+ * @tparam  Capacity
+ *          The size of the ring in bytes. Must be a power of two, at most
+ *          32768.
+ */
+template <uint16_t Capacity>
+class ByteRingBuffer {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(Capacity <= 0x8000, "Capacity must be at most 32768");
+
+  public:
+    /// @name   Producer
+    /// @{
+
+    /// Add a single byte to the ring.
+    /// @return False if the ring is full, true otherwise.
+    bool push(uint8_t byte) {
+        uint16_t write = writeIndex.load();
+        if (uint16_t(write - readIndex.load()) == Capacity)
+            return false;
+        buffer[write % Capacity] = byte;
+        writeIndex.store(write + 1);
+        return true;
+    }
+    /// Add as many of the given bytes to the ring as there is space for.
+    /// @return The number of bytes that were added.
+    uint16_t push(const uint8_t *data, uint16_t length) {
+        uint16_t total = 0;
+        while (total < length) {
+            uint8_t *span;
+            uint16_t n = std::min(getWriteSpan(span), uint16_t(length - total));
+            if (n == 0)
+                break;
+            memcpy(span, data + total, n);
+            commit(n);
+            total += n;
+        }
+        return total;
+    }
+    /// Get a pointer to the largest contiguous region of free space in the
+    /// ring.
+    /// @param[out] span
+    ///             The start of the free region.
+    /// @return The size of the free region.
+    uint16_t getWriteSpan(uint8_t *&span) {
+        uint16_t write = writeIndex.load();
+        uint16_t free = Capacity - uint16_t(write - readIndex.load());
+        uint16_t offset = write % Capacity;
+        span = buffer + offset;
+        return std::min(free, uint16_t(Capacity - offset));
+    }
+    /// Make the given number of bytes, written to the region returned by
+    /// @ref getWriteSpan, available to the consumer.
+    void commit(uint16_t length) { writeIndex.store(writeIndex.load() + length); }
+
+    /// @}
+
+  public:
+    /// @name   Consumer
+    /// @{
+
+    /// Remove a single byte from the ring.
+    /// @return False if the ring is empty, true otherwise.
+    bool pop(uint8_t &byte) {
+        uint16_t read = readIndex.load();
+        if (read == writeIndex.load())
+            return false;
+        byte = buffer[read % Capacity];
+        readIndex.store(read + 1);
+        return true;
+    }
+    /// Remove at most the given number of bytes from the ring.
+    /// @return The number of bytes that were copied to @p data.
+    uint16_t pop(uint8_t *data, uint16_t length) {
+        uint16_t total = 0;
+        while (total < length) {
+            const uint8_t *span;
+            uint16_t n = std::min(getReadSpan(span), uint16_t(length - total));
+            if (n == 0)
+                break;
+            memcpy(data + total, span, n);
+            release(n);
+            total += n;
+        }
+        return total;
+    }
+    /// Get a pointer to the largest contiguous region of data in the ring.
+    /// @param[out] span
+    ///             The start of the data.
+    /// @return The number of bytes in the region.
+    uint16_t getReadSpan(const uint8_t *&span) {
+        uint16_t read = readIndex.load();
+        uint16_t used = writeIndex.load() - read;
+        uint16_t offset = read % Capacity;
+        span = buffer + offset;
+        return std::min(used, uint16_t(Capacity - offset));
+    }
+    /// Remove the given number of bytes, returned by @ref getReadSpan, from
+    /// the ring, so the producer can reuse their space.
+    void release(uint16_t length) { readIndex.store(readIndex.load() + length); }
+
+    /// Get the number of bytes that can be read from the ring.
+    uint16_t available() const { return writeIndex.load() - readIndex.load(); }
+
+    /// @}
+
+    /// Get the size of the ring in bytes.
+    static constexpr uint16_t capacity() { return Capacity; }
+
+  private:
+#ifdef __AVR__
+    struct Index {
+        volatile uint16_t value = 0;
+        uint16_t load() const {
+            uint16_t copy;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { copy = value; }
+            return copy;
+        }
+        void store(uint16_t other) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { value = other; }
+        }
+    };
+#else
+    struct Index {
+        std::atomic<uint16_t> value {0};
+        uint16_t load() const { return value.load(std::memory_order_acquire); }
+        void store(uint16_t other) {
+            value.store(other, std::memory_order_release);
+        }
+    };
+#endif
+
+    Index writeIndex; ///< Written by the producer.
+    Index readIndex;  ///< Written by the consumer.
+    uint8_t buffer[Capacity];
+};
+
+END_CS_NAMESPACE
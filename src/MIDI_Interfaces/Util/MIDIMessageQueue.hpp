@@ -0,0 +1,203 @@
+#pragma once
+
+#include <AH/Debug/Debug.hpp>
+#include <MIDI_Parsers/MIDIReadEvent.hpp>
+#include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+
+#include <atomic>
+#include <string.h> // memcpy
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   Lock-free single-producer, single-consumer queue for incoming MIDI
+ *          messages, e.g. to pass messages from a BLE or USB host callback or
+ *          an ISR to the main loop.
+ *
+ * All storage is allocated inline: a ring of @p Capacity messages, and a ring
+ * of @p ArenaSize bytes for the data of SysEx messages, which is copied when
+ * the message is pushed. The producer and consumer indices live on separate
+ * cache lines, and each side keeps a cached copy of the other side's index, so
+ * the two threads only touch each other's cache line when the queue appears
+ * to be full or empty.
+ *
+ * The SysEx data of a message returned by @ref pop remains valid until the
+ * next call to @ref pop.
+ *
+ * @tparam  Capacity
+ *          The maximum number of messages in the queue. Must be a power of
+ *          two.
+ * @tparam  ArenaSize
+ *          The number of bytes available for SysEx data. Must be a power of
+ *          two. SysEx messages or chunks that are longer than half of the
+ *          arena are dropped.
+ */
+template <uint16_t Capacity, uint16_t ArenaSize>
+class MIDIMessageQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(ArenaSize > 0 && (ArenaSize & (ArenaSize - 1)) == 0,
+                  "ArenaSize must be a power of two");
+
+  public:
+    struct MIDIMessageQueueElement {
+        MIDIReadEvent eventType = MIDIReadEvent::NO_MESSAGE;
+        union Message {
+            ChannelMessage channelmessage;
+            SysCommonMessage syscommonmessage;
+            RealTimeMessage realtimemessage;
+            SysExMessage sysexmessage;
+
+            Message() : realtimemessage(0x00) {}
+            Message(ChannelMessage msg) : channelmessage(msg) {}
+            Message(SysCommonMessage msg) : syscommonmessage(msg) {}
+            Message(RealTimeMessage msg) : realtimemessage(msg) {}
+            Message(SysExMessage msg) : sysexmessage(msg) {}
+        } message;
+        uint16_t timestamp = 0xFFFF;
+
+        MIDIMessageQueueElement() = default;
+        MIDIMessageQueueElement(ChannelMessage message, uint16_t timestamp)
+            : eventType(MIDIReadEvent::CHANNEL_MESSAGE), message(message),
+              timestamp(timestamp) {}
+        MIDIMessageQueueElement(SysCommonMessage message, uint16_t timestamp)
+            : eventType(MIDIReadEvent::SYSCOMMON_MESSAGE), message(message),
+              timestamp(timestamp) {}
+        MIDIMessageQueueElement(RealTimeMessage message, uint16_t timestamp)
+            : eventType(MIDIReadEvent::REALTIME_MESSAGE), message(message),
+              timestamp(timestamp) {}
+        MIDIMessageQueueElement(SysExMessage message, uint16_t timestamp)
+            : eventType(message.isLastChunk() ? MIDIReadEvent::SYSEX_MESSAGE
+                                              : MIDIReadEvent::SYSEX_CHUNK),
+              message(message), timestamp(timestamp) {}
+    };
+
+  public:
+    /// @name   Producer
+    /// @{
+
+    /// Add a message to the queue.
+    /// @return False if the queue is full, true otherwise.
+    bool push(ChannelMessage message, uint16_t timestamp) {
+        return push({message, timestamp}, arenaWrite);
+    }
+    /// @copydoc push(ChannelMessage, uint16_t)
+    bool push(SysCommonMessage message, uint16_t timestamp) {
+        return push({message, timestamp}, arenaWrite);
+    }
+    /// @copydoc push(ChannelMessage, uint16_t)
+    bool push(RealTimeMessage message, uint16_t timestamp) {
+        return push({message, timestamp}, arenaWrite);
+    }
+    /// Add a SysEx message or chunk to the queue, copying its data to the
+    /// arena.
+    /// @return False if the queue or the arena is full, true otherwise.
+    bool push(SysExMessage message, uint16_t timestamp);
+
+    /// @}
+
+  public:
+    /// @name   Consumer
+    /// @{
+
+    /// Remove the oldest message from the queue. Releases the SysEx data of
+    /// the previously popped message.
+    /// @return False if the queue is empty, true otherwise.
+    bool pop(MIDIMessageQueueElement &message);
+
+    /// @}
+
+    /// Get the maximum number of messages in the queue.
+    static constexpr uint16_t capacity() { return Capacity; }
+
+  private:
+    struct Slot {
+        MIDIMessageQueueElement element;
+        /// Position in the arena after the SysEx data of this element.
+        uint32_t arenaEnd;
+    };
+
+    bool hasFreeSlot(uint32_t write) {
+        if (write - cachedReadIndex < Capacity)
+            return true;
+        cachedReadIndex = readIndex.load(std::memory_order_acquire);
+        return write - cachedReadIndex < Capacity;
+    }
+    bool hasArenaSpace(uint32_t amount) {
+        if (ArenaSize - (arenaWrite - cachedArenaRead) >= amount)
+            return true;
+        cachedArenaRead = arenaRead.load(std::memory_order_acquire);
+        return ArenaSize - (arenaWrite - cachedArenaRead) >= amount;
+    }
+    bool push(const MIDIMessageQueueElement &element, uint32_t arenaEnd) {
+        uint32_t write = writeIndex.load(std::memory_order_relaxed);
+        if (!hasFreeSlot(write))
+            return false;
+        slots[write % Capacity] = {element, arenaEnd};
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    constexpr static size_t CacheLineSize = 64;
+
+    // Written by the producer
+    alignas(CacheLineSize) std::atomic<uint32_t> writeIndex{0};
+    uint32_t arenaWrite = 0;
+    uint32_t cachedReadIndex = 0;
+    uint32_t cachedArenaRead = 0;
+
+    // Written by the consumer
+    alignas(CacheLineSize) std::atomic<uint32_t> readIndex{0};
+    std::atomic<uint32_t> arenaRead{0};
+    uint32_t cachedWriteIndex = 0;
+    uint32_t pendingArenaRead = 0;
+
+    // Storage
+    alignas(CacheLineSize) Slot slots[Capacity];
+    uint8_t arena[ArenaSize];
+};
+
+template <uint16_t Capacity, uint16_t ArenaSize>
+bool MIDIMessageQueue<Capacity, ArenaSize>::push(SysExMessage message,
+                                                 uint16_t timestamp) {
+    const uint32_t length = message.length;
+    if (length > ArenaSize / 2) {
+        DEBUGREF(F("SysEx message too large for queue, dropped"));
+        return true;
+    }
+    if (!hasFreeSlot(writeIndex.load(std::memory_order_relaxed)))
+        return false;
+    // The data is stored contiguously, so if it doesn't fit before the end of
+    // the arena, skip the remaining bytes and start at the beginning.
+    const uint32_t offset = arenaWrite % ArenaSize;
+    const uint32_t padding = offset + length > ArenaSize ? ArenaSize - offset : 0;
+    if (!hasArenaSpace(padding + length))
+        return false;
+    arenaWrite += padding;
+    uint8_t *data = arena + arenaWrite % ArenaSize;
+    memcpy(data, message.data, length);
+    arenaWrite += length;
+    message.data = data;
+    return push({message, timestamp}, arenaWrite);
+}
+
+template <uint16_t Capacity, uint16_t ArenaSize>
+bool MIDIMessageQueue<Capacity, ArenaSize>::pop(
+    MIDIMessageQueueElement &message) {
+    // The consumer is done with the data of the previous message
+    arenaRead.store(pendingArenaRead, std::memory_order_release);
+    uint32_t read = readIndex.load(std::memory_order_relaxed);
+    if (read == cachedWriteIndex) {
+        cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+        if (read == cachedWriteIndex)
+            return false;
+    }
+    const Slot &slot = slots[read % Capacity];
+    message = slot.element;
+    pendingArenaRead = slot.arenaEnd;
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+}
+
+END_CS_NAMESPACE
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <AH/Hardware/FilteredAnalogBank.hpp>
+#include <Def/Def.hpp>
+#include <MIDI_Outputs/Abstract/MIDIOutputElement.hpp>
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   A class for collections of potentiometers and faders that send MIDI
+ *          events.
+ *
+ * All analog inputs are filtered in a single pass by an
+ * @ref AH::FilteredAnalogBank, and only the inputs that changed are sent.
+ *
+ * @see     AH::FilteredAnalogBank
+ */
+template <class Sender, uint8_t NumInputs>
+class MIDIFilteredAnalogBank : public MIDIOutputElement {
+  protected:
+    /**
+     * @brief   Construct a new MIDIFilteredAnalogBank.
+     *
+     * @param   analogPins
+     *          The analog input pins with the wipers of the potentiometers
+     *          connected.
+     * @param   baseAddress
+     *          The MIDI address of the first input.
+     * @param   incrementAddress
+     *          The number of addresses to increment for each next input.
+     * @param   sender
+     *          The MIDI sender to use.
+     */
+    MIDIFilteredAnalogBank(const Array<pin_t, NumInputs> &analogPins,
+                           MIDIAddress baseAddress,
+                           RelativeMIDIAddress incrementAddress,
+                           const Sender &sender)
+        : filteredAnalogs(analogPins), baseAddress(baseAddress),
+          incrementAddress(incrementAddress), sender(sender) {}
+
+  public:
+    void begin() final override { filteredAnalogs.resetToCurrentValue(); }
+
+    void update() final override {
+        if (!filteredAnalogs.update())
+            return;
+        MIDIAddress address = baseAddress;
+        for (uint8_t i = 0; i < NumInputs; ++i) {
+            if (filteredAnalogs.hasChanged(i))
+                sender.send(filteredAnalogs.getValue(i), address);
+            address += incrementAddress;
+        }
+    }
+
+    /// Send the value of the given analog input over MIDI, even if the value
+    /// didn't change.
+    void forcedUpdate(uint8_t index) {
+        sender.send(filteredAnalogs.getValue(index), getAddress(index));
+    }
+
+    /// Send the values of all analog inputs over MIDI.
+    void forcedUpdate() {
+        MIDIAddress address = baseAddress;
+        for (uint8_t i = 0; i < NumInputs; ++i) {
+            sender.send(filteredAnalogs.getValue(i), address);
+            address += incrementAddress;
+        }
+    }
+
+    /// @copydoc AH::FilteredAnalogBank::map
+    void map(uint8_t index, MappingFunction fn) {
+        filteredAnalogs.map(index, fn);
+    }
+
+    /// Invert the analog value of the given input.
+    void invert(uint8_t index) { filteredAnalogs.invert(index); }
+
+    /**
+     * @brief   Get the raw value of the given analog input (this is the value
+     *          without applying the filter or the mapping function first).
+     */
+    analog_t getRawValue(uint8_t index) const {
+        return filteredAnalogs.getRawValue(index);
+    }
+
+    /**
+     * @brief   Get the value of the given analog input (this is the value
+     *          after first applying the mapping function).
+     */
+    analog_t getValue(uint8_t index) const {
+        return filteredAnalogs.getValue(index);
+    }
+
+    /// Get the MIDI address of the given input.
+    MIDIAddress getAddress(uint8_t index) const {
+        MIDIAddress address = baseAddress;
+        for (uint8_t i = 0; i < index; ++i)
+            address += incrementAddress;
+        return address;
+    }
+    /// Get the MIDI base address.
+    MIDIAddress getBaseAddress() const { return this->baseAddress; }
+    /// Set the MIDI base address.
+    void setBaseAddress(MIDIAddress address) { this->baseAddress = address; }
+    /// Get the MIDI increment address.
+    RelativeMIDIAddress getIncrementAddress() const {
+        return this->incrementAddress;
+    }
+
+  private:
+    AH::FilteredAnalogBank<NumInputs, Sender::precision()> filteredAnalogs;
+    MIDIAddress baseAddress;
+    const RelativeMIDIAddress incrementAddress;
+
+  public:
+    Sender sender;
+};
+
+END_CS_NAMESPACE
@@ -1,3 +1,3 @@
-#ifdef TEST_COMPILE_ALL_HEADERS_SEPARATELY
+#if defined(TEST_COMPILE_ALL_HEADERS_SEPARATELY) && defined(ARDUINO_ARCH_SAMD)
 #include "MIDIQTouchButton.hpp"
 #endif
\ No newline at end of file
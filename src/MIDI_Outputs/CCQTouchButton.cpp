@@ -1,4 +1,4 @@
-#ifdef TEST_COMPILE_ALL_HEADERS_SEPARATELY
+#if defined(TEST_COMPILE_ALL_HEADERS_SEPARATELY) && defined(ARDUINO_ARCH_SAMD)
 #include "CCQTouchButton.hpp"
 
 // calibrate function
@@ -5,6 +5,7 @@
 #include <AH/STL/vector>
 #include <AH/Settings/Warnings.hpp>
 #include <Settings/NamespaceSettings.hpp>
+#include <Settings/SettingsWrapper.hpp>
 
 #ifndef ARDUINO
 #include <iostream>
@@ -82,7 +83,42 @@ enum class MIDICodeIndexNumber : uint8_t {
 
 // -------------------------------------------------------------------------- //
 
-struct MIDIMessage {
+/**
+ * @brief   Base class of all MIDI message types that adds the time at which
+ *          the message was received, if @ref MIDI_TIMESTAMPS is enabled.
+ *
+ * The timestamp is captured by the MIDI interface that receives the message,
+ * in microseconds (see `micros()`), and it is carried through the MIDI pipes
+ * to the sinks and callbacks. A timestamp of zero means that the message
+ * wasn't timestamped (e.g. outgoing messages).
+ *
+ * If @ref MIDI_TIMESTAMPS is disabled, this class is empty, the setter does
+ * nothing, and the getter always returns zero.
+ */
+struct MIDITimestamp {
+#if MIDI_TIMESTAMPS
+    /// Get the time at which the message was received, in microseconds.
+    uint32_t getTimestamp() const { return timestamp; }
+    /// Set the time at which the message was received, in microseconds.
+    void setTimestamp(uint32_t timestamp) { this->timestamp = timestamp; }
+    /// Check whether the message has been timestamped.
+    bool hasTimestamp() const { return timestamp != 0; }
+
+  private:
+    uint32_t timestamp = 0;
+#else
+    /// Get the time at which the message was received, in microseconds.
+    static constexpr uint32_t getTimestamp() { return 0; }
+    /// Set the time at which the message was received, in microseconds.
+    void setTimestamp(uint32_t) {}
+    /// Check whether the message has been timestamped.
+    static constexpr bool hasTimestamp() { return false; }
+#endif
+};
+
+// -------------------------------------------------------------------------- //
+
+struct MIDIMessage : MIDITimestamp {
     /// Constructor.
     MIDIMessage(uint8_t header, uint8_t data1, uint8_t data2,
                 Cable cable = CABLE_1)
@@ -274,7 +310,7 @@ struct SysCommonMessage : MIDIMessage {
     constexpr static auto TUNE_REQUEST = MIDIMessageType::TUNE_REQUEST;
 };
 
-struct SysExMessage {
+struct SysExMessage : MIDITimestamp {
     /// Constructor.
     SysExMessage() : data(nullptr), length(0), cable(CABLE_1) {}
 
@@ -323,7 +359,7 @@ struct SysExMessage {
     constexpr static auto SYSEX_END = MIDIMessageType::SYSEX_END;
 };
 
-struct RealTimeMessage {
+struct RealTimeMessage : MIDITimestamp {
     /// Constructor.
     RealTimeMessage(uint8_t message, Cable cable = CABLE_1)
         : message(message), cable(cable.getRaw()) {}
@@ -28,6 +28,21 @@ class MIDI_Parser {
     SysExMessage getSysExMessage() const { return {nullptr, 0, CABLE_1}; }
 #endif
 
+    /// A single message decoded by the block parsing functions of the
+    /// parsers, e.g. @ref SerialMIDI_Parser::parseBlock.
+    struct BlockEvent {
+        BlockEvent() : event(MIDIReadEvent::NO_MESSAGE), message(0, 0, 0) {}
+        BlockEvent(MIDIReadEvent event, MIDIMessage message)
+            : event(event), message(message) {}
+
+        /// The type of MIDI message.
+        MIDIReadEvent event;
+        /// The channel voice or system common message. For real-time
+        /// messages, the header contains the real-time status byte. For SysEx
+        /// messages, use `getSysExMessage()`.
+        MIDIMessage message;
+    };
+
   protected:
     MIDIMessage midimsg = {0x00, 0x00, 0x00};
     RealTimeMessage rtmsg = {0x00};
@@ -32,45 +32,53 @@ MIDIReadEvent SerialMIDI_Parser::handleNonRealTimeStatus(uint8_t midiByte) {
         endSysEx();
         currentHeader = 0;
         runningHeader = 0;
-        return MIDIReadEvent::SYSEX_MESSAGE;
-    } else
+        if (!sysexbuffer.isTruncated())
+            return MIDIReadEvent::SYSEX_MESSAGE;
+        // The message was too long for the buffer, so it was only streamed
+        // to the SysEx sink. There's no message to return, so handle the new
+        // status byte right away.
+        if (midiByte == uint8_t(MIDIMessageType::SYSEX_END))
+            return MIDIReadEvent::NO_MESSAGE;
+        popStoredByte();
+    }
 #endif
-    {
-        // Tune Request is a special System Common message of 1 byte.
-        if (midiByte == uint8_t(MIDIMessageType::TUNE_REQUEST)) {
-            midimsg.header = midiByte;
-            midimsg.data1 = 0;
-            midimsg.data2 = 0;
-            if (sysCommonCancelsRunningStatus)
-                runningHeader = 0;
-            currentHeader = 0;
-            return MIDIReadEvent::SYSCOMMON_MESSAGE;
-        }
-#if !IGNORE_SYSEX
-        // If the new status byte is a SysExStart, reset the SysEx buffer
-        // and store the start byte.
-        else if (midiByte == uint8_t(MIDIMessageType::SYSEX_START)) {
-            startSysEx();
-            addSysExByte(uint8_t(MIDIMessageType::SYSEX_START));
+    // Tune Request is a special System Common message of 1 byte.
+    if (midiByte == uint8_t(MIDIMessageType::TUNE_REQUEST)) {
+        midimsg.header = midiByte;
+        midimsg.data1 = 0;
+        midimsg.data2 = 0;
+        if (sysCommonCancelsRunningStatus)
             runningHeader = 0;
-            currentHeader = midiByte;
-            return MIDIReadEvent::NO_MESSAGE;
-        }
-        // This should already have been handled by the if (untermSysEx) above.
-        else if (midiByte == uint8_t(MIDIMessageType::SYSEX_END)) {
-            DEBUGREF(F("Unexpected SysEx End"));
-            return MIDIReadEvent::NO_MESSAGE;
-        }
+        currentHeader = 0;
+        // It interrupts any incomplete message, so the next data byte
+        // is the first data byte of a (running status) message.
+        thirdByte = false;
+        return MIDIReadEvent::SYSCOMMON_MESSAGE;
+    }
+#if !IGNORE_SYSEX
+    // If the new status byte is a SysExStart, reset the SysEx buffer
+    // and store the start byte.
+    else if (midiByte == uint8_t(MIDIMessageType::SYSEX_START)) {
+        startSysEx();
+        addSysExByte(uint8_t(MIDIMessageType::SYSEX_START));
+        runningHeader = 0;
+        currentHeader = midiByte;
+        return MIDIReadEvent::NO_MESSAGE;
+    }
+    // This should already have been handled by the if (untermSysEx) above.
+    else if (midiByte == uint8_t(MIDIMessageType::SYSEX_END)) {
+        DEBUGREF(F("Unexpected SysEx End"));
+        return MIDIReadEvent::NO_MESSAGE;
+    }
 #endif
-        // Otherwise, start a System Common or Channel message.
-        else {
-            // Save the newly received status byte.
-            currentHeader = midiByte;
-            // A new message starts, so we haven't received the second byte
-            // yet.
-            thirdByte = false;
-            return MIDIReadEvent::NO_MESSAGE;
-        }
+    // Otherwise, start a System Common or Channel message.
+    else {
+        // Save the newly received status byte.
+        currentHeader = midiByte;
+        // A new message starts, so we haven't received the second byte
+        // yet.
+        thirdByte = false;
+        return MIDIReadEvent::NO_MESSAGE;
     }
 }
 
@@ -226,4 +234,76 @@ MIDIReadEvent SerialMIDI_Parser::resume() {
     return feed(midiByte);
 }
 
+SerialMIDI_Parser::BlockResult
+SerialMIDI_Parser::parseBlock(const uint8_t *data, size_t length,
+                              BlockEvent *events, size_t maxEvents) {
+    const uint8_t *const begin = data;
+    const uint8_t *const end = data + length;
+    size_t numEvents = 0;
+
+    // Adds the given event to the output, returns false if parsing should
+    // stop (output full or SysEx buffer has to be read first).
+    auto addEvent = [&](MIDIReadEvent evt) {
+        MIDIMessage msg = evt == MIDIReadEvent::REALTIME_MESSAGE
+                              ? MIDIMessage(rtmsg.message, 0, 0)
+                              : midimsg;
+        events[numEvents++] = {evt, msg};
+        return numEvents < maxEvents && evt != MIDIReadEvent::SYSEX_MESSAGE &&
+               evt != MIDIReadEvent::SYSEX_CHUNK;
+    };
+
+    if (maxEvents == 0)
+        return {0, 0};
+
+    // First try resuming the parser, we might have a stored byte that has to
+    // be parsed first.
+    MIDIReadEvent evt = resume();
+    if (evt != MIDIReadEvent::NO_MESSAGE && !addEvent(evt))
+        return {0, numEvents};
+
+    while (data != end) {
+        // Fast path: running status for channel messages, complete messages
+        // can be decoded directly, without updating the parser state.
+        if (currentHeader == 0 && runningHeader != 0) {
+            const uint8_t header = runningHeader;
+            const bool twoBytes =
+                ChannelMessage(MIDIMessage(header, 0, 0)).hasTwoDataBytes();
+            const size_t msgLen = twoBytes ? 2 : 1;
+            const size_t numEventsBefore = numEvents;
+            while (numEvents < maxEvents && size_t(end - data) >= msgLen &&
+                   isData(data[0]) && (!twoBytes || isData(data[1]))) {
+                events[numEvents++] = {
+                    MIDIReadEvent::CHANNEL_MESSAGE,
+                    {header, data[0], twoBytes ? data[1] : uint8_t(0)},
+                };
+                data += msgLen;
+            }
+            if (numEvents != numEventsBefore)
+                midimsg = events[numEvents - 1].message;
+            if (numEvents == maxEvents || data == end)
+                break;
+        }
+#if !IGNORE_SYSEX
+        // Fast path: SysEx data, hand a view of the input buffer to the sink.
+        if (sysexsink &&
+            currentHeader == uint8_t(MIDIMessageType::SYSEX_START)) {
+            const uint8_t *sysexEnd = data;
+            while (sysexEnd != end && isData(*sysexEnd) &&
+                   sysexEnd - data < 0xFFFF)
+                ++sysexEnd;
+            if (sysexEnd != data)
+                addSysExBytes(data, uint16_t(sysexEnd - data));
+            data = sysexEnd;
+            if (data == end)
+                break;
+        }
+#endif
+        // Slow path: status bytes, incomplete messages.
+        evt = feed(*data++);
+        if (evt != MIDIReadEvent::NO_MESSAGE && !addEvent(evt))
+            break;
+    }
+    return {size_t(data - begin), numEvents};
+}
+
 END_CS_NAMESPACE
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "MIDI_Parser.hpp"
 #include "SysExBuffer.hpp"
+#include "SysExSink.hpp"
 
 BEGIN_CS_NAMESPACE
 
@@ -26,6 +27,43 @@ class SerialMIDI_Parser : public MIDI_Parser {
     template <class BytePuller>
     MIDIReadEvent pull(BytePuller &&puller);
 
+    /// The result of @ref parseBlock.
+    struct BlockResult {
+        /// The number of input bytes that were consumed.
+        size_t bytesConsumed;
+        /// The number of events that were written to the output array.
+        size_t numEvents;
+    };
+
+    /**
+     * @brief   Parse a block of MIDI bytes, writing all complete messages to
+     *          the given array of events.
+     * 
+     * Long runs of channel messages using running status are decoded without
+     * going through the byte-per-byte state machine.
+     * 
+     * Parsing stops when all bytes have been consumed, when the output array
+     * is full, or after a SysEx message or chunk, because the SysEx buffer is
+     * reused for the next message. In that case, the SysEx event is always the
+     * last event in the array, and @ref getSysExMessage returns its data.
+     * Call this function again with the remaining bytes to continue parsing.
+     * A byte that is stored for later (e.g. because the SysEx buffer was full)
+     * is resumed at the beginning of the next call, so call this function
+     * until it returns no events, even if all bytes have been consumed.
+     * 
+     * @param   data
+     *          Pointer to the MIDI bytes to parse.
+     * @param   length
+     *          The number of bytes in @p data.
+     * @param   events
+     *          The array to write the decoded events to.
+     * @param   maxEvents
+     *          The capacity of @p events.
+     * @return  The number of bytes consumed and the number of events decoded.
+     */
+    BlockResult parseBlock(const uint8_t *data, size_t length,
+                           BlockEvent *events, size_t maxEvents);
+
   protected:
     /// Feed a new byte to the parser.
     MIDIReadEvent feed(uint8_t midibyte);
@@ -39,13 +77,40 @@ class SerialMIDI_Parser : public MIDI_Parser {
         return {sysexbuffer.getBuffer(), sysexbuffer.getLength()};
     }
 
+    /// Stream all incoming SysEx data to the given sink. Messages that fit in
+    /// the SysEx buffer are still returned as well, longer messages only go to
+    /// the sink. Pass `nullptr` to go back to buffering all messages.
+    /// @see @ref SysExSink
+    void setSysExSink(SysExSink *sink) { sysexsink = sink; }
+    /// Get the SysEx sink, or `nullptr` if SysEx messages are buffered.
+    SysExSink *getSysExSink() const { return sysexsink; }
+
   protected:
-    void addSysExByte(uint8_t data) { sysexbuffer.add(data); }
-    bool hasSysExSpace() const { return sysexbuffer.hasSpaceLeft(); }
-    void startSysEx() { sysexbuffer.start(); }
-    void endSysEx() { sysexbuffer.end(); }
+    void addSysExByte(uint8_t data) { addSysExBytes(&data, 1); }
+    void addSysExBytes(const uint8_t *data, uint16_t len) {
+        if (sysexsink) {
+            sysexsink->onSysExContinue({data, len});
+            sysexbuffer.addOrTruncate(data, len);
+        } else {
+            sysexbuffer.add(data, len);
+        }
+    }
+    bool hasSysExSpace() const {
+        return sysexsink || sysexbuffer.hasSpaceLeft();
+    }
+    void startSysEx() {
+        if (sysexsink)
+            sysexsink->onSysExBegin(CABLE_1);
+        sysexbuffer.start();
+    }
+    void endSysEx() {
+        if (sysexsink)
+            sysexsink->onSysExEnd(CABLE_1);
+        sysexbuffer.end();
+    }
 
     SysExBuffer sysexbuffer;
+    SysExSink *sysexsink = nullptr;
 #endif
 
   protected:
@@ -6,6 +6,7 @@ BEGIN_CS_NAMESPACE
 void SysExBuffer::start() {
     length = 0; // if the previous message wasn't finished, overwrite it
     receiving = true;
+    truncated = false;
 }
 
 void SysExBuffer::end() {
@@ -17,11 +18,22 @@ void SysExBuffer::add(uint8_t data) {
     ++length;
 }
 
-void SysExBuffer::add(const uint8_t *data, uint8_t len) {
+void SysExBuffer::add(const uint8_t *data, uint16_t len) {
     memcpy(buffer + length, data, len);
     length += len;
 }
 
+void SysExBuffer::addOrTruncate(const uint8_t *data, uint16_t len) {
+    if (truncated || len > SYSEX_BUFFER_SIZE - length) {
+        truncated = true;
+        return;
+    }
+    memcpy(buffer + length, data, len);
+    length += len;
+}
+
+bool SysExBuffer::isTruncated() const { return truncated; }
+
 bool SysExBuffer::hasSpaceLeft(uint8_t amount) const {
     bool avail = length <= SYSEX_BUFFER_SIZE - amount;
     if (!avail)
@@ -15,6 +15,7 @@ class SysExBuffer {
     uint8_t buffer[SYSEX_BUFFER_SIZE];
     uint16_t length = 0;
     bool receiving = false;
+    bool truncated = false;
 
   public:
     /// Start a new SysEx message.
@@ -24,7 +25,13 @@ class SysExBuffer {
     /// Add a byte to the current SysEx message.
     void add(uint8_t data);
     /// Add multiple bytes to the current SysEx message.
-    void add(const uint8_t *data, uint8_t len);
+    void add(const uint8_t *data, uint16_t len);
+    /// Add multiple bytes to the current SysEx message if they fit, otherwise
+    /// stop storing the message and mark it as truncated.
+    void addOrTruncate(const uint8_t *data, uint16_t len);
+    /// Check if the current SysEx message was too long to fit in the buffer.
+    /// Only used when streaming SysEx messages to a @ref SysExSink.
+    bool isTruncated() const;
     /// Check if the buffer has at least `amount` bytes of free space available.
     bool hasSpaceLeft(uint8_t amount = 1) const;
     /// Check if the buffer is receiving a SysEx message.
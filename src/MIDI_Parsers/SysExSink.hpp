@@ -0,0 +1,42 @@
+#pragma once
+
+#include "MIDI_MessageTypes.hpp"
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   Interface for receiving System Exclusive messages as a stream of
+ *          chunks, without copying them into a @ref SysExBuffer first.
+ *
+ * When a sink is registered with a parser (see e.g. 
+ * @ref SerialMIDI_Parser::setSysExSink), the parser hands out views into its
+ * own receive buffers as soon as the data arrives, and it no longer returns
+ * `SYSEX_CHUNK` events. Messages that fit in the SysEx buffer are still
+ * returned as `SYSEX_MESSAGE` as well, so they are routed through the pipes
+ * and the MIDI callbacks as usual (e.g. for the Mackie Control LCD).
+ * Longer messages are only passed to the sink, so messages of arbitrary length
+ * can be received without stalling the MIDI pipes.
+ *
+ * For each message, @ref onSysExBegin is called once, followed by any number
+ * of calls to @ref onSysExContinue, and finally a call to @ref onSysExEnd.
+ * The data passed to @ref onSysExContinue includes the SysEx Start and End
+ * bytes, so the concatenation of all chunks is the complete message.
+ * If a message on the same cable is aborted by the start of a new one,
+ * @ref onSysExBegin is called again without a call to @ref onSysExEnd.
+ *
+ * @ingroup MIDIParsers
+ */
+class SysExSink {
+  public:
+    /// Called when a new SysEx message starts on the given cable.
+    virtual void onSysExBegin(Cable cable) = 0;
+    /// Called with the next part of the SysEx message. The data is only valid
+    /// for the duration of the call.
+    virtual void onSysExContinue(SysExMessage chunk) = 0;
+    /// Called after the last part of the SysEx message on the given cable.
+    virtual void onSysExEnd(Cable cable) = 0;
+
+    virtual ~SysExSink() = default;
+};
+
+END_CS_NAMESPACE
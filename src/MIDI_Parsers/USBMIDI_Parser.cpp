@@ -71,7 +71,7 @@ MIDIReadEvent USBMIDI_Parser::handleSysExEnd(MIDIUSBPacket_t packet,
     // Enough space available in buffer, finish the message
     addSysExBytes(cable, &packet[1], NumBytes);
     endSysEx(cable);
-    return MIDIReadEvent::SYSEX_MESSAGE;
+    return finishedSysExEvent(cable);
 #else
     (void)packet;
     (void)cable;
@@ -109,7 +109,7 @@ MIDIReadEvent USBMIDI_Parser::handleSysExEnd<1>(MIDIUSBPacket_t packet,
         // Enough space available in buffer, finish the message
         addSysExByte(cable, packet[1]);
         endSysEx(cable);
-        return MIDIReadEvent::SYSEX_MESSAGE;
+        return finishedSysExEvent(cable);
     }
 #else
     (void)packet;
@@ -191,4 +191,62 @@ MIDIReadEvent USBMIDI_Parser::resume() {
 #endif
 }
 
+USBMIDI_Parser::BlockResult
+USBMIDI_Parser::parseBlock(const MIDIUSBPacket_t *packets, size_t count,
+                           BlockEvent *events, size_t maxEvents) {
+    const MIDIUSBPacket_t *const begin = packets;
+    const MIDIUSBPacket_t *const end = packets + count;
+    size_t numEvents = 0;
+
+    // Adds the given event to the output, returns false if parsing should
+    // stop (output full or SysEx buffer has to be read first).
+    auto addEvent = [&](MIDIReadEvent evt) {
+        MIDIMessage msg = evt == MIDIReadEvent::REALTIME_MESSAGE
+                              ? MIDIMessage(rtmsg.message, 0, 0, rtmsg.cable)
+                              : midimsg;
+        events[numEvents++] = {evt, msg};
+        return numEvents < maxEvents && evt != MIDIReadEvent::SYSEX_MESSAGE &&
+               evt != MIDIReadEvent::SYSEX_CHUNK;
+    };
+
+    if (maxEvents == 0)
+        return {0, 0};
+
+    // First try resuming the parser, we might have a stored packet that has to
+    // be parsed first.
+    MIDIReadEvent evt = resume();
+    if (evt != MIDIReadEvent::NO_MESSAGE && !addEvent(evt))
+        return {0, numEvents};
+
+    while (packets != end) {
+        const MIDIUSBPacket_t &packet = *packets++;
+        const uint8_t cin = packet[0] & 0xF;
+        const Cable cable = Cable(packet[0] >> 4);
+        const bool validCable = cable.getRaw() < USB_MIDI_NUMBER_OF_CABLES;
+        // Fast path: channel voice messages (CIN 0x8-0xE) and single bytes
+        // (CIN 0xF) carry a complete message, so they can be decoded directly,
+        // without going through the switch in feed().
+        if (cin >= uint8_t(MIDICodeIndexNumber::NOTE_OFF) && validCable) {
+            MIDIMessage msg {packet[1], packet[2], packet[3], cable};
+            if (cin == uint8_t(MIDICodeIndexNumber::SINGLE_BYTE)) {
+                rtmsg.message = packet[1];
+                rtmsg.cable = cable;
+                msg.data1 = msg.data2 = 0;
+                events[numEvents++] = {MIDIReadEvent::REALTIME_MESSAGE, msg};
+            } else {
+                midimsg = msg;
+                events[numEvents++] = {MIDIReadEvent::CHANNEL_MESSAGE, msg};
+            }
+            if (numEvents == maxEvents)
+                break;
+            continue;
+        }
+        // Slow path: SysEx, System Common, reserved CINs.
+        evt = feed(packet);
+        if (evt != MIDIReadEvent::NO_MESSAGE && !addEvent(evt))
+            break;
+    }
+    return {size_t(packets - begin), numEvents};
+}
+
 END_CS_NAMESPACE
\ No newline at end of file
@@ -1,5 +1,8 @@
+#pragma once
+
 #include "MIDI_Parser.hpp"
 #include "SysExBuffer.hpp"
+#include "SysExSink.hpp"
 #include <AH/Containers/Array.hpp>
 
 #ifdef MIDI_NUM_CABLES
@@ -38,6 +41,45 @@ class USBMIDI_Parser : public MIDI_Parser {
     template <class BytePuller>
     MIDIReadEvent pull(BytePuller &&puller);
 
+    /// The result of @ref parseBlock.
+    struct BlockResult {
+        /// The number of input packets that were consumed.
+        size_t packetsConsumed;
+        /// The number of events that were written to the output array.
+        size_t numEvents;
+    };
+
+    /**
+     * @brief   Parse a block of MIDI USB packets, writing all complete messages
+     *          to the given array of events.
+     * 
+     * This is meant for backends that receive entire USB endpoint buffers at
+     * once: channel voice and real-time packets are decoded directly, without
+     * pulling them one by one.
+     * 
+     * Parsing stops when all packets have been consumed, when the output array
+     * is full, or after a SysEx message or chunk, because the SysEx buffer is
+     * reused for the next message. In that case, the SysEx event is always the
+     * last event in the array, and @ref getSysExMessage returns its data.
+     * Call this function again with the remaining packets to continue parsing.
+     * A packet that is stored for later (because the SysEx buffer was full) is
+     * resumed at the beginning of the next call, so call this function until
+     * it returns no events, even if all packets have been consumed.
+     * 
+     * @param   packets
+     *          Pointer to the MIDI USB packets to parse.
+     * @param   count
+     *          The number of packets in @p packets.
+     * @param   events
+     *          The array to write the decoded events to.
+     * @param   maxEvents
+     *          The capacity of @p events.
+     * @return  The number of packets consumed and the number of events
+     *          decoded.
+     */
+    BlockResult parseBlock(const MIDIUSBPacket_t *packets, size_t count,
+                           BlockEvent *events, size_t maxEvents);
+
   protected:
     /// Feed a new packet to the parser.
     MIDIReadEvent feed(MIDIUSBPacket_t packet);
@@ -54,6 +96,14 @@ class USBMIDI_Parser : public MIDI_Parser {
             activeCable,
         };
     }
+
+    /// Stream all incoming SysEx data to the given sink. Messages that fit in
+    /// the SysEx buffer are still returned as well, longer messages only go to
+    /// the sink. Pass `nullptr` to go back to buffering all messages.
+    /// @see @ref SysExSink
+    void setSysExSink(SysExSink *sink) { sysexsink = sink; }
+    /// Get the SysEx sink, or `nullptr` if SysEx messages are buffered.
+    SysExSink *getSysExSink() const { return sysexsink; }
 #endif
 
   protected:
@@ -66,24 +116,42 @@ class USBMIDI_Parser : public MIDI_Parser {
 
   protected:
 #if !IGNORE_SYSEX
-    void startSysEx(Cable cable) { sysexbuffers[cable.getRaw()].start(); }
+    void startSysEx(Cable cable) {
+        sysexbuffers[cable.getRaw()].start();
+        if (sysexsink)
+            sysexsink->onSysExBegin(cable);
+    }
     void endSysEx(Cable cable) {
         sysexbuffers[cable.getRaw()].end();
         activeCable = cable;
+        if (sysexsink)
+            sysexsink->onSysExEnd(cable);
     }
     void endSysExChunk(Cable cable) { activeCable = cable; }
     bool hasSysExSpace(Cable cable, uint8_t amount) const {
-        return sysexbuffers[cable.getRaw()].hasSpaceLeft(amount);
+        return sysexsink || sysexbuffers[cable.getRaw()].hasSpaceLeft(amount);
     }
     void addSysExByte(Cable cable, uint8_t data) {
-        sysexbuffers[cable.getRaw()].add(data);
+        addSysExBytes(cable, &data, 1);
     }
     void addSysExBytes(Cable cable, const uint8_t *data, uint8_t len) {
-        sysexbuffers[cable.getRaw()].add(data, len);
+        if (sysexsink) {
+            sysexsink->onSysExContinue({data, len, cable});
+            sysexbuffers[cable.getRaw()].addOrTruncate(data, len);
+        } else {
+            sysexbuffers[cable.getRaw()].add(data, len);
+        }
     }
     bool receivingSysEx(Cable cable) const {
         return sysexbuffers[cable.getRaw()].isReceiving();
     }
+    /// Messages that were too long for the buffer were only streamed to the
+    /// SysEx sink, so there's no message to return.
+    MIDIReadEvent finishedSysExEvent(Cable cable) const {
+        return sysexbuffers[cable.getRaw()].isTruncated()
+                   ? MIDIReadEvent::NO_MESSAGE
+                   : MIDIReadEvent::SYSEX_MESSAGE;
+    }
 
     void storePacket(MIDIUSBPacket_t packet) { storedPacket = packet; }
     bool hasStoredPacket() const { return storedPacket[0] != 0x00; }
@@ -97,6 +165,7 @@ class USBMIDI_Parser : public MIDI_Parser {
 
   private:
     SysExBuffer sysexbuffers[USB_MIDI_NUMBER_OF_CABLES] = {};
+    SysExSink *sysexsink = nullptr;
     MIDIUSBPacket_t storedPacket = {{ 0x00 }};
 #endif
 };
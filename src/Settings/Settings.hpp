@@ -47,6 +47,40 @@ constexpr uint8_t NOTE_VELOCITY_THRESHOLD = 1;
 /// The maximum length sent by the MCU protocol is 120 bytes.
 constexpr uint16_t SYSEX_BUFFER_SIZE = 128;
 
+/// Dispatch incoming MIDI channel messages to the MIDI input elements that
+/// listen for their address using a hash table, instead of checking all
+/// elements one by one. Uses some extra RAM, see @ref MIDI_INPUT_INDEX_SIZE.
+#define MIDI_INPUT_ELEMENT_INDEX 0
+
+/// The number of buckets of the MIDI input element index, for each type of
+/// MIDI input element. Must be a power of two.
+constexpr uint8_t MIDI_INPUT_INDEX_BUCKETS = 32;
+
+/// The maximum number of addresses that can be registered in the MIDI input
+/// element index, for each type of MIDI input element. Elements that don't fit
+/// are still updated, but using the slower linear search.
+constexpr uint16_t MIDI_INPUT_INDEX_SIZE = 128;
+
+/// Record the time at which incoming MIDI messages are received by the MIDI
+/// interfaces, and pass it along with the messages to the MIDI pipes, sinks and
+/// callbacks. Adds four bytes to each MIDI message, see @ref MIDITimestamp.
+#define MIDI_TIMESTAMPS 0
+
+/// The number of bytes that Stream MIDI interfaces read from the Stream and
+/// parse at once. The buffer is allocated on the stack during `update()`.
+constexpr uint8_t SERIAL_MIDI_BLOCK_SIZE = 16;
+
+/// The default size of the receive ring (in bytes) of
+/// @ref RingBufferedSerialMIDI_Interface. Must be a power of two.
+constexpr uint16_t SERIAL_MIDI_RX_RING_SIZE = 256;
+
+/// The maximum number of packets that USB MIDI interfaces read from backends
+/// that support bulk reads, and parse at once, and the number of packets they
+/// encode before handing them to backends that support bulk writes. The
+/// default of 16 packets is one full-speed USB bulk endpoint buffer (64 bytes).
+/// The buffers are allocated on the stack during `update()` and while sending.
+constexpr uint8_t USB_MIDI_BLOCK_SIZE = 16;
+
 /// Timeout in milliseconds to wait for a SysEx chunk to complete.
 constexpr unsigned long SYSEX_CHUNK_TIMEOUT = 500;
 
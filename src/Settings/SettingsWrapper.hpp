@@ -14,6 +14,16 @@
 #define MIDI_NUM_CABLES 16
 #endif
 
+// Allow the tests to build the library with optional features enabled
+#ifdef MIDI_INPUT_ELEMENT_INDEX_OVERRIDE
+#undef MIDI_INPUT_ELEMENT_INDEX
+#define MIDI_INPUT_ELEMENT_INDEX MIDI_INPUT_ELEMENT_INDEX_OVERRIDE
+#endif
+#ifdef MIDI_TIMESTAMPS_OVERRIDE
+#undef MIDI_TIMESTAMPS
+#define MIDI_TIMESTAMPS MIDI_TIMESTAMPS_OVERRIDE
+#endif
+
 #include <AH/Settings/SettingsWrapper.hpp>
 
 #endif // CS_SETTINGSWRAPPER_HPP
@@ -2,6 +2,7 @@
 
 #include <AH/Hardware/ExtendedInputOutput/ExtendedIOElement.hpp>
 #include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+#include <memory>
 #include <type_traits>
 
 using namespace ::testing;
@@ -734,4 +735,80 @@ TEST(ExtendedIOElement, updateAllBufferedOutputs) {
     EXPECT_CALL(el1, updateBufferedOutputs());
     EXPECT_CALL(el2, updateBufferedOutputs());
     ExtendedIOElement::updateAllBufferedOutputs();
-}
\ No newline at end of file
+}
+
+TEST(ExtendedInputOutput, pinIndexManyElements) {
+    // More elements than fit in the index, with different lengths
+    std::vector<std::unique_ptr<MinimalMockExtIOElement>> elements;
+    for (pin_t i = 0; i < EXTIO_PIN_INDEX_SIZE + 8; ++i)
+        elements.emplace_back(new MinimalMockExtIOElement(1 + i % 13));
+    for (auto &el : elements)
+        for (pin_t p = 0; p < el->getLength(); ++p)
+            ASSERT_EQ(getIOElementOfPinOrNull(el->pin(p)), el.get());
+    EXPECT_EQ(getIOElementOfPinOrNull(elements.back()->getEnd()), nullptr);
+    EXPECT_EQ(getIOElementOfPinOrNull(elements.front()->getStart() - 1),
+              nullptr);
+    // Removing an element invalidates the index
+    pin_t removed = elements[3]->getStart();
+    elements.erase(elements.begin() + 3);
+    EXPECT_EQ(getIOElementOfPinOrNull(removed), nullptr);
+    for (auto &el : elements)
+        for (pin_t p = 0; p < el->getLength(); ++p)
+            ASSERT_EQ(getIOElementOfPinOrNull(el->pin(p)), el.get());
+}
+
+TEST(ExtendedInputOutput, pinIndexDisabled) {
+    MinimalMockExtIOElement el_1 = {8};
+    MinimalMockExtIOElement el_2 = {8};
+    EXPECT_EQ(getIOElementOfPinOrNull(el_1.pin(3)), &el_1);
+    EXPECT_EQ(getIOElementOfPinOrNull(el_2.pin(3)), &el_2);
+    el_1.disable();
+    EXPECT_EQ(getIOElementOfPinOrNull(el_1.pin(3)), nullptr);
+    EXPECT_EQ(getIOElementOfPinOrNull(el_2.pin(3)), &el_2);
+    el_1.enable();
+    EXPECT_EQ(getIOElementOfPinOrNull(el_1.pin(3)), &el_1);
+    EXPECT_EQ(getIOElementOfPinOrNull(el_2.pin(3)), &el_2);
+}
+
+TEST(ExtendedInputOutput, digitalReadMany) {
+    MinimalMockExtIOElement el_1 = {4};
+    MinimalMockExtIOElement el_2 = {4};
+    InSequence seq;
+    EXPECT_CALL(el_1, updateBufferedInputs());
+    EXPECT_CALL(el_1, digitalReadBuffered(2)).WillOnce(Return(HIGH));
+    EXPECT_CALL(el_1, digitalReadBuffered(3)).WillOnce(Return(LOW));
+    EXPECT_CALL(el_2, updateBufferedInputs());
+    EXPECT_CALL(el_2, digitalReadBuffered(0)).WillOnce(Return(LOW));
+    EXPECT_CALL(el_2, digitalReadBuffered(1)).WillOnce(Return(HIGH));
+    EXPECT_CALL(el_2, digitalReadBuffered(2)).WillOnce(Return(HIGH));
+    PinStatus_t values[5];
+    digitalReadMany(el_1.pin(2), values, 5);
+    EXPECT_THAT(values, ElementsAre(HIGH, LOW, LOW, HIGH, HIGH));
+
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(4))
+        .WillOnce(Return(HIGH));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(5))
+        .WillOnce(Return(LOW));
+    digitalReadMany(4, values, 2);
+    EXPECT_EQ(values[0], HIGH);
+    EXPECT_EQ(values[1], LOW);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(ExtendedInputOutput, digitalWriteMany) {
+    MinimalMockExtIOElement el_1 = {4};
+    MinimalMockExtIOElement el_2 = {4};
+    InSequence seq;
+    EXPECT_CALL(el_1, digitalWriteBuffered(3, HIGH));
+    EXPECT_CALL(el_1, updateBufferedOutputs());
+    EXPECT_CALL(el_2, digitalWriteBuffered(0, LOW));
+    EXPECT_CALL(el_2, digitalWriteBuffered(1, HIGH));
+    EXPECT_CALL(el_2, updateBufferedOutputs());
+    const PinStatus_t values[] = {HIGH, LOW, HIGH};
+    digitalWriteMany(el_1.pin(3), values, 3);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, HIGH));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(5, LOW));
+    digitalWriteMany(4, values, 2);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
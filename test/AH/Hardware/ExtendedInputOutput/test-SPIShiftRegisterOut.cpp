@@ -0,0 +1,158 @@
+#include <gmock/gmock.h>
+
+#include <AH/Hardware/ExtendedInputOutput/SPIShiftRegisterOut.hpp>
+
+#include <vector>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+class MockSPI {
+  public:
+    MOCK_METHOD(void, begin, ());
+    MOCK_METHOD(void, beginTransaction, (SPISettings));
+    MOCK_METHOD(void, transfer, (void *, size_t));
+    MOCK_METHOD(void, endTransaction, ());
+};
+
+/// Save the bytes passed to `MockSPI::transfer`.
+auto saveTransfer(std::vector<uint8_t> &out) {
+    return Invoke([&out](void *data, size_t length) {
+        auto bytes = static_cast<const uint8_t *>(data);
+        out.assign(bytes, bytes + length);
+    });
+}
+
+TEST(SPIShiftRegisterOut, bulkTransferMSBFirst) {
+    StrictMock<MockSPI> spi;
+    SPIShiftRegisterOut<24, MockSPI &> sr {spi, 10, MSBFIRST};
+    std::vector<uint8_t> sent;
+
+    InSequence seq;
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(10, OUTPUT));
+    EXPECT_CALL(spi, begin());
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, LOW));
+    EXPECT_CALL(spi, transfer(_, 3)).WillOnce(saveTransfer(sent));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, HIGH));
+    EXPECT_CALL(spi, endTransaction());
+    sr.begin();
+    EXPECT_EQ(sent, (std::vector<uint8_t> {0x00, 0x00, 0x00}));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+
+    sr.digitalWriteBuffered(0, HIGH);
+    sr.digitalWriteBuffered(23, HIGH);
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, LOW));
+    EXPECT_CALL(spi, transfer(_, 3)).WillOnce(saveTransfer(sent));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, HIGH));
+    EXPECT_CALL(spi, endTransaction());
+    sr.updateBufferedOutputs();
+    // The last byte of the chain is shifted out first
+    EXPECT_EQ(sent, (std::vector<uint8_t> {0x80, 0x00, 0x01}));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+}
+
+TEST(SPIShiftRegisterOut, bulkTransferLSBFirst) {
+    StrictMock<MockSPI> spi;
+    SPIShiftRegisterOut<16, MockSPI &> sr {spi, 10, LSBFIRST};
+    std::vector<uint8_t> sent;
+
+    sr.digitalWriteBuffered(1, HIGH);
+    sr.digitalWriteBuffered(12, HIGH);
+    InSequence seq;
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, LOW));
+    EXPECT_CALL(spi, transfer(_, 2)).WillOnce(saveTransfer(sent));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, HIGH));
+    EXPECT_CALL(spi, endTransaction());
+    sr.updateBufferedOutputs();
+    EXPECT_EQ(sent, (std::vector<uint8_t> {0x02, 0x10}));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+}
+
+TEST(SPIShiftRegisterOut, skipWhenUnchanged) {
+    StrictMock<MockSPI> spi;
+    SPIShiftRegisterOut<8, MockSPI &> sr {spi, 10, MSBFIRST};
+
+    sr.digitalWriteBuffered(3, HIGH);
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, _)).Times(2);
+    EXPECT_CALL(spi, transfer(_, 1));
+    EXPECT_CALL(spi, endTransaction());
+    sr.updateBufferedOutputs();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+
+    // Nothing changed, so nothing is sent
+    sr.updateBufferedOutputs();
+    // Writing the current values doesn't make the buffer dirty
+    sr.digitalWriteBuffered(3, HIGH);
+    sr.digitalWriteBuffered(4, LOW);
+    sr.updateBufferedOutputs();
+    sr.digitalWrite(3, HIGH);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+
+    // Changing a pin and changing it back still sends the buffer
+    sr.digitalWriteBuffered(5, HIGH);
+    sr.digitalWriteBuffered(5, LOW);
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, _)).Times(2);
+    EXPECT_CALL(spi, transfer(_, 1));
+    EXPECT_CALL(spi, endTransaction());
+    sr.updateBufferedOutputs();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+}
+
+/// Shift register that completes its transfers asynchronously, like a DMA
+/// transfer would.
+template <uint16_t N>
+class AsyncSPIShiftRegisterOut : public SPIShiftRegisterOut<N, MockSPI &> {
+  public:
+    using SPIShiftRegisterOut<N, MockSPI &>::SPIShiftRegisterOut;
+    std::vector<uint8_t> pending;
+
+  protected:
+    bool startTransfer(uint8_t *data, uint16_t length) override {
+        pending.assign(data, data + length);
+        return false;
+    }
+};
+
+TEST(SPIShiftRegisterOut, asyncTransfer) {
+    StrictMock<MockSPI> spi;
+    AsyncSPIShiftRegisterOut<8> sr {spi, 10, MSBFIRST};
+
+    sr.digitalWriteBuffered(0, HIGH);
+    InSequence seq;
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, LOW));
+    sr.updateBufferedOutputs();
+    EXPECT_TRUE(sr.isTransferInProgress());
+    EXPECT_EQ(sr.pending, (std::vector<uint8_t> {0x01}));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+
+    // Changes during the transfer are sent during the next update
+    sr.digitalWriteBuffered(1, HIGH);
+    sr.updateBufferedOutputs();
+
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, HIGH));
+    EXPECT_CALL(spi, endTransaction());
+    sr.finishTransfer();
+    EXPECT_FALSE(sr.isTransferInProgress());
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, LOW));
+    sr.updateBufferedOutputs();
+    EXPECT_EQ(sr.pending, (std::vector<uint8_t> {0x03}));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&spi);
+}
@@ -0,0 +1,136 @@
+#include <gmock/gmock.h>
+
+#include <AH/Hardware/ExtendedInputOutput/MAX7219.hpp>
+#include <AH/Hardware/LEDs/MAX7219SevenSegmentDisplay.hpp>
+
+#include <vector>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+/// Records the bytes of every SPI transaction.
+struct FakeSPI {
+    void begin() {}
+    void beginTransaction(SPISettings) { transactions.emplace_back(); }
+    uint8_t transfer(uint8_t data) {
+        transactions.back().push_back(data);
+        return 0;
+    }
+    void endTransaction() {}
+
+    std::vector<std::vector<uint8_t>> transactions;
+};
+
+using Transactions = std::vector<std::vector<uint8_t>>;
+
+TEST(MAX7219, sendChangedOnlyChangedDigits) {
+    FakeSPI spi;
+    MAX7219SevenSegmentDisplay<FakeSPI &> max {spi, 10, 3};
+    MAX7219_FrameBuffer<3> framebuffer;
+    max.setFrameBuffer(&framebuffer);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, _))
+        .Times(AnyNumber());
+
+    // Everything is sent after attaching the framebuffer
+    EXPECT_EQ(max.update(), 8);
+    EXPECT_EQ(spi.transactions.size(), 8u);
+    spi.transactions.clear();
+
+    // Nothing changed
+    max.sendDigit(0, 0x00);
+    EXPECT_EQ(max.update(), 0);
+    EXPECT_TRUE(spi.transactions.empty());
+
+    // Digit 1 of chip 0, digit 1 of chip 2 and digit 3 of chip 1
+    max.sendDigit(1, 0x11);
+    max.sendDigit(17, 0x22);
+    max.sendDigit(11, 0x33);
+    EXPECT_EQ(max.update(), 2);
+    Transactions expected = {
+        {0x02, 0x11, 0x00, 0x00, 0x02, 0x22},
+        {0x00, 0x00, 0x04, 0x33, 0x00, 0x00},
+    };
+    EXPECT_EQ(spi.transactions, expected);
+    EXPECT_FALSE(framebuffer.isDirty());
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(MAX7219, sevenSegmentTimecode) {
+    FakeSPI spi;
+    MAX7219SevenSegmentDisplay<FakeSPI &> max {spi, 10, 2};
+    MAX7219_FrameBuffer<2> framebuffer;
+    max.setFrameBuffer(&framebuffer);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, _))
+        .Times(AnyNumber());
+
+    max.display(1234567L);
+    max.update();
+    spi.transactions.clear();
+
+    // Only the last digit changes
+    max.display(1234568L);
+    EXPECT_EQ(max.update(), 1);
+    Transactions expected = {
+        {0x01, NumericChars[8], 0x00, 0x00},
+    };
+    EXPECT_EQ(spi.transactions, expected);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(MAX7219, sevenSegmentWithoutFrameBuffer) {
+    FakeSPI spi;
+    MAX7219SevenSegmentDisplay<FakeSPI &> max {spi, 10, 2};
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, _))
+        .Times(AnyNumber());
+
+    max.sendDigit(9, 0x42);
+    Transactions expected = {
+        {0x00, 0x00, 0x02, 0x42},
+    };
+    EXPECT_EQ(spi.transactions, expected);
+    EXPECT_EQ(max.update(), 0);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(MAX7219, extIOUpdateBufferedOutputs) {
+    FakeSPI spi;
+    MAX7219<2, FakeSPI &> max {spi, 10};
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, _))
+        .Times(AnyNumber());
+
+    // Pin 65 = chip 1, row 0, column 1
+    max.digitalWriteBuffered(65, HIGH);
+    // Pin 3 = chip 0, row 0, column 3
+    max.digitalWriteBuffered(3, HIGH);
+    // Pin 12 = chip 0, row 1, column 4, set and cleared
+    max.digitalWriteBuffered(12, HIGH);
+    max.digitalWriteBuffered(12, LOW);
+    max.updateBufferedOutputs();
+    Transactions expected = {
+        {0x01, 0x08, 0x01, 0x02},
+        {0x02, 0x00, 0x00, 0x00},
+    };
+    EXPECT_EQ(spi.transactions, expected);
+    spi.transactions.clear();
+
+    // Unchanged
+    max.digitalWriteBuffered(3, HIGH);
+    max.updateBufferedOutputs();
+    max.digitalWrite(65, HIGH);
+    EXPECT_TRUE(spi.transactions.empty());
+
+    // Immediate write only sends its own row
+    max.digitalWriteBuffered(8, HIGH);
+    max.digitalWrite(127, HIGH);
+    expected = {
+        {0x00, 0x00, 0x08, 0x80},
+    };
+    EXPECT_EQ(spi.transactions, expected);
+    EXPECT_EQ(max.digitalRead(127), HIGH);
+    EXPECT_EQ(max.digitalRead(126), LOW);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -0,0 +1,356 @@
+#include <gmock/gmock.h>
+
+#include <AH/Hardware/AnalogScanner.hpp>
+#include <AH/Hardware/FilteredAnalog.hpp>
+
+#include <map>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+/// Simulates the address lines and the outputs of the multiplexers using the
+/// Arduino mock: the value of a multiplexer channel is 100 × analog pin +
+/// address. A5 is not connected to a multiplexer.
+class MuxSimulation {
+  public:
+    MuxSimulation() {
+        EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(_, _))
+            .WillRepeatedly(Invoke([this](uint8_t pin, uint8_t val) {
+                pins[pin] = val;
+                ++writes;
+            }));
+        EXPECT_CALL(ArduinoMock::getInstance(), analogRead(_))
+            .WillRepeatedly(Invoke([this](uint8_t pin) -> int {
+                ++reads;
+                return 100 * (pin - A0) + (pin == A5 ? 0 : address(pin));
+            }));
+    }
+    ~MuxSimulation() { Mock::VerifyAndClear(&ArduinoMock::getInstance()); }
+
+    /// Address selected on the lines of the multiplexer connected to the
+    /// given analog pin.
+    uint8_t address(uint8_t analogPin) {
+        const uint8_t *lines = analogPin == A2 ? linesB : linesA;
+        uint8_t address = 0;
+        for (uint8_t i = 0; i < 4; ++i)
+            address |= pins[lines[i]] << i;
+        return address;
+    }
+
+    static constexpr uint8_t linesA[4] = {2, 3, 4, 5};
+    static constexpr uint8_t linesB[4] = {6, 7, 8, 9};
+    std::map<uint8_t, uint8_t> pins;
+    unsigned writes = 0;
+    unsigned reads = 0;
+};
+constexpr uint8_t MuxSimulation::linesA[4];
+constexpr uint8_t MuxSimulation::linesB[4];
+
+TEST(AnalogScanner, sharedAddressLines) {
+    MuxSimulation sim;
+    CD74HC4067 muxA {A0, {2, 3, 4, 5}};
+    CD74HC4067 muxB {A1, {2, 3, 4, 5}};
+    muxA.discardFirstReading(false);
+    muxB.discardFirstReading(false);
+    AnalogScanner<32> scanner;
+    EXPECT_TRUE(scanner.add(muxA));
+    EXPECT_TRUE(scanner.add(muxB));
+    EXPECT_EQ(scanner.getNumberOfChannels(), 32);
+
+    analog_t value;
+    EXPECT_FALSE(scanner.getValue(muxA.pin(3), value)); // not scanned yet
+
+    EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(sim.reads, 32u);
+    // Each address is selected only once for both multiplexers
+    EXPECT_EQ(scanner.getAddressChangesPerScan(), 16);
+    EXPECT_EQ(scanner.getNumberOfScans(), 1u);
+
+    for (uint8_t i = 0; i < 16; ++i) {
+        ASSERT_TRUE(scanner.getValue(muxA.pin(i), value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(scanner.getValue(muxB.pin(i), value));
+        EXPECT_EQ(value, 100 + i);
+    }
+    EXPECT_FALSE(scanner.getValue(A5, value));
+}
+
+TEST(AnalogScanner, separateAddressLinesAndNativePins) {
+    MuxSimulation sim;
+    CD74HC4067 muxA {A0, {2, 3, 4, 5}};
+    CD74HC4067 muxB {A2, {6, 7, 8, 9}};
+    AnalogScanner<40, 2> scanner;
+    EXPECT_TRUE(scanner.add(muxA));
+    EXPECT_TRUE(scanner.add(A5));
+    EXPECT_TRUE(scanner.add(muxB));
+    CD74HC4067 muxC {A3, {2, 3, 4, 5}};
+    EXPECT_FALSE(scanner.add(muxC)); // too many multiplexers
+
+    EXPECT_TRUE(scanner.scan());
+    // One discarded reading per multiplexer channel
+    EXPECT_EQ(sim.reads, 2 * 32u + 1u);
+    EXPECT_EQ(scanner.getAddressChangesPerScan(), 32);
+
+    analog_t value;
+    for (uint8_t i = 0; i < 16; ++i) {
+        ASSERT_TRUE(scanner.getValue(muxA.pin(i), value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(scanner.getValue(muxB.pin(i), value));
+        EXPECT_EQ(value, 200 + i);
+    }
+    ASSERT_TRUE(scanner.getValue(A5, value));
+    EXPECT_EQ(value, 500);
+}
+
+TEST(AnalogScanner, enablePins) {
+    MuxSimulation sim;
+    CD74HC4051 muxA {A0, {2, 3, 4}, 10};
+    CD74HC4051 muxB {A0, {2, 3, 4}, 11};
+    muxA.discardFirstReading(false);
+    muxB.discardFirstReading(false);
+    AnalogScanner<16> scanner;
+    scanner.add(muxA);
+    scanner.add(muxB);
+    sim.pins[10] = sim.pins[11] = HIGH;
+
+    // Only one of the multiplexers sharing the analog pin may be enabled
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .Times(16)
+        .WillRepeatedly(Invoke([&](uint8_t) -> int {
+            EXPECT_NE(sim.pins[10], sim.pins[11]);
+            return sim.pins[10] == LOW ? 1 : 2;
+        }));
+    EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(sim.pins[10], HIGH);
+    EXPECT_EQ(sim.pins[11], HIGH);
+    EXPECT_EQ(scanner.getAddressChangesPerScan(), 8);
+
+    analog_t value;
+    ASSERT_TRUE(scanner.getValue(muxA.pin(5), value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(scanner.getValue(muxB.pin(5), value));
+    EXPECT_EQ(value, 2);
+}
+
+/// Backend that needs to be polled a few times before the conversion is done.
+struct SlowBackend : AnalogScanBackend {
+    void startConversion(pin_t analogPin) override {
+        pin = analogPin;
+        polls = 0;
+        ++conversions;
+    }
+    bool isConversionReady() override { return ++polls > 2; }
+    analog_t getConversionResult() override { return pin; }
+
+    pin_t pin = NO_PIN;
+    unsigned polls = 0;
+    unsigned conversions = 0;
+};
+
+TEST(AnalogScanner, nonBlockingBackend) {
+    SlowBackend backend;
+    AnalogScanner<2> scanner;
+    scanner.setBackend(backend);
+    scanner.add(A0);
+    scanner.add(A1);
+
+    EXPECT_FALSE(scanner.scan()); // Start A0, not ready
+    EXPECT_FALSE(scanner.scan()); // Not ready
+    EXPECT_FALSE(scanner.scan()); // A0 ready, start A1
+    EXPECT_FALSE(scanner.scan()); // Not ready
+    EXPECT_TRUE(scanner.scan());  // A1 ready
+    EXPECT_EQ(backend.conversions, 2u);
+
+    analog_t value;
+    ASSERT_TRUE(scanner.getValue(A1, value));
+    EXPECT_EQ(value, A1);
+}
+
+TEST(AnalogScanner, filteredAnalogUsesSnapshot) {
+    SlowBackend backend;
+    AnalogScanner<1> scanner;
+    scanner.setBackend(backend);
+    scanner.add(A0);
+    FilteredAnalog<10, 0> analog = A0;
+    FilteredAnalog<10, 0> other = A1;
+
+    // Not converted yet, so read directly
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(Return(5));
+    analog.update();
+    EXPECT_EQ(analog.getValue(), 5);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    while (!scanner.scan())
+        ;
+    // From the snapshot buffer, no analogRead
+    analog.update();
+    EXPECT_EQ(analog.getValue(), A0);
+    // Pins that are not scanned are still read directly
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A1))
+        .WillOnce(Return(7));
+    other.update();
+    EXPECT_EQ(other.getValue(), 7);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+/// Backend that converts instantly, and counts the conversions of each pin.
+struct CountingBackend : AnalogScanBackend {
+    void startConversion(pin_t analogPin) override {
+        pin = analogPin;
+        ++counts[pin];
+    }
+    bool isConversionReady() override { return true; }
+    analog_t getConversionResult() override { return readings[pin]; }
+
+    pin_t pin = NO_PIN;
+    std::map<pin_t, unsigned> counts;
+    std::map<pin_t, analog_t> readings;
+};
+
+/// Backend that samples the simulated multiplexers when the conversion is
+/// started, and needs to be polled a few times before it is done.
+struct SamplingBackend : AnalogScanBackend {
+    SamplingBackend(MuxSimulation &sim) : sim(sim) {}
+    void startConversion(pin_t analogPin) override {
+        result = 100 * (analogPin - A0) + sim.address(analogPin);
+        polls = 0;
+    }
+    bool isConversionReady() override { return ++polls > 2; }
+    analog_t getConversionResult() override { return result; }
+
+    MuxSimulation &sim;
+    analog_t result = 0;
+    unsigned polls = 0;
+};
+
+TEST(AnalogScanner, directReadDuringNonBlockingPass) {
+    MuxSimulation sim;
+    SamplingBackend backend {sim};
+    CD74HC4067 muxA {A0, {2, 3, 4, 5}};
+    CD74HC4067 muxB {A1, {2, 3, 4, 5}}; // same address lines, not scanned
+    CD74HC4067 muxC {A3, {2, 3, 4, 5}};
+    muxA.discardFirstReading(false);
+    muxC.discardFirstReading(false);
+    AnalogScanner<32> scanner;
+    scanner.setBackend(backend);
+    scanner.add(muxA);
+    scanner.add(muxC);
+    FilteredAnalog<10, 0> other = muxB.pin(15);
+
+    // The other input selects address 15 in the middle of the pass
+    while (!scanner.scan()) {
+        other.update();
+        EXPECT_EQ(sim.address(A1), 15);
+    }
+    EXPECT_EQ(other.getValue(), 115);
+    analog_t value;
+    for (uint8_t i = 0; i < 16; ++i) {
+        ASSERT_TRUE(scanner.getValue(muxA.pin(i), value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(scanner.getValue(muxC.pin(i), value));
+        EXPECT_EQ(value, 300 + i);
+    }
+}
+
+TEST(AnalogScanner, separateUpdatableGroup) {
+    CountingBackend backend;
+    AnalogScanner<1> scanner;
+    scanner.setBackend(backend);
+    scanner.add(A0);
+    // Not updated together with the inputs, but before them
+    Updatable<>::updateAll();
+    EXPECT_EQ(backend.counts[A0], 0u);
+    Updatable<AnalogScannerBase>::updateAll();
+    EXPECT_EQ(backend.counts[A0], 1u);
+}
+
+TEST(AnalogScanner, adaptiveSampling) {
+    unsigned long time = 0;
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Invoke([&] { return time; }));
+    CountingBackend backend;
+    AnalogScanner<6> scanner;
+    scanner.setBackend(backend);
+    const pin_t pins[] = {A0, A1, A2, A3, A4, A5};
+    for (pin_t pin : pins)
+        scanner.add(pin);
+    scanner.enableAdaptiveSampling(100, 4);
+
+    // Full rate until the timeout expires
+    EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(scanner.getConversionsPerScan(), 6);
+    EXPECT_EQ(scanner.getNumberOfIdleChannels(), 0);
+    time = 100;
+    EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(scanner.getNumberOfIdleChannels(), 6);
+    EXPECT_EQ(scanner.getSampleInterval(A2), 4);
+    EXPECT_EQ(scanner.getSampleInterval(13), 0); // not scanned
+
+    // Idle channels are converted once every four passes, spread out evenly
+    backend.counts.clear();
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(scanner.scan());
+        EXPECT_LE(scanner.getConversionsPerScan(), 2);
+    }
+    for (pin_t pin : pins)
+        EXPECT_EQ(backend.counts[pin], 2u) << +pin;
+
+    // Activity makes the channel and its neighbours run at the full rate
+    AnalogScannerBase::reportActivity(A3);
+    EXPECT_EQ(scanner.getNumberOfIdleChannels(), 3);
+    EXPECT_EQ(scanner.getSampleInterval(A1), 4);
+    EXPECT_EQ(scanner.getSampleInterval(A2), 1);
+    EXPECT_EQ(scanner.getSampleInterval(A3), 1);
+    EXPECT_EQ(scanner.getSampleInterval(A4), 1);
+    EXPECT_EQ(scanner.getSampleInterval(A5), 4);
+    backend.counts.clear();
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(backend.counts[A0], 1u);
+    EXPECT_EQ(backend.counts[A3], 4u);
+
+    // Until they time out again
+    time = 250;
+    EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(scanner.getNumberOfIdleChannels(), 6);
+
+    scanner.disableAdaptiveSampling();
+    EXPECT_TRUE(scanner.scan());
+    EXPECT_EQ(scanner.getConversionsPerScan(), 6);
+    EXPECT_EQ(scanner.getSampleInterval(A2), 1);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(AnalogScanner, filteredAnalogReportsActivity) {
+    unsigned long time = 0;
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Invoke([&] { return time; }));
+    CountingBackend backend;
+    AnalogScanner<3> scanner;
+    scanner.setBackend(backend);
+    scanner.add(A0);
+    scanner.add(A2);
+    scanner.add(A4);
+    scanner.enableAdaptiveSampling(100, 8);
+    FilteredAnalog<7, 0> analog = A2;
+
+    time = 100;
+    scanner.scan();
+    analog.update();
+    EXPECT_EQ(scanner.getNumberOfIdleChannels(), 3);
+
+    // The fader is moved
+    backend.readings[A2] = 1023;
+    while (scanner.getSampleInterval(A2) != 1) {
+        ASSERT_LT(scanner.getNumberOfScans(), 20u);
+        scanner.scan();
+        analog.update();
+    }
+    EXPECT_EQ(analog.getValue(), 127);
+    EXPECT_EQ(scanner.getSampleInterval(A0), 1);
+    EXPECT_EQ(scanner.getSampleInterval(A4), 1);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
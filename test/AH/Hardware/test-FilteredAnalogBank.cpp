@@ -0,0 +1,107 @@
+#include <gmock/gmock.h>
+
+#include <AH/Hardware/ExtendedInputOutput/ExtendedIOElement.hpp>
+#include <AH/Hardware/FilteredAnalogBank.hpp>
+
+#include <random>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+/// Extended IO element with analog inputs that return the given readings.
+struct FakeAnalogInputs : ExtendedIOElement {
+    FakeAnalogInputs(const analog_t *readings, pin_t length)
+        : ExtendedIOElement(length), readings(readings) {}
+    void pinModeBuffered(pin_t, PinMode_t) override {}
+    void digitalWriteBuffered(pin_t, PinStatus_t) override {}
+    PinStatus_t digitalReadBuffered(pin_t) override { return LOW; }
+    analog_t analogReadBuffered(pin_t pin) override { return readings[pin]; }
+    void analogWriteBuffered(pin_t, analog_t) override {}
+    void begin() override {}
+    void updateBufferedOutputs() override {}
+    void updateBufferedInputs() override {}
+    const analog_t *readings;
+};
+
+/// Feeds the same random readings to a bank and to separate FilteredAnalog
+/// objects, and checks that the results are identical.
+template <uint8_t N, uint8_t Precision>
+void testMatchesFilteredAnalog(bool withMapping) {
+    std::mt19937 rng {0x1234};
+    analog_t readings[N] = {};
+    FakeAnalogInputs inputs {readings, N};
+
+    Array<pin_t, N> pins;
+    for (uint8_t i = 0; i < N; ++i)
+        pins[i] = inputs.pin(i);
+    FilteredAnalogBank<N, Precision> bank = pins;
+    FilteredAnalog<Precision> separate[N];
+    for (uint8_t i = 0; i < N; ++i)
+        separate[i] = FilteredAnalog<Precision>(inputs.pin(i));
+    if (withMapping) {
+        for (uint8_t i = 0; i < N; i += 3) {
+            bank.invert(i);
+            separate[i].invert();
+        }
+    }
+
+    for (int step = 0; step < 500; ++step) {
+        // Slowly moving inputs with some noise, and the occasional jump
+        for (uint8_t i = 0; i < N; ++i) {
+            int delta = int(rng() % 9) - 4;
+            if (rng() % 50 == 0)
+                delta = int(rng() % 1024) - 512;
+            readings[i] = constrain(int(readings[i]) + delta, 0, 1023);
+        }
+        bool anyChanged = false;
+        bool bankChanged = bank.update();
+        for (uint8_t i = 0; i < N; ++i) {
+            bool changed = separate[i].update();
+            anyChanged |= changed;
+            ASSERT_EQ(bank.hasChanged(i), changed) << +i << " @ " << step;
+            ASSERT_EQ(bank.getValue(i), separate[i].getValue())
+                << +i << " @ " << step;
+        }
+        ASSERT_EQ(bankChanged, anyChanged) << step;
+    }
+}
+
+TEST(FilteredAnalogBank, matchesFilteredAnalog) {
+    testMatchesFilteredAnalog<32, 10>(false);
+}
+TEST(FilteredAnalogBank, matchesFilteredAnalog7Bit) {
+    testMatchesFilteredAnalog<32, 7>(false);
+}
+TEST(FilteredAnalogBank, matchesFilteredAnalogPartialByte) {
+    testMatchesFilteredAnalog<13, 7>(false);
+}
+TEST(FilteredAnalogBank, matchesFilteredAnalogWithMapping) {
+    testMatchesFilteredAnalog<20, 7>(true);
+}
+
+TEST(FilteredAnalogBank, updateFromReadings) {
+    FilteredAnalogBank<10, 7> bank = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}};
+    analog_t readings[10] = {};
+    readings[9] = 1023;
+    for (int i = 0; i < 100; ++i)
+        bank.update(readings);
+    for (uint8_t i = 0; i < 9; ++i)
+        EXPECT_EQ(bank.getValue(i), 0);
+    EXPECT_EQ(bank.getValue(9), 127);
+    EXPECT_FALSE(bank.hasChanged(9));
+
+    readings[2] = 1023;
+    EXPECT_TRUE(bank.update(readings));
+    EXPECT_EQ(bank.getChanges().getByte(0), 0b100);
+    EXPECT_EQ(bank.getChanges().getByte(1), 0);
+}
+
+TEST(FilteredAnalogBank, resetToCurrentValue) {
+    FilteredAnalogBank<2, 7> bank = {{2, 3}};
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(2)).WillOnce(Return(1023));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(3)).WillOnce(Return(512));
+    bank.resetToCurrentValue();
+    EXPECT_EQ(bank.getValue(0), 127);
+    EXPECT_EQ(bank.getValue(1), 64);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <AH/Hardware/RegisterEncoders.hpp>
+
+#include <random>
+
+USING_AH_NAMESPACE;
+
+TEST(RegisterEncoders, singleEncoderSteps) {
+    RegisterEncoders<uint8_t, 1, int32_t> encs;
+    encs.reset(0b00);
+    // Gray code sequence in one direction
+    for (uint8_t s : {0b01, 0b11, 0b10, 0b00})
+        EXPECT_TRUE(encs.update(s));
+    EXPECT_EQ(encs.read(0), -4);
+    // And back
+    for (uint8_t s : {0b10, 0b11, 0b01, 0b00})
+        encs.update(s);
+    EXPECT_EQ(encs.read(0), 0);
+    // No change
+    EXPECT_FALSE(encs.update(0b00));
+    // Missed step
+    encs.update(0b11);
+    EXPECT_EQ(encs.read(0), +2);
+}
+
+TEST(RegisterEncoders, bitwiseMatchesLUTExhaustive) {
+    // Every transition of four encoders in an 8-bit register
+    for (unsigned oldstate = 0; oldstate <= 0xFF; ++oldstate) {
+        for (unsigned newstate = 0; newstate <= 0xFF; ++newstate) {
+            RegisterEncoders<uint8_t, 4, int32_t> lut, bitwise;
+            lut.reset(oldstate);
+            bitwise.reset(oldstate);
+            lut.updateLUT(newstate);
+            bitwise.updateBitwise(newstate);
+            for (uint8_t i = 0; i < 4; ++i)
+                ASSERT_EQ(lut.read(i), bitwise.read(i))
+                    << std::hex << oldstate << " → " << newstate;
+        }
+    }
+}
+
+TEST(RegisterEncoders, bitwiseIgnoresUnusedBits) {
+    RegisterEncoders<uint16_t, 3, int32_t> encs;
+    encs.reset(0x0000);
+    encs.updateBitwise(0xFFC0);
+    for (uint8_t i = 0; i < 3; ++i)
+        EXPECT_EQ(encs.read(i), 0);
+}
+
+template <class RegisterType, uint8_t NumEnc>
+void testRandomSequence() {
+    std::mt19937_64 rng {0x1234};
+    RegisterEncoders<RegisterType, NumEnc, int32_t> lut, bitwise;
+    RegisterType state = 0;
+    lut.reset(state);
+    bitwise.reset(state);
+    for (int i = 0; i < 10000; ++i) {
+        // Flip a few random bits
+        RegisterType flips = rng() & rng() & rng();
+        state ^= flips;
+        EXPECT_EQ(lut.updateLUT(state), bitwise.updateBitwise(state));
+    }
+    for (uint8_t i = 0; i < NumEnc; ++i)
+        EXPECT_EQ(lut.read(i), bitwise.read(i)) << +i;
+}
+
+TEST(RegisterEncoders, bitwiseMatchesLUT16) { testRandomSequence<uint16_t, 8>(); }
+TEST(RegisterEncoders, bitwiseMatchesLUT32) { testRandomSequence<uint32_t, 16>(); }
+TEST(RegisterEncoders, bitwiseMatchesLUT64) { testRandomSequence<uint64_t, 32>(); }
+TEST(RegisterEncoders, bitwiseMatchesLUTPartial) {
+    testRandomSequence<uint32_t, 13>();
+}
+
+TEST(RegisterEncoders, unsignedPositions) {
+    RegisterEncoders<uint8_t, 2, uint8_t> encs;
+    encs.reset(0b0000);
+    encs.updateBitwise(0b0100);
+    EXPECT_EQ(encs.read(0), 0);
+    EXPECT_EQ(encs.read(1), 0xFF);
+}
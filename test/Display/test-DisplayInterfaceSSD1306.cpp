@@ -0,0 +1,207 @@
+#include <Display/DisplayInterfaces/DisplayInterfaceSSD1306.hpp>
+#include <gmock/gmock.h>
+
+using namespace ::testing;
+using namespace CS;
+
+class DiffDisplay : public SSD1306_DiffDisplayInterface<> {
+  public:
+    DiffDisplay(Adafruit_SSD1306 &disp) : SSD1306_DiffDisplayInterface(disp) {}
+    void drawBackground() override {}
+};
+
+class SSD1306Diff : public Test {
+  protected:
+    SSD1306Diff() : ssd1306(128, 64, &wire), display(ssd1306) {}
+
+    void SetUp() override {
+        display.display(); // first frame is sent in full
+        wire.transmissions.clear();
+        ssd1306.commands.clear();
+    }
+
+    // Number of bytes that were sent over I²C, without addresses and control
+    // bytes.
+    unsigned bytesOnWire() const {
+        unsigned count = 0;
+        for (auto &t : wire.transmissions) {
+            EXPECT_LE(t.data.size(), size_t(BUFFER_LENGTH));
+            count += t.data.size() - 1;
+        }
+        return count;
+    }
+
+    TwoWire wire;
+    Adafruit_SSD1306 ssd1306;
+    DiffDisplay display;
+};
+
+TEST(SSD1306DiffFirstFrame, isSentInFull) {
+    TwoWire wire;
+    Adafruit_SSD1306 ssd1306 {128, 64, &wire};
+    DiffDisplay display {ssd1306};
+    display.display();
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+    EXPECT_EQ(display.getBytesSent(), 6u + 1024u);
+    unsigned count = 0;
+    for (auto &t : wire.transmissions)
+        count += t.data.size() - 1;
+    EXPECT_EQ(count, 6u + 1024u);
+}
+
+TEST_F(SSD1306Diff, unchangedFrameSendsNothing) {
+    display.display();
+    EXPECT_EQ(display.getBytesSent(), 0u);
+    EXPECT_THAT(wire.transmissions, IsEmpty());
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+}
+
+TEST_F(SSD1306Diff, singlePixel) {
+    ssd1306.drawPixel(10, 20, WHITE);
+    display.display();
+    EXPECT_THAT(ssd1306.commands,
+                ElementsAre(SSD1306_PAGEADDR, 2, 2, SSD1306_COLUMNADDR, 10, 10));
+    EXPECT_EQ(display.getBytesSent(), 7u);
+    EXPECT_EQ(bytesOnWire(), 7u);
+    EXPECT_THAT(wire.transmissions.back().data, ElementsAre(0x40, 0x10));
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+
+    // Changing it back is a change as well
+    wire.transmissions.clear();
+    ssd1306.drawPixel(10, 20, BLACK);
+    display.display();
+    EXPECT_EQ(bytesOnWire(), 7u);
+    EXPECT_THAT(wire.transmissions.back().data, ElementsAre(0x40, 0x00));
+}
+
+TEST_F(SSD1306Diff, nearbyChangesAreCombined) {
+    ssd1306.drawPixel(10, 0, WHITE);
+    ssd1306.drawPixel(17, 0, WHITE); // 6 unchanged columns in between
+    display.display();
+    EXPECT_THAT(ssd1306.commands,
+                ElementsAre(SSD1306_PAGEADDR, 0, 0, SSD1306_COLUMNADDR, 10, 17));
+    EXPECT_EQ(display.getBytesSent(), 6u + 8u);
+    EXPECT_EQ(bytesOnWire(), 6u + 8u);
+}
+
+TEST_F(SSD1306Diff, distantChangesAreSeparate) {
+    ssd1306.drawPixel(10, 0, WHITE);
+    ssd1306.drawPixel(18, 0, WHITE); // 7 unchanged columns in between
+    display.display();
+    EXPECT_THAT(ssd1306.commands,
+                ElementsAre(SSD1306_PAGEADDR, 0, 0, SSD1306_COLUMNADDR, 10, 10,
+                            SSD1306_PAGEADDR, 0, 0, SSD1306_COLUMNADDR, 18, 18));
+    EXPECT_EQ(display.getBytesSent(), 7u + 7u);
+    EXPECT_EQ(bytesOnWire(), 7u + 7u);
+}
+
+TEST_F(SSD1306Diff, adjacentPagesAreCombined) {
+    ssd1306.fillRect(60, 0, 4, 64, WHITE); // e.g. a VU meter
+    display.display();
+    EXPECT_THAT(ssd1306.commands,
+                ElementsAre(SSD1306_PAGEADDR, 0, 7, SSD1306_COLUMNADDR, 60, 63));
+    EXPECT_EQ(display.getBytesSent(), 6u + 8u * 4u);
+    EXPECT_EQ(bytesOnWire(), 6u + 8u * 4u);
+}
+
+TEST_F(SSD1306Diff, fullScreenChange) {
+    ssd1306.fillScreen(WHITE);
+    display.display();
+    EXPECT_EQ(display.getBytesSent(), 6u + 1024u);
+    EXPECT_EQ(bytesOnWire(), 6u + 1024u);
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+    // Now the display is white
+    wire.transmissions.clear();
+    display.display();
+    EXPECT_EQ(display.getBytesSent(), 0u);
+}
+
+TEST_F(SSD1306Diff, regionOnlySendsChangesInRegion) {
+    ssd1306.drawPixel(10, 20, WHITE);
+    ssd1306.drawPixel(100, 50, WHITE);
+    display.display(0, 16, 32, 8);
+    EXPECT_THAT(ssd1306.commands,
+                ElementsAre(SSD1306_PAGEADDR, 2, 2, SSD1306_COLUMNADDR, 10, 10));
+    EXPECT_EQ(display.getBytesSent(), 7u);
+    // The change outside of the region is sent later
+    ssd1306.commands.clear();
+    display.display();
+    EXPECT_THAT(ssd1306.commands, ElementsAre(SSD1306_PAGEADDR, 6, 6,
+                                              SSD1306_COLUMNADDR, 100, 100));
+    EXPECT_EQ(display.getBytesSent(), 7u);
+}
+
+TEST_F(SSD1306Diff, invalidate) {
+    display.invalidate();
+    display.display();
+    EXPECT_EQ(ssd1306.displayCount, 2u);
+    EXPECT_EQ(display.getBytesSent(), 6u + 1024u);
+    EXPECT_EQ(bytesOnWire(), 6u + 1024u);
+}
+
+TEST_F(SSD1306Diff, counters) {
+    EXPECT_EQ(display.getFrameCount(), 1u);
+    EXPECT_EQ(display.getTotalBytesSent(), 6u + 1024u);
+    ssd1306.drawPixel(10, 20, WHITE);
+    display.display();
+    display.display();
+    EXPECT_EQ(display.getFrameCount(), 3u);
+    EXPECT_EQ(display.getTotalBytesSent(), 6u + 1024u + 7u);
+    display.resetCounters();
+    EXPECT_EQ(display.getFrameCount(), 0u);
+    EXPECT_EQ(display.getTotalBytesSent(), 0u);
+}
+
+TEST(SSD1306DiffWithoutWindows, sendsFullFrameOnlyWhenChanged) {
+    Adafruit_SSD1306 ssd1306; // no I²C interface
+    DiffDisplay display {ssd1306};
+    display.display();
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+    display.display();
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+    EXPECT_EQ(display.getBytesSent(), 0u);
+    ssd1306.drawPixel(10, 20, WHITE);
+    display.display();
+    EXPECT_EQ(ssd1306.displayCount, 2u);
+    EXPECT_EQ(display.getBytesSent(), 6u + 1024u);
+    display.display();
+    EXPECT_EQ(ssd1306.displayCount, 2u);
+}
+
+TEST(SSD1306DiffSmallDisplay, usesSizeOfDisplay) {
+    TwoWire wire;
+    Adafruit_SSD1306 ssd1306 {128, 32, &wire};
+    DiffDisplay display {ssd1306};
+    display.display();
+    EXPECT_EQ(display.getBytesSent(), 6u + 512u);
+
+    ssd1306.drawPixel(127, 31, WHITE);
+    ssd1306.commands.clear();
+    display.display();
+    EXPECT_THAT(ssd1306.commands, ElementsAre(SSD1306_PAGEADDR, 3, 3,
+                                              SSD1306_COLUMNADDR, 127, 127));
+    EXPECT_THAT(wire.transmissions.back().data, ElementsAre(0x40, 0x80));
+
+    ssd1306.fillScreen(WHITE);
+    ssd1306.commands.clear();
+    display.display();
+    EXPECT_THAT(ssd1306.commands,
+                ElementsAre(SSD1306_PAGEADDR, 0, 3, SSD1306_COLUMNADDR, 0, 127));
+    EXPECT_EQ(display.getBytesSent(), 6u + 512u);
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+}
+
+class SmallDiffDisplay : public SSD1306_DiffDisplayInterface<128, 32> {
+  public:
+    SmallDiffDisplay(Adafruit_SSD1306 &disp)
+        : SSD1306_DiffDisplayInterface(disp) {}
+    void drawBackground() override {}
+};
+
+TEST(SSD1306DiffSmallDisplay, displayLargerThanCopy) {
+    TwoWire wire;
+    Adafruit_SSD1306 ssd1306 {128, 64, &wire};
+    SmallDiffDisplay display {ssd1306};
+    EXPECT_THROW(display.display(), AH::ErrorException);
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+}
@@ -0,0 +1,258 @@
+#include <Control_Surface/Control_Surface_Class.hpp>
+#include <Display/DisplayElement.hpp>
+#include <Display/DisplayInterfaces/DisplayInterfaceSSD1306.hpp>
+#include <Display/SelectorDisplay.hpp>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+using namespace CS;
+
+// Display that records what's cleared and sent.
+class FakeDisplay : public DisplayInterface {
+  public:
+    FakeDisplay(PixelRegion bounds = {0, 0, 128, 64}) : bounds(bounds) {}
+
+    void clear() override { log.push_back("clear"); }
+    void drawBackground() override { log.push_back("background"); }
+    void display() override { log.push_back("display"); }
+
+    PixelRegion getBounds() const override { return bounds; }
+    void clearRegion(int16_t x, int16_t y, int16_t w, int16_t h) override {
+        log.push_back("clear " + str({x, y, w, h}));
+    }
+    void display(int16_t x, int16_t y, int16_t w, int16_t h) override {
+        log.push_back("display " + str({x, y, w, h}));
+    }
+
+    void drawPixel(int16_t, int16_t, uint16_t) override {}
+    void setTextColor(uint16_t) override {}
+    void setTextSize(uint8_t) override {}
+    void setCursor(int16_t, int16_t) override {}
+    size_t write(uint8_t) override { return 1; }
+    void drawLine(int16_t, int16_t, int16_t, int16_t, uint16_t) override {}
+    void drawFastVLine(int16_t, int16_t, int16_t, uint16_t) override {}
+    void drawFastHLine(int16_t, int16_t, int16_t, uint16_t) override {}
+    void drawXBitmap(int16_t, int16_t, const uint8_t[], int16_t, int16_t,
+                     uint16_t) override {}
+
+    static std::string str(PixelRegion r) {
+        return std::to_string(r.x) + ',' + std::to_string(r.y) + ',' +
+               std::to_string(r.w) + ',' + std::to_string(r.h);
+    }
+
+    PixelRegion bounds;
+    std::vector<std::string> log;
+};
+
+class TestElement : public DisplayElement {
+  public:
+    TestElement(DisplayInterface &display, PixelRegion box)
+        : DisplayElement(display), box(box) {}
+    TestElement(DisplayInterface &display)
+        : DisplayElement(display), useDefaultBox(true) {}
+
+    void draw() override {
+        ++drawCount;
+        dirty = false;
+    }
+    bool getDirty() const override { return dirty; }
+    PixelRegion getBoundingBox() const override {
+        return useDefaultBox ? DisplayElement::getBoundingBox() : box;
+    }
+
+    PixelRegion box = {0, 0, 0, 0};
+    bool useDefaultBox = false;
+    bool dirty = true;
+    unsigned drawCount = 0;
+};
+
+TEST(PartialRedraw, onlyDirtyRegionIsRedrawn) {
+    FakeDisplay display;
+    TestElement a {display, {0, 0, 32, 16}};
+    TestElement b {display, {64, 32, 32, 16}};
+    TestElement c {display, {80, 40, 40, 8}}; // overlaps with b
+    a.dirty = b.dirty = c.dirty = false;
+
+    b.dirty = true;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, ElementsAre("clear 64,32,32,16", "background",
+                                         "display 64,32,32,16"));
+    EXPECT_EQ(a.drawCount, 0u);
+    EXPECT_EQ(b.drawCount, 1u);
+    EXPECT_EQ(c.drawCount, 1u);
+
+    // Nothing changed, nothing is drawn
+    display.log.clear();
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, IsEmpty());
+}
+
+TEST(PartialRedraw, unionOfDirtyRegions) {
+    FakeDisplay display;
+    TestElement a {display, {0, 0, 32, 16}};
+    TestElement b {display, {64, 32, 32, 16}};
+    TestElement c {display, {100, 0, 28, 8}};
+    a.dirty = b.dirty = c.dirty = false;
+
+    a.dirty = b.dirty = true;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, ElementsAre("clear 0,0,96,48", "background",
+                                         "display 0,0,96,48"));
+    EXPECT_EQ(a.drawCount, 1u);
+    EXPECT_EQ(b.drawCount, 1u);
+    EXPECT_EQ(c.drawCount, 0u);
+}
+
+TEST(PartialRedraw, defaultBoundingBoxIsFullRedraw) {
+    FakeDisplay display;
+    TestElement a {display, {0, 0, 32, 16}};
+    TestElement b {display};
+    a.dirty = false;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, ElementsAre("clear", "background", "display"));
+    EXPECT_EQ(a.drawCount, 1u);
+    EXPECT_EQ(b.drawCount, 1u);
+}
+
+TEST(PartialRedraw, displayWithoutBoundsIsFullRedraw) {
+    FakeDisplay display {{0, 0, 0, 0}};
+    TestElement a {display, {0, 0, 32, 16}};
+    TestElement b {display, {64, 32, 32, 16}};
+    b.dirty = false;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, ElementsAre("clear", "background", "display"));
+    EXPECT_EQ(a.drawCount, 1u);
+    EXPECT_EQ(b.drawCount, 1u);
+}
+
+TEST(PartialRedraw, offScreenElementIsDrawnButNotSent) {
+    FakeDisplay display;
+    TestElement a {display, {0, 0, 32, 16}};
+    TestElement b {display, {200, 100, 32, 16}};
+    a.dirty = false;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, IsEmpty());
+    EXPECT_EQ(a.drawCount, 0u);
+    EXPECT_EQ(b.drawCount, 1u);
+    EXPECT_FALSE(b.getDirty());
+}
+
+TEST(PartialRedraw, regionIsClippedToDisplay) {
+    FakeDisplay display;
+    TestElement a {display, {0, 0, 32, 16}};
+    TestElement b {display, {120, 60, 32, 16}};
+    a.dirty = false;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display.log, ElementsAre("clear 120,60,8,4", "background",
+                                         "display 120,60,8,4"));
+}
+
+TEST(PartialRedraw, separateDisplays) {
+    FakeDisplay display1, display2;
+    TestElement a {display1, {0, 0, 32, 16}};
+    TestElement b {display1, {64, 32, 32, 16}};
+    TestElement c {display2, {0, 0, 32, 16}};
+    a.dirty = c.dirty = false;
+    Control_Surface.updateDisplays();
+    EXPECT_THAT(display1.log, ElementsAre("clear 64,32,32,16", "background",
+                                          "display 64,32,32,16"));
+    EXPECT_THAT(display2.log, IsEmpty());
+    EXPECT_EQ(c.drawCount, 0u);
+}
+
+struct TestSelector : SelectorBase {};
+
+TEST(PartialRedraw, selectorDisplayFitsLongestNumber) {
+    FakeDisplay display;
+    TestSelector selector;
+    SelectorDisplay a {display, selector, 1, 1, {0, 0}, 2, WHITE};
+    EXPECT_EQ(a.getBoundingBox(), (PixelRegion {0, 0, 3 * 12, 16}));
+    SelectorDisplay b {display, selector, -1, -100, {0, 16}, 1, WHITE};
+    EXPECT_EQ(b.getBoundingBox(), (PixelRegion {0, 16, 6 * 6, 8}));
+    OutputBank bank;
+    BankDisplay c {display, bank, -1000, {0, 24}, 1, WHITE};
+    EXPECT_EQ(c.getBoundingBox(), (PixelRegion {0, 24, 5 * 6, 8}));
+}
+
+TEST(PartialRedraw, wrappedTextIsFullRedraw) {
+    FakeDisplay display;
+    TestSelector selector;
+    // "-25401" doesn't fit on the first line, so it's wrapped
+    SelectorDisplay a {display, selector, -1, -100, {96, 0}, 1, WHITE};
+    PixelRegion fullDisplay {-0x4000, -0x4000, 0x7FFF, 0x7FFF};
+    EXPECT_EQ(a.getBoundingBox(), fullDisplay);
+    SelectorDisplay b {display, selector, -1, -100, {92, 0}, 1, WHITE};
+    EXPECT_EQ(b.getBoundingBox(), (PixelRegion {92, 0, 36, 8}));
+}
+
+TEST(PixelRegion, operations) {
+    PixelRegion a {0, 0, 10, 10}, b {5, 5, 10, 10}, c {10, 0, 5, 5};
+    EXPECT_TRUE(a.intersects(b));
+    EXPECT_FALSE(a.intersects(c)); // touching edges don't intersect
+    EXPECT_EQ(a.intersection(b), (PixelRegion {5, 5, 5, 5}));
+    EXPECT_TRUE(a.intersection(c).isEmpty());
+    EXPECT_EQ(a.merge(b), (PixelRegion {0, 0, 15, 15}));
+    EXPECT_EQ(a.merge({0, 0, 0, 0}), a);
+    EXPECT_TRUE(a.merge(b).contains(b));
+    EXPECT_FALSE(a.contains(b));
+}
+
+// -------------------------------------------------------------------------- //
+
+class SSD1306Window : public SSD1306_DisplayInterface {
+  public:
+    SSD1306Window(Adafruit_SSD1306 &disp, bool sendWindows)
+        : SSD1306_DisplayInterface(disp), sendWindows(sendWindows) {}
+    void drawBackground() override {}
+
+    bool displayWindow(uint8_t firstPage, uint8_t lastPage,
+                       uint8_t firstColumn, uint8_t lastColumn) override {
+        if (!sendWindows)
+            return SSD1306_DisplayInterface::displayWindow(
+                firstPage, lastPage, firstColumn, lastColumn);
+        windows.push_back({firstPage, lastPage, firstColumn, lastColumn});
+        return true;
+    }
+
+    bool sendWindows;
+    std::vector<std::vector<uint8_t>> windows;
+};
+
+TEST(SSD1306_DisplayInterface, windowIsAlignedToPages) {
+    Adafruit_SSD1306 ssd1306;
+    SSD1306Window display {ssd1306, true};
+    EXPECT_EQ(display.getBounds(), (PixelRegion {0, 0, 128, 64}));
+    display.display(10, 5, 20, 12);
+    display.display(0, 8, 128, 8);
+    display.display(120, 60, 20, 20); // clipped
+    display.display(130, 0, 10, 10);  // off-screen
+    using W = std::vector<uint8_t>;
+    EXPECT_THAT(display.windows,
+                ElementsAre(W {0, 2, 10, 29}, W {1, 1, 0, 127},
+                            W {7, 7, 120, 127}));
+    EXPECT_EQ(ssd1306.displayCount, 0u);
+}
+
+TEST(SSD1306_DisplayInterface, fallbackToFullDisplay) {
+    Adafruit_SSD1306 ssd1306;
+    SSD1306Window display {ssd1306, false};
+    display.display(10, 5, 20, 12);
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+}
+
+TEST(SSD1306_DisplayInterface, clearRegionOnlyClearsRegion) {
+    Adafruit_SSD1306 ssd1306;
+    SSD1306Window display {ssd1306, true};
+    ssd1306.fillScreen(WHITE);
+    display.clearRegion(8, 8, 8, 8);
+    const uint8_t *buffer = ssd1306.getBuffer();
+    EXPECT_EQ(buffer[7 + 128], 0xFF);
+    for (uint8_t col = 8; col < 16; ++col)
+        EXPECT_EQ(buffer[col + 128], 0x00);
+    EXPECT_EQ(buffer[16 + 128], 0xFF);
+    EXPECT_EQ(buffer[8], 0xFF);
+    EXPECT_EQ(buffer[8 + 256], 0xFF);
+}
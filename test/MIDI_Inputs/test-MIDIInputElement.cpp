@@ -117,3 +117,155 @@ TEST(TwoByteRangeMIDIMatcher, ControlChange) {
         {MIDIMessageType::CONTROL_CHANGE, CHANNEL_10, 0x18, 0x43});
     testing::Mock::VerifyAndClear(&mn);
 }
+
+#if MIDI_INPUT_ELEMENT_INDEX
+
+TEST(MIDIInputElementIndex, disableEnable) {
+    NoteValue a{{0x3C, CHANNEL_5}};
+    NoteValue b{{0x3D, CHANNEL_5}};
+
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3D, 0x7E});
+    EXPECT_EQ(a.getValue(), 0x00);
+    EXPECT_EQ(b.getValue(), 0x7E);
+
+    b.disable();
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3D, 0x7D});
+    EXPECT_EQ(b.getValue(), 0x7E);
+
+    b.enable();
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3D, 0x7C});
+    EXPECT_EQ(b.getValue(), 0x7C);
+}
+
+TEST(MIDIInputElementIndex, destroyedElement) {
+    NoteValue a{{0x3C, CHANNEL_5}};
+    {
+        NoteValue b{{0x3C, CHANNEL_5}};
+        MIDIInputElementNote::updateAllWith(
+            {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3C, 0x7E});
+    }
+    // The index must not contain b anymore
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3C, 0x7D});
+    EXPECT_EQ(a.getValue(), 0x7D);
+}
+
+TEST(MIDIInputElementIndex, unindexedMatcher) {
+    // Matcher without an addToIndex method, must be checked linearly
+    struct CustomMatcher {
+        struct Result {
+            bool match;
+            uint8_t value;
+        };
+        Result operator()(ChannelMessage m) {
+            return {m.data1 % 2 == 1, m.data2};
+        }
+    };
+    struct M : MatchingMIDIInputElement<MIDIMessageType::NOTE_ON,
+                                        CustomMatcher> {
+        M() : MatchingMIDIInputElement({}) {}
+        MOCK_METHOD(void, handleUpdateHelper, (uint8_t));
+        void handleUpdate(CustomMatcher::Result m) override {
+            handleUpdateHelper(m.value);
+        }
+    } mn;
+    NoteValue indexed{{0x3C, CHANNEL_5}};
+
+    EXPECT_CALL(mn, handleUpdateHelper(0x12));
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_7, 0x3D, 0x12});
+    testing::Mock::VerifyAndClear(&mn);
+
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3C, 0x13});
+    EXPECT_EQ(indexed.getValue(), 0x13);
+    testing::Mock::VerifyAndClear(&mn);
+}
+
+TEST(MIDIInputElementIndex, full) {
+    // The first range fits in the index, the second one doesn't, and has to be
+    // checked linearly.
+    static_assert(MIDI_INPUT_INDEX_SIZE < 200, "");
+    NoteRange<100> a{{0x00, CHANNEL_1}};
+    NoteRange<100> b{{0x00, CHANNEL_2}};
+
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_1, 0x50, 0x12});
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_2, 0x51, 0x13});
+    EXPECT_EQ(a.getValue(0x50), 0x12);
+    EXPECT_EQ(b.getValue(0x51), 0x13);
+}
+
+TEST(MIDIInputElementIndex, bankableChangeCable) {
+    Bank<4> bank(2);
+    Bankable::NoteValue<4> mn{{bank, CHANGE_CABLENB}, {0x10, CHANNEL_3, CABLE_3}};
+
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_3, 0x10, 0x12, CABLE_9});
+    EXPECT_EQ(mn.getValue(3), 0x12);
+    MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_3, 0x10, 0x13, CABLE_10});
+    EXPECT_EQ(mn.getValue(3), 0x12);
+}
+
+#endif
+
+TEST(MIDIInputDeliveryPolicy, firstMatch) {
+    NoteValue a{{0x3C, CHANNEL_5}};
+    NoteValue b{{0x3C, CHANNEL_5}};
+
+    EXPECT_TRUE(MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3C, 0x7E}));
+    EXPECT_EQ(a.getValue() + b.getValue(), 0x7E);
+}
+
+TEST(MIDIInputDeliveryPolicy, allMatches) {
+    MIDIInputElementNote::setDeliveryPolicy(
+        MIDIInputDeliveryPolicy::ALL_MATCHES);
+    NoteValue a{{0x3C, CHANNEL_5}};
+    NoteValue b{{0x3C, CHANNEL_5}};
+    NoteRange<4> c{{0x3A, CHANNEL_5}};
+    NoteValue d{{0x3D, CHANNEL_5}};
+
+    EXPECT_TRUE(MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x3C, 0x7E}));
+    EXPECT_EQ(a.getValue(), 0x7E);
+    EXPECT_EQ(b.getValue(), 0x7E);
+    EXPECT_EQ(c.getValue(2), 0x7E);
+    EXPECT_EQ(d.getValue(), 0x00);
+
+    EXPECT_FALSE(MIDIInputElementNote::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_6, 0x3C, 0x7D}));
+    MIDIInputElementNote::setDeliveryPolicy(
+        MIDIInputDeliveryPolicy::FIRST_MATCH);
+}
+
+TEST(MIDIInputDeliveryPolicy, allMatchesLinear) {
+    // Matcher without an addToIndex method, must be checked linearly
+    struct CustomMatcher {
+        struct Result {
+            bool match;
+            uint8_t value;
+        };
+        Result operator()(ChannelMessage m) { return {true, m.data2}; }
+    };
+    struct M : MatchingMIDIInputElement<MIDIMessageType::CONTROL_CHANGE,
+                                        CustomMatcher> {
+        M() : MatchingMIDIInputElement({}) {}
+        void handleUpdate(CustomMatcher::Result m) override { value = m.value; }
+        uint8_t value = 0;
+    } a, b;
+    CCValue c{{0x10, CHANNEL_1}};
+
+    MIDIInputElementCC::setDeliveryPolicy(MIDIInputDeliveryPolicy::ALL_MATCHES);
+    EXPECT_TRUE(MIDIInputElementCC::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_1, 0x10, 0x12}));
+    EXPECT_EQ(a.value, 0x12);
+    EXPECT_EQ(b.value, 0x12);
+    EXPECT_EQ(c.getValue(), 0x12);
+    MIDIInputElementCC::setDeliveryPolicy(MIDIInputDeliveryPolicy::FIRST_MATCH);
+}
@@ -958,4 +958,128 @@ TEST(BLEMIDIPacketBuilder, sysExAddChunkEndTwoPackets) {
     EXPECT_EQ(length, 0);
     EXPECT_EQ(dataptr, nullptr);
     EXPECT_EQ(b.getPacket(), expected);
-}
\ No newline at end of file
+}
+TEST(BLEMIDIPacketBuilder, realTimeBetweenRunningStatusOptimal) {
+    BLEMIDIPacketBuilder b;
+    b.setPacking(BLEMIDIPacketBuilder::Packing::Optimal);
+    EXPECT_TRUE(b.add3B(0x92, 0x12, 0x34, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.add3B(0x92, 0x56, 0x78, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.addRealTime(0xF8, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.add3B(0x92, 0x11, 0x22, timestamp(0x01, 0x02)));
+
+    bvec expected = {
+        0x80 | 0x01, // header + timestamp msb
+        0x80 | 0x02, //          timestamp lsb
+        0x92,        // status
+        0x12,        // d1
+        0x34,        // d2
+        0x56,        // d1
+        0x78,        // d2
+        0x80 | 0x02, //          timestamp lsb
+        0xF8,        // real-time
+        0x11,        // d1
+        0x22,        // d2
+    };
+    EXPECT_EQ(b.getPacket(), expected);
+}
+
+TEST(BLEMIDIPacketBuilder, realTimeBetweenRunningStatusDifferentTimestampOptimal) {
+    BLEMIDIPacketBuilder b;
+    b.setPacking(BLEMIDIPacketBuilder::Packing::Optimal);
+    EXPECT_TRUE(b.add3B(0x92, 0x12, 0x34, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.addRealTime(0xF8, timestamp(0x01, 0x03)));
+    EXPECT_TRUE(b.add3B(0x92, 0x11, 0x22, timestamp(0x01, 0x04)));
+
+    bvec expected = {
+        0x80 | 0x01, // header + timestamp msb
+        0x80 | 0x02, //          timestamp lsb
+        0x92,        // status
+        0x12,        // d1
+        0x34,        // d2
+        0x80 | 0x03, //          timestamp lsb
+        0xF8,        // real-time
+        0x80 | 0x04, //          timestamp lsb
+        0x11,        // d1
+        0x22,        // d2
+    };
+    EXPECT_EQ(b.getPacket(), expected);
+}
+
+TEST(BLEMIDIPacketBuilder, sysCommonBetweenRunningStatusOptimal) {
+    BLEMIDIPacketBuilder b;
+    b.setPacking(BLEMIDIPacketBuilder::Packing::Optimal);
+    EXPECT_TRUE(b.add3B(0x92, 0x12, 0x34, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.addSysCommon(2, 0xF2, 0x41, 0x74, timestamp(0x01, 0x03)));
+    EXPECT_TRUE(b.add3B(0x92, 0x11, 0x22, timestamp(0x01, 0x03)));
+
+    bvec expected = {
+        0x80 | 0x01, // header + timestamp msb
+        0x80 | 0x02, //          timestamp lsb
+        0x92,        // status
+        0x12,        // d1
+        0x34,        // d2
+        0x80 | 0x03, //          timestamp lsb
+        0xF2,        // syscom
+        0x41,        // d1
+        0x74,        // d2
+        0x11,        // d1
+        0x22,        // d2
+    };
+    EXPECT_EQ(b.getPacket(), expected);
+}
+
+TEST(BLEMIDIPacketBuilder, realTimeBufferFullOptimal) {
+    for (auto packing : {BLEMIDIPacketBuilder::Packing::Compatible,
+                         BLEMIDIPacketBuilder::Packing::Optimal}) {
+        BLEMIDIPacketBuilder b {9};
+        b.setPacking(packing);
+        EXPECT_TRUE(b.add3B(0x92, 0x12, 0x34, timestamp(0x01, 0x02)));
+        EXPECT_TRUE(b.addRealTime(0xF8, timestamp(0x01, 0x02)));
+        // Only fits without the timestamp
+        EXPECT_EQ(b.add3B(0x92, 0x11, 0x22, timestamp(0x01, 0x02)),
+                  packing == BLEMIDIPacketBuilder::Packing::Optimal);
+    }
+    BLEMIDIPacketBuilder b {8};
+    b.setPacking(BLEMIDIPacketBuilder::Packing::Optimal);
+    EXPECT_TRUE(b.add3B(0x92, 0x12, 0x34, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.addRealTime(0xF8, timestamp(0x01, 0x02)));
+    EXPECT_FALSE(b.add3B(0x92, 0x11, 0x22, timestamp(0x01, 0x02)));
+    b.reset();
+    // Running status doesn't continue in the next packet
+    EXPECT_TRUE(b.add3B(0x92, 0x11, 0x22, timestamp(0x01, 0x02)));
+
+    bvec expected = {
+        0x80 | 0x01, // header + timestamp msb
+        0x80 | 0x02, //          timestamp lsb
+        0x92,        // status
+        0x11,        // d1
+        0x22,        // d2
+    };
+    EXPECT_EQ(b.getPacket(), expected);
+}
+
+TEST(BLEMIDIPacketBuilder, stats) {
+    BLEMIDIPacketBuilder b;
+    EXPECT_EQ(b.getStats().getBytesPerMessage(), 0.f);
+    EXPECT_TRUE(b.add3B(0x92, 0x12, 0x34, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.add3B(0x92, 0x56, 0x78, timestamp(0x01, 0x02)));
+    EXPECT_TRUE(b.addRealTime(0xF8, timestamp(0x01, 0x02)));
+    EXPECT_EQ(b.getMessageCount(), 3);
+    EXPECT_EQ(b.getStats().packets, 0u); // Packet not complete yet
+    b.reset();
+    EXPECT_EQ(b.getMessageCount(), 0);
+    b.reset(); // Empty packets are not counted
+    const uint8_t sysex[] = {0xF0, 0x01, 0x02, 0xF7};
+    const uint8_t *data = sysex;
+    size_t length = sizeof(sysex);
+    EXPECT_TRUE(b.addSysEx(data, length, timestamp(0x01, 0x03)));
+    EXPECT_EQ(data, nullptr);
+    b.reset();
+
+    EXPECT_EQ(b.getStats().packets, 2u);
+    EXPECT_EQ(b.getStats().messages, 4u);
+    EXPECT_EQ(b.getStats().bytes, 9u + 7u);
+    EXPECT_FLOAT_EQ(b.getStats().getBytesPerMessage(), 4.f);
+    b.resetStats();
+    EXPECT_EQ(b.getStats().messages, 0u);
+}
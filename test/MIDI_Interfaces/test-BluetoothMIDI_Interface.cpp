@@ -35,6 +35,9 @@ TEST(BluetoothMIDIInterface, notInitialized) {
 }
 
 TEST(BluetoothMIDIInterface, receiveChannelMessage) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -56,6 +59,9 @@ TEST(BluetoothMIDIInterface, receiveChannelMessage) {
 }
 
 TEST(BluetoothMIDIInterface, receiveMultipleChannelMessage) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -80,6 +86,9 @@ TEST(BluetoothMIDIInterface, receiveMultipleChannelMessage) {
 }
 
 TEST(BluetoothMIDIInterface, receiveMultipleChannelMessageRunningStatus) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -105,6 +114,9 @@ TEST(BluetoothMIDIInterface, receiveMultipleChannelMessageRunningStatus) {
 
 TEST(BluetoothMIDIInterface,
      receiveMultipleChannelMessageRunningStatusRealTime) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -131,6 +143,9 @@ TEST(BluetoothMIDIInterface,
 }
 
 TEST(BluetoothMIDIInterface, receiveMultipleTwoByteChannelMessage) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -155,6 +170,9 @@ TEST(BluetoothMIDIInterface, receiveMultipleTwoByteChannelMessage) {
 }
 
 TEST(BluetoothMIDIInterface, receiveSysEx) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -175,6 +193,9 @@ TEST(BluetoothMIDIInterface, receiveSysEx) {
 }
 
 TEST(BluetoothMIDIInterface, receiveSysEx2) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -195,6 +216,9 @@ TEST(BluetoothMIDIInterface, receiveSysEx2) {
 }
 
 TEST(BluetoothMIDIInterface, receiveSysExSplitAcrossPackets) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -217,6 +241,9 @@ TEST(BluetoothMIDIInterface, receiveSysExSplitAcrossPackets) {
 }
 
 TEST(BluetoothMIDIInterface, receiveSysExAndRealTime) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -243,6 +270,9 @@ static uint16_t timestamp(uint8_t msb, uint8_t lsb) {
 }
 
 TEST(BluetoothMIDIInterface, receiveSysCommonRunningStatusChannelMessage) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     BluetoothMIDI_Interface midi;
     midi.begin();
 
@@ -279,6 +309,9 @@ TEST(BluetoothMIDIInterface, receiveSysCommonRunningStatusChannelMessage) {
 }
 
 TEST(BluetoothMIDIInterface, emptyPacket) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -297,6 +330,9 @@ TEST(BluetoothMIDIInterface, emptyPacket) {
 }
 
 TEST(BluetoothMIDIInterface, invalidPacket) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     MockMIDI_Callbacks cb;
 
     BluetoothMIDI_Interface midi;
@@ -710,3 +746,316 @@ TEST(BluetoothMIDIInterface, sendLongSysExFlushStopSendingThread) {
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
 }
+
+#if MIDI_TIMESTAMPS
+TEST(BluetoothMIDIInterface, receiveTimestamps) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillOnce(Return(1000000));
+    MockMIDI_Callbacks cb;
+
+    BluetoothMIDI_Interface midi;
+    midi.begin();
+    midi.setCallbacks(&cb);
+
+    // Second message was sent 5 ms after the first one
+    uint8_t data[] = {0x80, 0x80, 0x90, 0x3C, 0x7F, 0x85, 0xF8, 0x86, 0xB1, 0x10, 0x40};
+    midi.parse(data, sizeof(data));
+    midi.update();
+
+    ASSERT_EQ(cb.channelMessages.size(), 2u);
+    EXPECT_EQ(cb.channelMessages[0].getTimestamp(), 1000000u - 6000u);
+    EXPECT_EQ(cb.channelMessages[1].getTimestamp(), 1000000u);
+    ASSERT_EQ(cb.realtimeMessages.size(), 1u);
+    EXPECT_EQ(cb.realtimeMessages[0].getTimestamp(), 1000000u - 1000u);
+}
+#endif
+
+/// Records the packets sent by the background thread of the interface, and
+/// the time they were sent.
+struct PacketRecorder {
+    PacketRecorder(BluetoothMIDI_Interface &midi,
+                   std::chrono::milliseconds delay = {}) {
+        EXPECT_CALL(midi, notifyMIDIBLE(_))
+            .WillRepeatedly(Invoke(this, &PacketRecorder::record));
+        this->delay = delay;
+    }
+    void record(const std::vector<uint8_t> &packet) {
+        std::this_thread::sleep_for(delay);
+        std::lock_guard<std::mutex> lock(mtx);
+        packets.push_back(packet);
+        times.push_back(std::chrono::steady_clock::now());
+    }
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return packets.size();
+    }
+    std::mutex mtx;
+    std::chrono::milliseconds delay;
+    std::vector<std::vector<uint8_t>> packets;
+    std::vector<std::chrono::steady_clock::time_point> times;
+};
+
+/// Sends a packet for every Note On/Control Change message, because the MTU is
+/// forced to fit only a single message.
+static std::vector<uint8_t> singleMessagePacket(uint8_t header, uint8_t d1,
+                                                uint8_t d2) {
+    return {0x81, 0x82, header, d1, d2};
+}
+
+TEST(BluetoothMIDIInterface, connectionIntervalDoesNotBlock) {
+    using FlushMode = BluetoothMIDI_Interface::FlushMode;
+    std::chrono::milliseconds delay {50};
+    BluetoothMIDI_Interface midi;
+    PacketRecorder recorder {midi, delay};
+    midi.begin();
+    midi.forceMinMTU(5 + 3);
+    midi.setFlushMode(FlushMode::ConnectionInterval);
+    EXPECT_EQ(midi.getFlushMode(), FlushMode::ConnectionInterval);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .Times(3) // For time stamp
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+
+    // Sending is slow (delay), but the main thread doesn't have to wait
+    auto start = std::chrono::steady_clock::now();
+    midi.sendNoteOn({0x10, CHANNEL_1}, 0x7F);
+    midi.sendNoteOn({0x11, CHANNEL_1}, 0x7F);
+    midi.sendNoteOn({0x12, CHANNEL_1}, 0x7F);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, delay);
+
+    midi.flush();
+    std::vector<std::vector<uint8_t>> expected = {
+        singleMessagePacket(0x90, 0x10, 0x7F),
+        singleMessagePacket(0x90, 0x11, 0x7F),
+        singleMessagePacket(0x90, 0x12, 0x7F),
+    };
+    EXPECT_EQ(recorder.packets, expected);
+    EXPECT_EQ(midi.getDroppedCount(), 0u);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, connectionIntervalAligned) {
+    BluetoothMIDI_Interface midi;
+    PacketRecorder recorder {midi};
+    midi.begin();
+    midi.forceMinMTU(5 + 3);
+    midi.setFlushMode(BluetoothMIDI_Interface::FlushMode::ConnectionInterval);
+    BluetoothMIDI_Interface::midi_conn_interval_callback(16); // 20 ms
+    EXPECT_EQ(midi.getConnectionInterval(), std::chrono::milliseconds(20));
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .Times(3) // For time stamp
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+
+    midi.sendControlChange({0x10, CHANNEL_2}, 0x01);
+    midi.sendControlChange({0x11, CHANNEL_2}, 0x02);
+    midi.sendControlChange({0x12, CHANNEL_2}, 0x03);
+
+    // Wait for the sender thread to send all packets
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (recorder.size() < 3 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<std::vector<uint8_t>> expected = {
+        singleMessagePacket(0xB1, 0x10, 0x01),
+        singleMessagePacket(0xB1, 0x11, 0x02),
+        singleMessagePacket(0xB1, 0x12, 0x03),
+    };
+    std::lock_guard<std::mutex> lock(recorder.mtx);
+    ASSERT_EQ(recorder.packets, expected);
+    // At most one packet per connection interval (the packets are sent on
+    // a 20 ms grid, allow for the scheduling jitter of the sender thread)
+    for (size_t i = 1; i < recorder.times.size(); ++i)
+        EXPECT_GE(recorder.times[i] - recorder.times[i - 1],
+                  std::chrono::milliseconds(10));
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, connectionIntervalDropSupersededCC) {
+    using FlushMode = BluetoothMIDI_Interface::FlushMode;
+    constexpr uint8_t N = BluetoothMIDI_Interface::SendQueueSize;
+    BluetoothMIDI_Interface midi;
+    PacketRecorder recorder {midi};
+    midi.begin();
+    midi.forceMinMTU(5 + 3);
+    midi.setFlushMode(FlushMode::ConnectionInterval);
+    // Long interval, so nothing is sent until we flush
+    BluetoothMIDI_Interface::midi_conn_interval_callback(0xFFFF);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+
+    // First message goes in the packet, the next N in the queue: two values
+    // for each of N / 2 controllers
+    midi.sendNoteOn({0x40, CHANNEL_1}, 0x7F);
+    for (uint8_t v = 0; v < 2; ++v)
+        for (uint8_t i = 0; i < N / 2; ++i)
+            midi.sendControlChange({i, CHANNEL_1}, v);
+    // Queue is full, drop the oldest CCs that have a newer value queued
+    midi.sendNoteOn({0x41, CHANNEL_1}, 0x7F);
+    midi.sendControlChange({0x50, CHANNEL_1}, 0x50);
+    EXPECT_EQ(midi.getDroppedCount(), 2u);
+    EXPECT_EQ(recorder.size(), 0u);
+
+    midi.flush();
+    std::vector<std::vector<uint8_t>> expected;
+    expected.push_back(singleMessagePacket(0x90, 0x40, 0x7F));
+    for (uint8_t i = 2; i < N / 2; ++i)
+        expected.push_back(singleMessagePacket(0xB0, i, 0));
+    for (uint8_t i = 0; i < N / 2; ++i)
+        expected.push_back(singleMessagePacket(0xB0, i, 1));
+    expected.push_back(singleMessagePacket(0x90, 0x41, 0x7F));
+    expected.push_back(singleMessagePacket(0xB0, 0x50, 0x50));
+    EXPECT_EQ(recorder.packets, expected);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, connectionIntervalKeepFinalCCValues) {
+    using FlushMode = BluetoothMIDI_Interface::FlushMode;
+    constexpr uint8_t N = BluetoothMIDI_Interface::SendQueueSize;
+    BluetoothMIDI_Interface midi;
+    PacketRecorder recorder {midi};
+    midi.begin();
+    midi.forceMinMTU(5 + 3);
+    midi.setFlushMode(FlushMode::ConnectionInterval);
+    BluetoothMIDI_Interface::midi_conn_interval_callback(0xFFFF);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+
+    // One value for N + 1 different controllers (and cables)
+    for (uint8_t i = 0; i < N; ++i)
+        midi.sendControlChange({i, CHANNEL_1}, 0x01);
+    midi.sendControlChange({0x00, CHANNEL_1, CABLE_2}, 0x01);
+    EXPECT_EQ(recorder.size(), 0u);
+    // Nothing can be dropped without losing the final value of a controller,
+    // so wait for the first packet to be sent instead
+    midi.sendControlChange({0x60, CHANNEL_2}, 0x02);
+    EXPECT_EQ(midi.getDroppedCount(), 0u);
+    EXPECT_EQ(recorder.size(), 1u);
+    // A new value for a queued controller replaces the old one
+    midi.sendControlChange({0x05, CHANNEL_1}, 0x03);
+    EXPECT_EQ(midi.getDroppedCount(), 1u);
+    EXPECT_EQ(recorder.size(), 1u);
+
+    midi.flush();
+    std::vector<std::vector<uint8_t>> expected;
+    for (uint8_t i = 0; i < N; ++i)
+        if (i != 0x05)
+            expected.push_back(singleMessagePacket(0xB0, i, 0x01));
+    expected.push_back({0x81, 0x82, 0xB0, 0x00, 0x01}); // cable is not sent
+    expected.push_back(singleMessagePacket(0xB1, 0x60, 0x02));
+    expected.push_back(singleMessagePacket(0xB0, 0x05, 0x03));
+    EXPECT_EQ(recorder.packets, expected);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, connectionIntervalQueueFullNoCC) {
+    using FlushMode = BluetoothMIDI_Interface::FlushMode;
+    constexpr uint8_t N = BluetoothMIDI_Interface::SendQueueSize;
+    BluetoothMIDI_Interface midi;
+    PacketRecorder recorder {midi};
+    midi.begin();
+    midi.forceMinMTU(5 + 3);
+    midi.setFlushMode(FlushMode::ConnectionInterval);
+    BluetoothMIDI_Interface::midi_conn_interval_callback(0xFFFF);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+
+    for (uint8_t i = 0; i <= N; ++i)
+        midi.sendNoteOn({i, CHANNEL_1}, 0x7F);
+    EXPECT_EQ(recorder.size(), 0u);
+    // A new CC doesn't supersede anything in the queue, so it waits for the
+    // first packet to be sent
+    midi.sendControlChange({0x50, CHANNEL_1}, 0x50);
+    EXPECT_EQ(midi.getDroppedCount(), 0u);
+    EXPECT_EQ(recorder.size(), 1u);
+    // Notes are never dropped, wait for the next packet to be sent as well
+    midi.sendNoteOn({0x60, CHANNEL_1}, 0x7F);
+    EXPECT_EQ(recorder.size(), 2u);
+
+    midi.flush();
+    std::vector<std::vector<uint8_t>> expected;
+    for (uint8_t i = 0; i <= N; ++i)
+        expected.push_back(singleMessagePacket(0x90, i, 0x7F));
+    expected.push_back(singleMessagePacket(0xB0, 0x50, 0x50));
+    expected.push_back(singleMessagePacket(0x90, 0x60, 0x7F));
+    EXPECT_EQ(recorder.packets, expected);
+
+    // Switching back to the timeout mode sends the queue
+    midi.sendNoteOn({0x61, CHANNEL_1}, 0x7F);
+    midi.sendNoteOn({0x62, CHANNEL_1}, 0x7F);
+    midi.setFlushMode(FlushMode::Timeout);
+    EXPECT_EQ(recorder.size(), N + 4u);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, sendOptimalPacking) {
+    BluetoothMIDI_Interface midi;
+    midi.begin();
+    midi.setPacking(BLEMIDIPacketBuilder::Packing::Optimal);
+
+    std::vector<uint8_t> expected = {
+        0x81, 0x82, 0x92, 0x12, 0x34, 0x82, 0xF8, 0x56, 0x78,
+    };
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .Times(3) // For time stamp
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+    EXPECT_CALL(midi, notifyMIDIBLE(expected));
+
+    midi.sendNoteOn({0x12, CHANNEL_3}, 0x34);
+    midi.sendTimingClock();
+    midi.sendNoteOn({0x56, CHANNEL_3}, 0x78);
+    midi.flush();
+
+    EXPECT_EQ(midi.getPackingStats().messages, 3u);
+    EXPECT_EQ(midi.getPackingStats().bytes, expected.size());
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, receiveOptimalPacking) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
+    BluetoothMIDI_Interface midi;
+    midi.begin();
+
+    uint8_t data[] = {
+        0x80 | 0x01, // header + timestamp msb
+        0x80 | 0x02, //          timestamp lsb
+        0x92,        // status
+        0x12,        // d1
+        0x34,        // d2
+        0x80 | 0x02, //          timestamp lsb
+        0xF8,        // real-time
+        0x56,        // d1
+        0x78,        // d2
+        0x80 | 0x03, //          timestamp lsb
+        0xF2,        // syscom
+        0x41,        // d1
+        0x74,        // d2
+        0x11,        // d1
+        0x22,        // d2
+    };
+
+    midi.parse(data, sizeof(data));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(midi.getChannelMessage(), ChannelMessage(0x92, 0x12, 0x34));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(midi.getRealTimeMessage(), RealTimeMessage(0xF8));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(midi.getChannelMessage(), ChannelMessage(0x92, 0x56, 0x78));
+    EXPECT_EQ(midi.getTimestamp(), timestamp(0x01, 0x02));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::SYSCOMMON_MESSAGE);
+    EXPECT_EQ(midi.getSysCommonMessage(), SysCommonMessage(0xF2, 0x41, 0x74));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(midi.getChannelMessage(), ChannelMessage(0x92, 0x11, 0x22));
+    EXPECT_EQ(midi.getTimestamp(), timestamp(0x01, 0x03));
+}
@@ -0,0 +1,292 @@
+#include <MIDI_Interfaces/BufferedMIDI_Pipe.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+USING_CS_NAMESPACE;
+using ::testing::InSequence;
+using ::testing::StrictMock;
+
+struct MockMIDI_Sink : TrueMIDI_Sink {
+    MOCK_METHOD(void, sinkMIDIfromPipe, (ChannelMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysExMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysCommonMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (RealTimeMessage), (override));
+};
+
+struct TestStaller : MIDIStaller {
+    TestStaller(MIDI_Source &source) : source(source) {}
+    void handleStall() override { source.unstall(this); }
+    MIDI_Source &source;
+};
+
+TEST(BufferedMIDI_Pipe, queueAndDrain) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<8> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    ChannelMessage chmsg{0x93, 0x10, 0x7F};
+    SysCommonMessage scmsg{MIDIMessageType::SONG_SELECT, 3};
+    RealTimeMessage rtmsg{0xF8, CABLE_5};
+    source.sourceMIDItoPipe(chmsg);
+    source.sourceMIDItoPipe(scmsg);
+    source.sourceMIDItoPipe(rtmsg);
+    EXPECT_EQ(pipe.getQueueSize(), 3);
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(chmsg));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(scmsg));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(rtmsg));
+    pipe.update();
+    EXPECT_EQ(pipe.getQueueSize(), 0);
+}
+
+TEST(BufferedMIDI_Pipe, updateAll) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    ChannelMessage chmsg{0x93, 0x10, 0x7F};
+    source.sourceMIDItoPipe(chmsg);
+    EXPECT_CALL(sink, sinkMIDIfromPipe(chmsg));
+    AH::Updatable<>::updateAll();
+}
+
+#if MIDI_TIMESTAMPS
+TEST(BufferedMIDI_Pipe, preserveTimestamps) {
+    struct TimestampSink : TrueMIDI_Sink {
+        void sinkMIDIfromPipe(ChannelMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        void sinkMIDIfromPipe(SysExMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        void sinkMIDIfromPipe(SysCommonMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        void sinkMIDIfromPipe(RealTimeMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        std::vector<uint32_t> timestamps;
+    } sink;
+    BufferedMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    ChannelMessage chmsg{0x93, 0x10, 0x7F};
+    chmsg.setTimestamp(1);
+    SysCommonMessage scmsg{MIDIMessageType::TUNE_REQUEST};
+    scmsg.setTimestamp(2);
+    RealTimeMessage rtmsg{0xF8};
+    rtmsg.setTimestamp(3);
+    uint8_t data[] = {0xF0, 0x01, 0xF7};
+    SysExMessage sxmsg{data};
+    sxmsg.setTimestamp(4);
+    source.sourceMIDItoPipe(chmsg);
+    source.sourceMIDItoPipe(scmsg);
+    source.sourceMIDItoPipe(rtmsg);
+    source.sourceMIDItoPipe(sxmsg);
+    pipe.update();
+
+    std::vector<uint32_t> expected = {1, 2, 3, 4};
+    EXPECT_EQ(sink.timestamps, expected);
+}
+#endif
+
+TEST(BufferedMIDI_Pipe, maxMessagesPerUpdate) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<8> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+    pipe.setMaxMessagesPerUpdate(2);
+
+    for (uint8_t i = 0; i < 5; ++i)
+        source.sourceMIDItoPipe(ChannelMessage{0x90, i, 0x7F});
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 0, 0x7F}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 1, 0x7F}));
+    pipe.update();
+    EXPECT_EQ(pipe.getQueueSize(), 3);
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 2, 0x7F}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 3, 0x7F}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 4, 0x7F}));
+    pipe.flush();
+    EXPECT_EQ(pipe.getQueueSize(), 0);
+}
+
+TEST(BufferedMIDI_Pipe, sysexIsQueued) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<8> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    ChannelMessage chmsg{0x93, 0x10, 0x7F};
+    uint8_t data1[] = {0xF0, 0x01, 0xF7};
+    uint8_t data2[] = {0xF0, 0x02, 0x03, 0xF7};
+    source.sourceMIDItoPipe(chmsg);
+    source.sourceMIDItoPipe(SysExMessage{data1, CABLE_3});
+    source.sourceMIDItoPipe(SysExMessage{data2});
+    EXPECT_EQ(pipe.getQueueSize(), 3);
+    // The data is copied, the source can reuse its buffer
+    data1[1] = data2[1] = 0x7F;
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    uint8_t expected1[] = {0xF0, 0x01, 0xF7};
+    uint8_t expected2[] = {0xF0, 0x02, 0x03, 0xF7};
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(chmsg));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(SysExMessage{expected1, CABLE_3}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(SysExMessage{expected2}));
+    pipe.update();
+    EXPECT_EQ(pipe.getQueueSize(), 0);
+}
+
+TEST(BufferedMIDI_Pipe, sysexBufferFull) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<8, 8> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    uint8_t data1[] = {0xF0, 0x01, 0x02, 0x03, 0xF7};
+    uint8_t data2[] = {0xF0, 0x04, 0xF7};
+    uint8_t data3[] = {0xF0, 0x05, 0x06, 0xF7};
+    source.sourceMIDItoPipe(SysExMessage{data1});
+    source.sourceMIDItoPipe(SysExMessage{data2});
+    source.sourceMIDItoPipe(SysExMessage{data3}); // doesn't fit, dropped
+    EXPECT_EQ(pipe.getQueueSize(), 2);
+    EXPECT_EQ(pipe.getOverflowCount(), 1u);
+
+    {
+        InSequence seq;
+        EXPECT_CALL(sink, sinkMIDIfromPipe(SysExMessage{data1}));
+        EXPECT_CALL(sink, sinkMIDIfromPipe(SysExMessage{data2}));
+    }
+    pipe.update();
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    // The buffer is reused once it has been drained
+    source.sourceMIDItoPipe(SysExMessage{data3});
+    EXPECT_CALL(sink, sinkMIDIfromPipe(SysExMessage{data3}));
+    pipe.update();
+    EXPECT_EQ(pipe.getOverflowCount(), 1u);
+}
+
+TEST(BufferedMIDI_Pipe, backpressure) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    for (uint8_t i = 0; i < 3; ++i)
+        source.sourceMIDItoPipe(ChannelMessage{0x90, i, 0x7F});
+    EXPECT_FALSE(source.isStalled());
+    source.sourceMIDItoPipe(ChannelMessage{0x90, 3, 0x7F});
+    // Queue is full, the source is notified
+    EXPECT_TRUE(source.isStalled());
+    EXPECT_STREQ(source.getStallerName(), "BufferedMIDI_Pipe");
+
+    // Draining until the queue is half full un-stalls the pipe
+    pipe.setMaxMessagesPerUpdate(1);
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 0, 0x7F}));
+    pipe.update();
+    EXPECT_TRUE(source.isStalled());
+    ::testing::Mock::VerifyAndClear(&sink);
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 1, 0x7F}));
+    pipe.update();
+    EXPECT_FALSE(source.isStalled());
+    ::testing::Mock::VerifyAndClear(&sink);
+    EXPECT_EQ(pipe.getOverflowCount(), 0u);
+}
+
+TEST(BufferedMIDI_Pipe, sendWhileFull) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    for (uint8_t i = 0; i < 4; ++i)
+        source.sourceMIDItoPipe(ChannelMessage{0x90, i, 0x7F});
+    EXPECT_TRUE(source.isStalled());
+
+    // Sending anyway doesn't block the source, the message is dropped
+    source.sourceMIDItoPipe(ChannelMessage{0x90, 4, 0x7F});
+    source.sourceMIDItoPipe(RealTimeMessage{0xF8});
+    EXPECT_TRUE(source.isStalled());
+    EXPECT_EQ(pipe.getQueueSize(), 4);
+    EXPECT_EQ(pipe.getOverflowCount(), 2u);
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    InSequence seq;
+    for (uint8_t i = 0; i < 4; ++i)
+        EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, i, 0x7F}));
+    pipe.update();
+    EXPECT_FALSE(source.isStalled());
+}
+
+TEST(BufferedMIDI_Pipe, otherSourceDoesntDrainQueue) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<2> pipe1;
+    MIDI_Pipe pipe2;
+    TrueMIDI_Source source1, source2;
+    source1 >> pipe1 >> sink;
+    source2 >> pipe2 >> sink;
+
+    source1.sourceMIDItoPipe(ChannelMessage{0x90, 0, 0x7F});
+    source1.sourceMIDItoPipe(ChannelMessage{0x90, 1, 0x7F});
+    EXPECT_TRUE(source2.isStalled());
+
+    // Pipe 2 doesn't have to wait for the queue of pipe 1 to be drained
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x91, 2, 0x7F}));
+    source2.sourceMIDItoPipe(ChannelMessage{0x91, 2, 0x7F});
+    EXPECT_EQ(pipe1.getQueueSize(), 2);
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 0, 0x7F}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 1, 0x7F}));
+    pipe1.update();
+    EXPECT_FALSE(source1.isStalled());
+    EXPECT_FALSE(source2.isStalled());
+}
+
+TEST(BufferedMIDI_Pipe, dontDrainWhileStalledByOther) {
+    StrictMock<MockMIDI_Sink> sink;
+    BufferedMIDI_Pipe<4> pipe1;
+    MIDI_Pipe pipe2;
+    TrueMIDI_Source source1, source2;
+    source1 >> pipe1 >> sink;
+    source2 >> pipe2 >> sink;
+
+    ChannelMessage chmsg{0x90, 0, 0x7F};
+    source1.sourceMIDItoPipe(chmsg);
+    TestStaller staller{source2};
+    source2.stall(&staller);
+    // The other source is in the middle of a message, don't interleave
+    pipe1.update();
+    EXPECT_EQ(pipe1.getQueueSize(), 1);
+    source2.unstall(&staller);
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(chmsg));
+    pipe1.update();
+    EXPECT_EQ(pipe1.getQueueSize(), 0);
+}
+
+TEST(BufferedMIDI_Pipe, factory) {
+    StrictMock<MockMIDI_Sink> sink1, sink2;
+    BufferedMIDI_PipeFactory<2, 4> pipes;
+    TrueMIDI_Source source;
+    source >> pipes >> sink1;
+    source >> pipes >> sink2;
+
+    ChannelMessage chmsg{0x90, 0, 0x7F};
+    source.sourceMIDItoPipe(chmsg);
+    EXPECT_CALL(sink1, sinkMIDIfromPipe(chmsg));
+    EXPECT_CALL(sink2, sinkMIDIfromPipe(chmsg));
+    pipes[0].update();
+    pipes[1].update();
+}
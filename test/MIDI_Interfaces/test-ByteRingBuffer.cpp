@@ -0,0 +1,91 @@
+#include <MIDI_Interfaces/Util/ByteRingBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace CS;
+
+using u8vec = std::vector<uint8_t>;
+
+TEST(ByteRingBuffer, pushPop) {
+    ByteRingBuffer<4> ring;
+    uint8_t byte;
+    EXPECT_FALSE(ring.pop(byte));
+    for (uint8_t i = 0; i < 4; ++i)
+        EXPECT_TRUE(ring.push(i));
+    EXPECT_FALSE(ring.push(4));
+    EXPECT_EQ(ring.available(), 4);
+    for (uint8_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.pop(byte));
+        EXPECT_EQ(byte, i);
+    }
+    EXPECT_FALSE(ring.pop(byte));
+    EXPECT_EQ(ring.available(), 0);
+}
+
+TEST(ByteRingBuffer, blockWrapAround) {
+    ByteRingBuffer<8> ring;
+    uint8_t out[8];
+    // Move the indices so the next block wraps around the end of the buffer
+    u8vec first = {1, 2, 3, 4, 5};
+    EXPECT_EQ(ring.push(first.data(), 5), 5);
+    EXPECT_EQ(ring.pop(out, 5), 5);
+    u8vec second = {6, 7, 8, 9, 10, 11, 12, 13, 14};
+    EXPECT_EQ(ring.push(second.data(), 9), 8);
+    EXPECT_EQ(ring.available(), 8);
+    // The contiguous read span stops at the end of the buffer
+    const uint8_t *span;
+    EXPECT_EQ(ring.getReadSpan(span), 3);
+    EXPECT_EQ(u8vec(span, span + 3), u8vec({6, 7, 8}));
+    EXPECT_EQ(ring.pop(out, 8), 8);
+    EXPECT_EQ(u8vec(out, out + 8), u8vec({6, 7, 8, 9, 10, 11, 12, 13}));
+}
+
+TEST(ByteRingBuffer, writeSpanCommit) {
+    ByteRingBuffer<8> ring;
+    uint8_t out[8];
+    EXPECT_EQ(ring.push(u8vec(6).data(), 6), 6);
+    EXPECT_EQ(ring.pop(out, 4), 4);
+    // Free space: two bytes at the end, four at the start
+    uint8_t *span;
+    ASSERT_EQ(ring.getWriteSpan(span), 2);
+    span[0] = 0x11, span[1] = 0x22;
+    ring.commit(2);
+    ASSERT_EQ(ring.getWriteSpan(span), 4);
+    span[0] = 0x33;
+    ring.commit(1);
+    EXPECT_EQ(ring.available(), 5);
+    EXPECT_EQ(ring.pop(out, 8), 5);
+    EXPECT_EQ(u8vec(out, out + 5), u8vec({0, 0, 0x11, 0x22, 0x33}));
+}
+
+TEST(ByteRingBuffer, producerThread) {
+    ByteRingBuffer<64> ring;
+    constexpr size_t count = 100000;
+    std::thread producer([&] {
+        for (size_t i = 0; i < count;) {
+            uint8_t block[7];
+            uint16_t n = std::min<size_t>(sizeof(block), count - i);
+            for (uint16_t j = 0; j < n; ++j)
+                block[j] = uint8_t(i + j);
+            i += ring.push(block, n);
+            std::this_thread::yield();
+        }
+    });
+    size_t received = 0;
+    bool ordered = true;
+    while (received < count) {
+        const uint8_t *span;
+        uint16_t n = ring.getReadSpan(span);
+        for (uint16_t j = 0; j < n; ++j)
+            ordered &= span[j] == uint8_t(received + j);
+        ring.release(n);
+        received += n;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(ring.available(), 0);
+}
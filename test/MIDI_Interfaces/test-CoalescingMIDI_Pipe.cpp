@@ -0,0 +1,173 @@
+#include <MIDI_Interfaces/CoalescingMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/MIDI_Staller.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+USING_CS_NAMESPACE;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::StrictMock;
+
+struct MockMIDI_Sink : TrueMIDI_Sink {
+    MOCK_METHOD(void, sinkMIDIfromPipe, (ChannelMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysExMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysCommonMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (RealTimeMessage), (override));
+};
+
+TEST(CoalescingMIDI_Pipe, keepLatestValue) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x07, 0x10});
+    source.sourceMIDItoPipe(ChannelMessage{0xE3, 0x00, 0x20});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x07, 0x11});
+    source.sourceMIDItoPipe(ChannelMessage{0xB1, 0x07, 0x30}); // other channel
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x07, 0x12, CABLE_2});
+    source.sourceMIDItoPipe(ChannelMessage{0xE3, 0x7F, 0x21});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x07, 0x13});
+    EXPECT_EQ(pipe.getPendingCount(), 4);
+    EXPECT_EQ(pipe.getCoalescedCount(), 3u);
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    // Values are forwarded in the order in which the controllers first changed
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x07, 0x13}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xE3, 0x7F, 0x21}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB1, 0x07, 0x30}));
+    EXPECT_CALL(sink,
+                sinkMIDIfromPipe(ChannelMessage{0xB0, 0x07, 0x12, CABLE_2}));
+    AH::Updatable<MIDIOutputStage>::updateAll();
+    EXPECT_EQ(pipe.getPendingCount(), 0);
+}
+
+TEST(CoalescingMIDI_Pipe, preserveOrderOfOtherMessages) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    uint8_t data[] = {0xF0, 0x01, 0xF7};
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x40, 0x7F}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0x90, 0x3C, 0x7F}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x40, 0x00}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(SysExMessage{data, sizeof(data)}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x01, 0x01}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(SysCommonMessage{0xF6, 0x00, 0x00}));
+
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x40, 0x7F});
+    source.sourceMIDItoPipe(ChannelMessage{0x90, 0x3C, 0x7F});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x40, 0x00});
+    source.sourceMIDItoPipe(SysExMessage{data, sizeof(data)});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x01, 0x01});
+    source.sourceMIDItoPipe(SysCommonMessage{0xF6, 0x00, 0x00});
+    EXPECT_EQ(pipe.getCoalescedCount(), 0u);
+}
+
+TEST(CoalescingMIDI_Pipe, realTimeImmediately) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x07, 0x10});
+    EXPECT_CALL(sink, sinkMIDIfromPipe(RealTimeMessage{0xF8}));
+    source.sourceMIDItoPipe(RealTimeMessage{0xF8});
+    ::testing::Mock::VerifyAndClear(&sink);
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x07, 0x10}));
+    pipe.update();
+}
+
+TEST(CoalescingMIDI_Pipe, dontCoalesceParameterNumbers) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    InSequence seq;
+    for (uint8_t cc : {0x65, 0x64, 0x06, 0x26, 0x60, 0x60, 0x7B})
+        EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, cc, 0x01}));
+    for (uint8_t cc : {0x65, 0x64, 0x06, 0x26, 0x60, 0x60, 0x7B})
+        source.sourceMIDItoPipe(ChannelMessage{0xB0, cc, 0x01});
+    EXPECT_EQ(pipe.getPendingCount(), 0);
+}
+
+TEST(CoalescingMIDI_Pipe, customFilter) {
+    struct RelativePipe : CoalescingMIDI_Pipe<4> {
+        bool shouldCoalesce(ChannelMessage msg) const override {
+            return msg.getData1() != 0x10 &&
+                   CoalescingMIDI_Pipe<4>::shouldCoalesce(msg);
+        }
+    };
+    StrictMock<MockMIDI_Sink> sink;
+    RelativePipe pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x10, 0x01}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x10, 0x01}));
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x10, 0x01});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x10, 0x01});
+}
+
+TEST(CoalescingMIDI_Pipe, full) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<2> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x01, 0x10});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x02, 0x10});
+    InSequence seq;
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x01, 0x10}));
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x02, 0x10}));
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x03, 0x10});
+    EXPECT_EQ(pipe.getPendingCount(), 1);
+    ::testing::Mock::VerifyAndClear(&sink);
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x03, 0x10}));
+    pipe.flush();
+}
+
+TEST(CoalescingMIDI_Pipe, window) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<4> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+    pipe.setWindow(10);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(100)) // first value
+        .WillOnce(Return(105)) // update
+        .WillOnce(Return(110)); // update
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x01, 0x10});
+    source.sourceMIDItoPipe(ChannelMessage{0xB0, 0x01, 0x11});
+    pipe.update();
+    EXPECT_EQ(pipe.getPendingCount(), 1);
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x01, 0x11}));
+    pipe.update();
+    EXPECT_EQ(pipe.getPendingCount(), 0);
+    pipe.update(); // Nothing pending, doesn't call millis
+}
+
+TEST(CoalescingMIDI_Pipe, dontFlushWhileStalled) {
+    StrictMock<MockMIDI_Sink> sink;
+    CoalescingMIDI_Pipe<4> pipe1;
+    MIDI_Pipe pipe2;
+    TrueMIDI_Source source1, source2;
+    source1 >> pipe1 >> sink;
+    source2 >> pipe2 >> sink;
+
+    source1.sourceMIDItoPipe(ChannelMessage{0xB0, 0x01, 0x10});
+    source2.stall();
+    pipe1.update();
+    EXPECT_EQ(pipe1.getPendingCount(), 1);
+    source2.unstall();
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{0xB0, 0x01, 0x10}));
+    pipe1.update();
+}
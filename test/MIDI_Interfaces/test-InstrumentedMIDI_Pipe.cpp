@@ -0,0 +1,144 @@
+#include <MIDI_Interfaces/InstrumentedMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/MIDI_Staller.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <TestStream.hpp>
+
+USING_CS_NAMESPACE;
+using ::testing::Return;
+
+struct DummyMIDI_Sink : TrueMIDI_Sink {
+    void sinkMIDIfromPipe(ChannelMessage) override {}
+    void sinkMIDIfromPipe(SysExMessage) override {}
+    void sinkMIDIfromPipe(SysCommonMessage) override {}
+    void sinkMIDIfromPipe(RealTimeMessage) override {}
+};
+
+TEST(InstrumentedMIDI_Pipe, countMessages) {
+    DummyMIDI_Sink sink;
+    InstrumentedMIDI_Pipe pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillOnce(Return(1000))
+        .WillOnce(Return(1010)) // 10 µs
+        .WillOnce(Return(2000))
+        .WillOnce(Return(2002)) // 2 µs
+        .WillOnce(Return(3000))
+        .WillOnce(Return(3030)) // 30 µs
+        .WillOnce(Return(4000))
+        .WillOnce(Return(4002)) // 2 µs
+        .WillOnce(Return(5000))
+        .WillOnce(Return(5004)); // 4 µs
+
+    uint8_t sysex[] = {0xF0, 0x01, 0x02, 0x03, 0xF7};
+    source.sourceMIDItoPipe(ChannelMessage{0x93, 0x10, 0x7F});
+    source.sourceMIDItoPipe(ChannelMessage{0xC3, 0x10, 0x00});
+    source.sourceMIDItoPipe(SysExMessage{sysex, sizeof(sysex)});
+    source.sourceMIDItoPipe(SysCommonMessage{MIDIMessageType::SONG_SELECT, 3});
+    source.sourceMIDItoPipe(RealTimeMessage{0xF8});
+
+    const MIDI_PipeStats &stats = pipe.getStats();
+    EXPECT_EQ(stats.channel.messages, 2u);
+    EXPECT_EQ(stats.channel.bytes, 5u);
+    EXPECT_EQ(stats.sysex.messages, 1u);
+    EXPECT_EQ(stats.sysex.bytes, 5u);
+    EXPECT_EQ(stats.syscommon.messages, 1u);
+    EXPECT_EQ(stats.syscommon.bytes, 2u);
+    EXPECT_EQ(stats.realtime.messages, 1u);
+    EXPECT_EQ(stats.realtime.bytes, 1u);
+    EXPECT_EQ(stats.getMessageCount(), 5u);
+    EXPECT_EQ(stats.getByteCount(), 13u);
+    EXPECT_EQ(stats.drops, 0u);
+    EXPECT_EQ(stats.forwarded, 5u);
+    EXPECT_EQ(stats.getMinForwardTime(), 2u);
+    EXPECT_EQ(stats.getAverageForwardTime(), 9u);
+    EXPECT_EQ(stats.maxForwardTime, 30u);
+
+    pipe.resetStats();
+    EXPECT_EQ(pipe.getStats().getMessageCount(), 0u);
+    EXPECT_EQ(pipe.getStats().getMinForwardTime(), 0u);
+    EXPECT_EQ(pipe.getStats().maxForwardTime, 0u);
+}
+
+TEST(InstrumentedMIDI_Pipe, countDrops) {
+    InstrumentedMIDI_Pipe pipe;
+    TrueMIDI_Source source;
+    source >> pipe;
+
+    source.sourceMIDItoPipe(ChannelMessage{0x93, 0x10, 0x7F});
+    source.sourceMIDItoPipe(RealTimeMessage{0xF8});
+
+    EXPECT_EQ(pipe.getStats().getMessageCount(), 2u);
+    EXPECT_EQ(pipe.getStats().drops, 2u);
+    EXPECT_EQ(pipe.getStats().forwarded, 0u);
+}
+
+TEST(InstrumentedMIDI_Pipe, countStalls) {
+    DummyMIDI_Sink sink;
+    InstrumentedMIDI_Pipe pipe1, pipe2;
+    TrueMIDI_Source source1, source2;
+    source1 >> pipe1 >> sink;
+    source2 >> pipe2 >> sink;
+
+    MIDIStaller *cause = eternal_stall;
+    source1.stall(cause);
+    EXPECT_EQ(pipe1.getStats().sinkStalls, 1u);
+    EXPECT_EQ(pipe2.getStats().sinkStalls, 1u);
+    // Stalling again by the same cause is not a new stall event
+    source1.stall(cause);
+    EXPECT_EQ(pipe1.getStats().sinkStalls, 1u);
+    source1.unstall(cause);
+    EXPECT_FALSE(pipe1.isStalled());
+    EXPECT_FALSE(pipe2.isStalled());
+
+    source2.stall(cause);
+    source2.unstall(cause);
+    EXPECT_EQ(pipe1.getStats().sinkStalls, 2u);
+    EXPECT_EQ(pipe2.getStats().sinkStalls, 2u);
+    EXPECT_EQ(pipe1.getStats().throughStalls, 0u);
+}
+
+TEST(InstrumentedMIDI_Pipe, countThroughStalls) {
+    DummyMIDI_Sink sink1, sink2;
+    InstrumentedMIDI_Pipe pipe1, pipe2, pipe3;
+    TrueMIDI_Source source1, source2;
+    source1 >> pipe1 >> sink1;
+    source1 >> pipe2 >> sink2;
+    source2 >> pipe3 >> sink2;
+
+    // Stalling sink 2 also stalls the through output of pipe 1, because it
+    // shares its source with pipe 2
+    source2.stall();
+    EXPECT_EQ(pipe3.getStats().sinkStalls, 1u);
+    EXPECT_EQ(pipe2.getStats().sinkStalls, 1u);
+    EXPECT_EQ(pipe1.getStats().throughStalls, 1u);
+    EXPECT_EQ(pipe1.getStats().sinkStalls, 0u);
+    source2.unstall();
+}
+
+TEST(InstrumentedMIDI_Pipe, print) {
+    DummyMIDI_Sink sink;
+    InstrumentedMIDI_Pipe pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillOnce(Return(1000))
+        .WillOnce(Return(1012));
+    source.sourceMIDItoPipe(ChannelMessage{0x93, 0x10, 0x7F});
+
+    TestStream stream;
+    stream << pipe.getStats();
+    std::string str(stream.sent.begin(), stream.sent.end());
+    EXPECT_EQ(str, "Channel: 1 msg, 3 B\r\n"
+                        "SysEx: 0 msg, 0 B\r\n"
+                        "SysCommon: 0 msg, 0 B\r\n"
+                        "RealTime: 0 msg, 0 B\r\n"
+                        "Stalls: 0 sink, 0 through\r\n"
+                        "Drops: 0\r\n"
+                        "Forward time: 12 / 12 / 12 µs (min/avg/max)");
+}
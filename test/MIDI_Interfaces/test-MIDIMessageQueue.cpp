@@ -0,0 +1,152 @@
+#include <MIDI_Interfaces/Util/MIDIMessageQueue.hpp>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace CS;
+
+using u8vec = std::vector<uint8_t>;
+
+TEST(MIDIMessageQueue, pushPop) {
+    MIDIMessageQueue<4, 64> queue;
+    decltype(queue)::MIDIMessageQueueElement el;
+    EXPECT_FALSE(queue.pop(el));
+    EXPECT_TRUE(queue.push(ChannelMessage(0x90, 0x10, 0x7F), 1));
+    EXPECT_TRUE(queue.push(SysCommonMessage(0xF3, 0x05, 0x00), 2));
+    EXPECT_TRUE(queue.push(RealTimeMessage(0xF8), 3));
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(el.message.channelmessage, ChannelMessage(0x90, 0x10, 0x7F));
+    EXPECT_EQ(el.timestamp, 1);
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::SYSCOMMON_MESSAGE);
+    EXPECT_EQ(el.message.syscommonmessage, SysCommonMessage(0xF3, 0x05, 0x00));
+    EXPECT_EQ(el.timestamp, 2);
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(el.message.realtimemessage, RealTimeMessage(0xF8));
+    EXPECT_EQ(el.timestamp, 3);
+    EXPECT_FALSE(queue.pop(el));
+}
+
+TEST(MIDIMessageQueue, full) {
+    MIDIMessageQueue<4, 64> queue;
+    decltype(queue)::MIDIMessageQueueElement el;
+    for (uint8_t i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(ChannelMessage(0x90, i, 0x7F), i));
+    EXPECT_FALSE(queue.push(ChannelMessage(0x90, 4, 0x7F), 4));
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.message.channelmessage.data1, 0);
+    EXPECT_TRUE(queue.push(ChannelMessage(0x90, 4, 0x7F), 4));
+    for (uint8_t i = 1; i < 5; ++i) {
+        ASSERT_TRUE(queue.pop(el));
+        EXPECT_EQ(el.message.channelmessage.data1, i);
+    }
+    EXPECT_FALSE(queue.pop(el));
+}
+
+TEST(MIDIMessageQueue, sysEx) {
+    MIDIMessageQueue<4, 16> queue;
+    decltype(queue)::MIDIMessageQueueElement el;
+    u8vec chunk = {0xF0, 0x01, 0x02, 0x03, 0x04};
+    u8vec last = {0x05, 0x06, 0xF7};
+    EXPECT_TRUE(queue.push(SysExMessage(chunk, CABLE_3), 1));
+    EXPECT_TRUE(queue.push(SysExMessage(last, CABLE_3), 2));
+    chunk[1] = 0x7F; // data is copied
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::SYSEX_CHUNK);
+    EXPECT_EQ(el.message.sysexmessage,
+              SysExMessage({0xF0, 0x01, 0x02, 0x03, 0x04}, CABLE_3));
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(el.message.sysexmessage, SysExMessage(last, CABLE_3));
+}
+
+TEST(MIDIMessageQueue, sysExArenaFull) {
+    MIDIMessageQueue<8, 16> queue;
+    decltype(queue)::MIDIMessageQueueElement el;
+    u8vec msg1 = {0xF0, 0x01, 0x02, 0x03, 0x04, 0x05, 0xF7};
+    u8vec msg2 = {0xF0, 0x11, 0x12, 0x13, 0x14, 0x15, 0xF7};
+    EXPECT_TRUE(queue.push(SysExMessage(msg1), 0));
+    EXPECT_TRUE(queue.push(SysExMessage(msg2), 0));
+    // 14 of 16 bytes used, the next message doesn't fit
+    EXPECT_FALSE(queue.push(SysExMessage(msg1), 0));
+    EXPECT_TRUE(queue.push(ChannelMessage(0x90, 0x10, 0x7F), 0));
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.message.sysexmessage, SysExMessage(msg1));
+    // The data of the first message is still in use until the next pop
+    EXPECT_FALSE(queue.push(SysExMessage(msg1), 0));
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.message.sysexmessage, SysExMessage(msg2));
+    // Now there's space, but it wraps around the end of the arena
+    EXPECT_TRUE(queue.push(SysExMessage(msg1), 0));
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::CHANNEL_MESSAGE);
+    ASSERT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.message.sysexmessage, SysExMessage(msg1));
+    EXPECT_FALSE(queue.pop(el));
+}
+
+TEST(MIDIMessageQueue, sysExTooLarge) {
+    MIDIMessageQueue<4, 16> queue;
+    decltype(queue)::MIDIMessageQueueElement el;
+    u8vec msg(9, 0x00);
+    msg.front() = 0xF0;
+    msg.back() = 0xF7;
+    EXPECT_TRUE(queue.push(SysExMessage(msg), 0)); // dropped
+    EXPECT_FALSE(queue.pop(el));
+}
+
+TEST(MIDIMessageQueue, stressTwoThreads) {
+    using Queue = MIDIMessageQueue<16, 64>;
+    Queue queue;
+    const uint32_t count = 200000;
+
+    // Every 8th message is a SysEx message with a length and content that
+    // depend on its index, so corrupted or reordered data is detected.
+    auto getSysEx = [](uint32_t i, uint8_t *buffer) {
+        uint16_t length = 2 + i % 20;
+        buffer[0] = 0xF0;
+        for (uint16_t j = 1; j < length - 1; ++j)
+            buffer[j] = (i + j) & 0x7F;
+        buffer[length - 1] = 0xF7;
+        return SysExMessage(buffer, length);
+    };
+
+    std::thread producer([&] {
+        uint8_t buffer[32];
+        for (uint32_t i = 0; i < count; ++i) {
+            if (i % 8 == 7)
+                while (!queue.push(getSysEx(i, buffer), i & 0xFFFF))
+                    std::this_thread::yield();
+            else
+                while (!queue.push(ChannelMessage(0xB0 | (i % 16),
+                                                  (i >> 4) & 0x7F,
+                                                  (i >> 11) & 0x7F),
+                                   i & 0xFFFF))
+                    std::this_thread::yield();
+        }
+    });
+
+    uint8_t buffer[32];
+    uint32_t errors = 0;
+    Queue::MIDIMessageQueueElement el;
+    for (uint32_t i = 0; i < count; ++i) {
+        while (!queue.pop(el))
+            std::this_thread::yield();
+        errors += el.timestamp != (i & 0xFFFF);
+        if (i % 8 == 7) {
+            errors += el.eventType != MIDIReadEvent::SYSEX_MESSAGE;
+            errors += el.message.sysexmessage != getSysEx(i, buffer);
+        } else {
+            ChannelMessage expected(0xB0 | (i % 16), (i >> 4) & 0x7F,
+                                    (i >> 11) & 0x7F);
+            errors += el.eventType != MIDIReadEvent::CHANNEL_MESSAGE;
+            errors += el.message.channelmessage != expected;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(errors, 0u);
+    EXPECT_FALSE(queue.pop(el));
+}
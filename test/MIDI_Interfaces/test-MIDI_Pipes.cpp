@@ -1755,6 +1755,9 @@ TEST(MIDI_Pipes, connectPipeToSourceTwice) {
 using ::testing::Return;
 
 TEST(MIDI_Pipes, USBInterface) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     StrictMock<USBMIDI_Interface> midiA[2];
     StrictMock<MockMIDI_Interface> midiB[2];
 
@@ -1787,6 +1790,9 @@ TEST(MIDI_Pipes, USBInterface) {
 }
 
 TEST(MIDI_Pipes, USBInterfaceLockSysEx) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     StrictMock<USBMIDI_Interface> midiA[2];
     StrictMock<MockMIDI_Interface> midiB[2];
 
@@ -1828,6 +1834,9 @@ TEST(MIDI_Pipes, USBInterfaceLockSysEx) {
 }
 
 TEST(MIDI_Pipes, USBInterfaceLockChannelMessage) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     StrictMock<USBMIDI_Interface> midiA[2];
     StrictMock<MockMIDI_Interface> midiB[2];
 
@@ -1864,6 +1873,9 @@ TEST(MIDI_Pipes, USBInterfaceLockChannelMessage) {
 }
 
 TEST(MIDI_Pipes, USBInterfaceLockRealTime) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     StrictMock<USBMIDI_Interface> midiA[2];
     StrictMock<MockMIDI_Interface> midiB[2];
 
@@ -1900,6 +1912,9 @@ TEST(MIDI_Pipes, USBInterfaceLockRealTime) {
 }
 
 TEST(MIDI_Pipes, USBInterfaceLoopBack) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     StrictMock<USBMIDI_Interface> midi;
 
     MIDI_Pipe pipe;
@@ -2217,6 +2232,9 @@ TEST(MIDI_Pipes, disconnectSinkFromSource) {
 #include <random>
 
 TEST(MIDI_Pipes, StreamMIDIInterfaceSysExChunks) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     StrictMock<TestStream> streams[2];
     StreamMIDI_Interface midiA[2] = {streams[0], streams[1]};
     StrictMock<MockMIDI_Interface> midiB;
@@ -2270,3 +2288,43 @@ TEST(MIDI_Pipes, StreamMIDIInterfaceSysExChunks) {
     testing::Mock::VerifyAndClear(&midiB);
     testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
 }
+
+#if MIDI_TIMESTAMPS
+TEST(MIDI_Pipes, timestampThroughPipes) {
+    struct TimestampSink : TrueMIDI_Sink {
+        void sinkMIDIfromPipe(ChannelMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        void sinkMIDIfromPipe(SysExMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        void sinkMIDIfromPipe(SysCommonMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        void sinkMIDIfromPipe(RealTimeMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        std::vector<uint32_t> timestamps;
+    } sink;
+    TrueMIDI_Source source;
+    MIDI_Pipe pipe1, pipe2;
+    source >> pipe1 >> sink;
+    source >> pipe2 >> sink;
+
+    ChannelMessage chmsg{0x93, 0x10, 0x7F};
+    chmsg.setTimestamp(1);
+    source.sourceMIDItoPipe(chmsg);
+    SysExMessage sxmsg;
+    sxmsg.setTimestamp(2);
+    source.sourceMIDItoPipe(sxmsg);
+    SysCommonMessage scmsg{MIDIMessageType::TUNE_REQUEST};
+    scmsg.setTimestamp(3);
+    source.sourceMIDItoPipe(scmsg);
+    RealTimeMessage rtmsg{0xF8};
+    rtmsg.setTimestamp(4);
+    source.sourceMIDItoPipe(rtmsg);
+
+    std::vector<uint32_t> expected = {1, 1, 2, 2, 3, 3, 4, 4};
+    EXPECT_EQ(sink.timestamps, expected);
+}
+#endif
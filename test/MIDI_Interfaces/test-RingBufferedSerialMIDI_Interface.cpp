@@ -0,0 +1,150 @@
+#include <MIDI_Interfaces/MIDI_Callbacks.hpp>
+#include <MIDI_Interfaces/RingBufferedSerialMIDI_Interface.hpp>
+#include <TestStream.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+USING_CS_NAMESPACE;
+using ::testing::Return;
+
+using u8vec = std::vector<uint8_t>;
+
+namespace {
+
+struct RecordingCallbacks : MIDI_Callbacks {
+    void onChannelMessage(MIDI_Interface &, ChannelMessage m) override {
+        channel.push_back(m);
+    }
+    void onSysExMessage(MIDI_Interface &, SysExMessage m) override {
+        sysex.emplace_back(m.data, m.data + m.length);
+    }
+    void onRealTimeMessage(MIDI_Interface &, RealTimeMessage m) override {
+        realtime.push_back(m);
+    }
+    std::vector<ChannelMessage> channel;
+    std::vector<u8vec> sysex;
+    std::vector<RealTimeMessage> realtime;
+};
+
+} // namespace
+
+TEST(RingBufferedStreamMIDI_Interface, send) {
+    TestStream stream;
+    RingBufferedStreamMIDI_Interface<16> midi {stream};
+    midi.sendNoteOn({0x55, CHANNEL_4}, 0x66);
+    midi.sendRealTime(MIDIMessageType::TIMING_CLOCK);
+    u8vec expected = {0x93, 0x55, 0x66, 0xF8};
+    EXPECT_EQ(stream.sent, expected);
+}
+
+TEST(RingBufferedStreamMIDI_Interface, receiveUpdate) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000000));
+    RecordingCallbacks callbacks;
+    TestStream stream;
+    RingBufferedStreamMIDI_Interface<16> midi {stream};
+    midi.setCallbacks(callbacks);
+    midi.begin();
+    u8vec data = {0x94, 0x12, 0x34, 0xF8, 0x13, 0x35};
+    EXPECT_EQ(midi.receive(data.data(), data.size()), data.size());
+    midi.update();
+    std::vector<ChannelMessage> expected = {{0x94, 0x12, 0x34},
+                                            {0x94, 0x13, 0x35}};
+    EXPECT_EQ(callbacks.channel, expected);
+    ASSERT_EQ(callbacks.realtime.size(), 1);
+    EXPECT_EQ(callbacks.realtime[0], RealTimeMessage(0xF8));
+    EXPECT_EQ(midi.getReceiveRing().available(), 0);
+}
+
+TEST(RingBufferedStreamMIDI_Interface, sysExWrapAround) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000000));
+    RecordingCallbacks callbacks;
+    TestStream stream;
+    RingBufferedStreamMIDI_Interface<16> midi {stream};
+    midi.setCallbacks(callbacks);
+    // Move the ring indices so the SysEx message wraps around
+    for (uint8_t b : {0xC0, 0x01, 0xC0, 0x02, 0xC0, 0x03, 0xC0, 0x04, 0xC0,
+                      0x05, 0xC0, 0x06})
+        EXPECT_TRUE(midi.receive(b));
+    midi.update();
+    EXPECT_EQ(callbacks.channel.size(), 6);
+    u8vec sysex = {0xF0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xF7};
+    EXPECT_EQ(midi.receive(sysex.data(), sysex.size()), sysex.size());
+    midi.update();
+    ASSERT_EQ(callbacks.sysex.size(), 1);
+    EXPECT_EQ(callbacks.sysex[0], sysex);
+}
+
+TEST(RingBufferedStreamMIDI_Interface, overflow) {
+    TestStream stream;
+    RingBufferedStreamMIDI_Interface<4> midi {stream};
+    u8vec data = {0x90, 0x10, 0x7F, 0x90, 0x11, 0x7F};
+    EXPECT_EQ(midi.receive(data.data(), data.size()), 4);
+    EXPECT_FALSE(midi.receive(0xF8));
+    EXPECT_EQ(midi.getOverflowCount(), 3);
+}
+
+TEST(RingBufferedStreamMIDI_Interface, pollRead) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000000));
+    TestStream stream;
+    RingBufferedStreamMIDI_Interface<4> midi {stream};
+    for (auto v : {0x94, 0x12, 0x34, 0x13, 0x35, 0xF8})
+        stream.toRead.push(v);
+    // Only the first four bytes fit in the ring, the rest stays in the stream
+    midi.poll();
+    EXPECT_EQ(midi.getReceiveRing().available(), 4);
+    EXPECT_EQ(stream.toRead.size(), 2);
+    EXPECT_EQ(midi.getOverflowCount(), 0);
+    EXPECT_EQ(midi.read(), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(midi.getChannelMessage(), ChannelMessage(0x94, 0x12, 0x34));
+    midi.poll();
+    EXPECT_EQ(midi.read(), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(midi.getChannelMessage(), ChannelMessage(0x94, 0x13, 0x35));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(midi.read(), MIDIReadEvent::NO_MESSAGE);
+}
+
+/// A simulated UART receive interrupt that adds the bytes of many Control
+/// Change messages to the ring while the main loop is parsing them.
+TEST(RingBufferedStreamMIDI_Interface, producerThread) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000000));
+    RecordingCallbacks callbacks;
+    TestStream stream;
+    RingBufferedStreamMIDI_Interface<64> midi {stream};
+    midi.setCallbacks(callbacks);
+    constexpr size_t count = 20000;
+    u8vec data;
+    for (size_t i = 0; i < count; ++i) {
+        data.push_back(0xB0 | (i % 16));
+        data.push_back((i / 16) & 0x7F);
+        data.push_back(i & 0x7F);
+    }
+    std::thread producer([&] {
+        // Like a DMA transfer, deliver the data in blocks of varying size,
+        // waiting for the consumer when the ring is full
+        size_t i = 0;
+        while (i < data.size()) {
+            uint16_t n = std::min<size_t>(1 + i % 11, data.size() - i);
+            i += midi.receive(data.data() + i, n);
+            std::this_thread::yield();
+        }
+    });
+    while (callbacks.channel.size() < count) {
+        midi.update();
+        std::this_thread::yield();
+    }
+    producer.join();
+    midi.update();
+    ASSERT_EQ(callbacks.channel.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        ChannelMessage expected {uint8_t(0xB0 | (i % 16)),
+                                 uint8_t((i / 16) & 0x7F), uint8_t(i & 0x7F)};
+        ASSERT_EQ(callbacks.channel[i], expected) << i;
+    }
+    EXPECT_EQ(midi.getReceiveRing().available(), 0);
+}
@@ -112,6 +112,9 @@ TEST(StreamMIDI_Interface, readSysEx) {
 }
 
 TEST(StreamMIDI_Interface, readNoteUpdate) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     class MockMIDI_Callbacks : public MIDI_Callbacks {
       public:
         MOCK_METHOD(void, onChannelMessage, (MIDI_Interface *, ChannelMessage),
@@ -137,6 +140,9 @@ TEST(StreamMIDI_Interface, readNoteUpdate) {
 }
 
 TEST(StreamMIDI_Interface, readSysExUpdate) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     class MockMIDI_Callbacks : public MIDI_Callbacks {
       public:
         MOCK_METHOD(void, onChannelMessage, (MIDI_Interface &, ChannelMessage),
@@ -161,7 +167,47 @@ TEST(StreamMIDI_Interface, readSysExUpdate) {
     midi.update();
 }
 
+TEST(StreamMIDI_Interface, readSysExUpdateWithSink) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
+    class MockMIDI_Callbacks : public MIDI_Callbacks {
+      public:
+        MOCK_METHOD(void, onSysExMessage, (MIDI_Interface *, SysExMessage), ());
+        void onSysExMessage(MIDI_Interface &midi, SysExMessage m) override {
+            onSysExMessage(&midi, m);
+        }
+    };
+    struct CountingSysExSink : SysExSink {
+        void onSysExBegin(Cable) override { ++begins; }
+        void onSysExContinue(SysExMessage chunk) override {
+            length += chunk.length;
+        }
+        void onSysExEnd(Cable) override { ++ends; }
+        unsigned begins = 0, ends = 0, length = 0;
+    };
+    MockMIDI_Callbacks callbacks;
+    CountingSysExSink sink;
+    TestStream stream;
+    StreamMIDI_Interface midi = stream;
+    midi.setCallbacks(callbacks);
+    midi.setSysExSink(&sink);
+    midi.begin();
+    uint8_t sysex[] = {0xF0, 0x55, 0x66, 0x77, 0x11, 0x22, 0x33, 0xF7};
+    for (auto v : sysex)
+        stream.toRead.push(v);
+    // Messages that fit in the buffer still reach the callbacks (and pipes)
+    SysExMessage expected = {sysex, 8};
+    EXPECT_CALL(callbacks, onSysExMessage(&midi, expected));
+    midi.update();
+    EXPECT_EQ(sink.begins, 1u);
+    EXPECT_EQ(sink.ends, 1u);
+    EXPECT_EQ(sink.length, 8u);
+}
+
 TEST(StreamMIDI_Interface, readRealTimeUpdate) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
     class MockMIDI_Callbacks : public MIDI_Callbacks {
       public:
         MOCK_METHOD(void, onChannelMessage, (MIDI_Interface &, ChannelMessage),
@@ -184,4 +230,82 @@ TEST(StreamMIDI_Interface, readRealTimeUpdate) {
     RealTimeMessage expected = {0xF8};
     EXPECT_CALL(callbacks, onRealTimeMessage(&midi, expected));
     midi.update();
-}
\ No newline at end of file
+}
+TEST(StreamMIDI_Interface, readManyUpdate) {
+    // Incoming messages are timestamped
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(::testing::Return(1000000));
+    class MockMIDI_Callbacks : public MIDI_Callbacks {
+      public:
+        MOCK_METHOD(void, onChannelMessage, (MIDI_Interface *, ChannelMessage),
+                    ());
+        MOCK_METHOD(void, onSysExMessage, (MIDI_Interface *, SysExMessage),
+                    ());
+        MOCK_METHOD(void, onRealTimeMessage,
+                    (MIDI_Interface *, RealTimeMessage), ());
+        void onChannelMessage(MIDI_Interface &midi, ChannelMessage m) override {
+            onChannelMessage(&midi, m);
+        }
+        void onSysExMessage(MIDI_Interface &midi, SysExMessage m) override {
+            onSysExMessage(&midi, m);
+        }
+        void onRealTimeMessage(MIDI_Interface &midi,
+                               RealTimeMessage m) override {
+            onRealTimeMessage(&midi, m);
+        }
+    };
+    MockMIDI_Callbacks callbacks;
+    TestStream stream;
+    StreamMIDI_Interface midi = stream;
+    midi.setCallbacks(callbacks);
+    midi.begin();
+    // More messages than fit in a single block, using running status
+    Sequence seq;
+    stream.toRead.push(0xB3);
+    for (uint8_t i = 0; i < 3 * SERIAL_MIDI_BLOCK_SIZE; ++i) {
+        stream.toRead.push(i);
+        stream.toRead.push(0x7F - i);
+        ChannelMessage expected = {0xB3, i, uint8_t(0x7F - i)};
+        EXPECT_CALL(callbacks, onChannelMessage(&midi, expected))
+            .InSequence(seq);
+        if (i == SERIAL_MIDI_BLOCK_SIZE) {
+            stream.toRead.push(0xF8);
+            EXPECT_CALL(callbacks, onRealTimeMessage(&midi, {0xF8}))
+                .InSequence(seq);
+        }
+    }
+    uint8_t sysex[] = {0xF0, 0x55, 0x66, 0xF7};
+    for (auto v : sysex)
+        stream.toRead.push(v);
+    EXPECT_CALL(callbacks, onSysExMessage(&midi, SysExMessage(sysex)))
+        .InSequence(seq);
+    ChannelMessage last = {0xC2, 0x01, 0x00};
+    for (auto v : {0xC2, 0x01})
+        stream.toRead.push(v);
+    EXPECT_CALL(callbacks, onChannelMessage(&midi, last)).InSequence(seq);
+    midi.update();
+    EXPECT_TRUE(stream.toRead.empty());
+}
+
+#if MIDI_TIMESTAMPS
+TEST(StreamMIDI_Interface, timestampUpdate) {
+    struct TimestampCallbacks : MIDI_Callbacks {
+        void onChannelMessage(MIDI_Interface &, ChannelMessage m) override {
+            timestamps.push_back(m.getTimestamp());
+        }
+        std::vector<uint32_t> timestamps;
+    } callbacks;
+    TestStream stream;
+    StreamMIDI_Interface midi = stream;
+    midi.setCallbacks(callbacks);
+    midi.begin();
+    for (auto v : {0x94, 0x12, 0x34, 0x13, 0x35})
+        stream.toRead.push(v);
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillOnce(Return(123456))
+        .WillOnce(Return(123457));
+    midi.update();
+    std::vector<uint32_t> expected = {123456, 123457};
+    EXPECT_EQ(callbacks.timestamps, expected);
+}
+#endif
@@ -209,4 +209,276 @@ TEST(USBMIDI_Interface, readSysEx) {
     };
     EXPECT_EQ(result, expected);
     EXPECT_EQ(sysex.cable, CABLE_6);
-}
\ No newline at end of file
+}
+// -------------------------------------------------------------------------- //
+
+#include <MIDI_Interfaces/MIDI_Callbacks.hpp>
+
+using ::testing::_;
+using ::testing::Invoke;
+
+/// Feeds the given packets to a bulk backend, at most @p blockSize at a time.
+struct BulkFeeder {
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    BulkFeeder(USBDeviceMIDIBulkBackend &backend,
+               const std::vector<Packet_t> &packets, size_t blockSize)
+        : packets(packets), blockSize(blockSize) {
+        EXPECT_CALL(backend, read(_, _))
+            .WillRepeatedly(Invoke(this, &BulkFeeder::read));
+    }
+    size_t read(Packet_t *p, size_t max) {
+        size_t n = std::min({max, blockSize, packets.size() - index});
+        std::copy_n(packets.begin() + index, n, p);
+        index += n;
+        return n;
+    }
+    const std::vector<Packet_t> &packets;
+    size_t blockSize;
+    size_t index = 0;
+};
+
+struct RecordingCallbacks : MIDI_Callbacks {
+    void onChannelMessage(MIDI_Interface &, ChannelMessage m) override {
+        messages.push_back(m);
+    }
+    void onRealTimeMessage(MIDI_Interface &, RealTimeMessage m) override {
+        messages.push_back({m.message, 0x00, 0x00, m.cable});
+    }
+    void onSysExMessage(MIDI_Interface &, SysExMessage m) override {
+        sysex.insert(sysex.end(), m.data, m.data + m.length);
+        sysexCable = m.cable;
+    }
+    std::vector<MIDIMessage> messages;
+    SysExVector sysex;
+    Cable sysexCable = CABLE_1;
+};
+
+TEST(USBMIDI_Interface, bulkUpdate) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000000));
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    std::vector<Packet_t> packets;
+    std::vector<MIDIMessage> expected;
+    for (uint8_t i = 0; i < 3 * USB_MIDI_BLOCK_SIZE / 2; ++i) {
+        packets.push_back({{0x19, 0x91, i, 0x7F}});
+        expected.push_back({0x91, i, 0x7F, CABLE_2});
+        if (i % 8 == 0) {
+            packets.push_back({{0x3F, 0xF8, 0x00, 0x00}});
+            expected.push_back({0xF8, 0x00, 0x00, CABLE_4});
+        }
+    }
+    packets.push_back({{0x14, 0xF0, 0x01, 0x02}});
+    packets.push_back({{0x16, 0x03, 0xF7, 0x00}});
+    packets.push_back({{0x1B, 0xB1, 0x07, 0x10}});
+    expected.push_back({0xB1, 0x07, 0x10, CABLE_2});
+
+    for (size_t blockSize : {1, 5, int(USB_MIDI_BLOCK_SIZE)}) {
+        StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkBackend>> midi;
+        RecordingCallbacks callbacks;
+        midi.setCallbacks(callbacks);
+        BulkFeeder feeder {midi.backend, packets, blockSize};
+        midi.update();
+        EXPECT_EQ(callbacks.messages, expected) << "blockSize=" << blockSize;
+        EXPECT_EQ(callbacks.sysex, (SysExVector{0xF0, 0x01, 0x02, 0x03, 0xF7}));
+        EXPECT_EQ(callbacks.sysexCable, CABLE_2);
+    }
+}
+
+#if !IGNORE_SYSEX
+TEST(USBMIDI_Interface, bulkUpdateSysExChunks) {
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000000));
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    std::vector<Packet_t> packets;
+    SysExVector expected = {0xF0};
+    packets.push_back({{0x04, 0xF0, 0x10, 0x11}});
+    expected.insert(expected.end(), {0x10, 0x11});
+    for (uint8_t i = 0; i < SYSEX_BUFFER_SIZE; ++i) {
+        uint8_t d = i & 0x7F;
+        packets.push_back({{0x04, d, d, d}});
+        expected.insert(expected.end(), {d, d, d});
+    }
+    packets.push_back({{0x05, 0xF7, 0x00, 0x00}});
+    expected.push_back(0xF7);
+
+    StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkBackend>> midi;
+    RecordingCallbacks callbacks;
+    midi.setCallbacks(callbacks);
+    BulkFeeder feeder {midi.backend, packets, USB_MIDI_BLOCK_SIZE};
+    midi.update();
+    EXPECT_EQ(callbacks.sysex, expected);
+    EXPECT_TRUE(callbacks.messages.empty());
+}
+#endif
+
+TEST(USBMIDI_Interface, sendChannelMessages) {
+    StrictMock<USBMIDI_Interface> midi;
+    Sequence seq;
+    EXPECT_CALL(midi.backend, write(0x89, 0x93, 0x55, 0x66)).InSequence(seq);
+    EXPECT_CALL(midi.backend, write(0x8C, 0xC3, 0x66, 0x00)).InSequence(seq);
+    EXPECT_CALL(midi.backend, write(0x0B, 0xB0, 0x7F, 0x01)).InSequence(seq);
+    ChannelMessage messages[] = {
+        {0x93, 0x55, 0x66, CABLE_9},
+        {0xF8, 0x00, 0x00, CABLE_9}, // invalid, skipped
+        {0xC3, 0x66, 0x00, CABLE_9},
+        {0xB0, 0xFF, 0x81, CABLE_1}, // sanitized
+    };
+    midi.send(messages);
+}
+
+/// Records the packets written to a bulk write backend.
+struct BulkRecorder {
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    BulkRecorder(USBDeviceMIDIBulkWriteBackend &backend) {
+        EXPECT_CALL(backend, write(_, _))
+            .WillRepeatedly(Invoke(this, &BulkRecorder::write));
+    }
+    void write(const Packet_t *p, size_t n) {
+        packets.insert(packets.end(), p, p + n);
+        writes.push_back(n);
+    }
+    std::vector<Packet_t> packets;
+    std::vector<size_t> writes;
+};
+
+TEST(USBMIDI_Interface, sendChannelMessagesBulk) {
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    std::vector<ChannelMessage> messages;
+    std::vector<Packet_t> expected;
+    for (uint8_t i = 0; i < USB_MIDI_BLOCK_SIZE + 4; ++i) {
+        messages.push_back({0xB1, i, 0x7F, CABLE_3});
+        expected.push_back({{0x2B, 0xB1, i, 0x7F}});
+    }
+    messages.push_back({0x00, 0x00, 0x00, CABLE_3}); // invalid, skipped
+
+    StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkWriteBackend>> midi;
+    BulkRecorder recorder {midi.backend};
+    midi.send(messages.data(), messages.size());
+    EXPECT_EQ(recorder.packets, expected);
+    EXPECT_EQ(recorder.writes,
+              (std::vector<size_t> {USB_MIDI_BLOCK_SIZE, 4}));
+}
+
+TEST(USBMIDI_Interface, sendSysExBulk) {
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    SysExVector sysex = {0xF0};
+    for (uint8_t i = 0; i < 3 * USB_MIDI_BLOCK_SIZE; ++i)
+        sysex.push_back(i);
+    sysex.push_back(0xF7);
+    std::vector<Packet_t> expected;
+    USBMIDI_Sender sender;
+    sender.sendFullSysEx(
+        SysExMessage(sysex, CABLE_5),
+        [&](Cable cn, MIDICodeIndexNumber cin, uint8_t d0, uint8_t d1,
+            uint8_t d2) {
+            uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
+            expected.push_back({{cn_cin, d0, d1, d2}});
+        });
+
+    StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkWriteBackend>> midi;
+    BulkRecorder recorder {midi.backend};
+    midi.send(SysExMessage(sysex, CABLE_5));
+    EXPECT_EQ(recorder.packets, expected);
+    EXPECT_EQ(recorder.writes, (std::vector<size_t> {USB_MIDI_BLOCK_SIZE,
+                                                     expected.size() -
+                                                         USB_MIDI_BLOCK_SIZE}));
+}
+
+/// Encode the given SysEx message as USB MIDI packets.
+static std::vector<USBMIDI_Interface::MIDIUSBPacket_t>
+sysExPackets(const SysExVector &sysex, Cable cable) {
+    std::vector<USBMIDI_Interface::MIDIUSBPacket_t> packets;
+    USBMIDI_Sender sender;
+    sender.sendFullSysEx(SysExMessage(sysex, cable),
+                         [&](Cable cn, MIDICodeIndexNumber cin, uint8_t d0,
+                             uint8_t d1, uint8_t d2) {
+                             uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
+                             packets.push_back({{cn_cin, d0, d1, d2}});
+                         });
+    return packets;
+}
+
+TEST(USBMIDI_Interface, scheduledSysExInterleaved) {
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    SysExVector sysex = {0xF0};
+    for (uint8_t i = 0; i < 28; ++i)
+        sysex.push_back(i);
+    sysex.push_back(0xF7);
+    auto sysexPackets = sysExPackets(sysex, CABLE_1); // 10 packets
+
+    StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkWriteBackend>> midi;
+    EXPECT_CALL(midi.backend, read()).WillRepeatedly(Return(Packet_t {}));
+    BulkRecorder recorder {midi.backend};
+    USBMIDI_OutputScheduler<2, 16> scheduler;
+    scheduler.setMaxSysExPacketsPerUpdate(4);
+    midi.setOutputScheduler(&scheduler);
+
+    // The SysEx message is only queued
+    midi.send(SysExMessage(sysex, CABLE_1));
+    EXPECT_TRUE(recorder.packets.empty());
+    EXPECT_EQ(scheduler.getQueueSize(CABLE_1), 10);
+    midi.update();
+    std::vector<Packet_t> expected(sysexPackets.begin(),
+                                   sysexPackets.begin() + 4);
+    EXPECT_EQ(recorder.packets, expected);
+    // Real-Time messages overtake the SysEx message on the same cable
+    midi.sendTimingClock(CABLE_1);
+    expected.push_back({{0x0F, 0xF8, 0x00, 0x00}});
+    EXPECT_EQ(recorder.packets, expected);
+    // Channel messages on the same cable wait for the end of the SysEx message
+    midi.sendNoteOn({0x3C, CHANNEL_1, CABLE_1}, 0x7F);
+    EXPECT_EQ(recorder.packets, expected);
+    // Channel messages on other cables are sent immediately
+    midi.sendNoteOn({0x3C, CHANNEL_1, CABLE_2}, 0x7F);
+    expected.push_back({{0x19, 0x90, 0x3C, 0x7F}});
+    EXPECT_EQ(recorder.packets, expected);
+    midi.update();
+    expected.insert(expected.end(), sysexPackets.begin() + 4,
+                    sysexPackets.begin() + 8);
+    EXPECT_EQ(recorder.packets, expected);
+    midi.update();
+    expected.insert(expected.end(), sysexPackets.begin() + 8,
+                    sysexPackets.end());
+    expected.push_back({{0x09, 0x90, 0x3C, 0x7F}});
+    EXPECT_EQ(recorder.packets, expected);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST(USBMIDI_Interface, scheduledSysExRoundRobin) {
+    using Packet_t = USBMIDI_Interface::MIDIUSBPacket_t;
+    SysExVector sysex = {0xF0, 0x01, 0x02, 0x03, 0x04, 0xF7};
+    auto a = sysExPackets(sysex, CABLE_1);
+    auto b = sysExPackets(sysex, CABLE_2);
+
+    StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkWriteBackend>> midi;
+    BulkRecorder recorder {midi.backend};
+    USBMIDI_OutputScheduler<2, 16> scheduler;
+    midi.setOutputScheduler(&scheduler);
+    midi.send(SysExMessage(sysex, CABLE_1));
+    midi.send(SysExMessage(sysex, CABLE_2));
+    EXPECT_TRUE(recorder.packets.empty());
+    EXPECT_CALL(midi.backend, sendNow());
+    midi.sendNow();
+    std::vector<Packet_t> expected = {a[0], b[0], a[1], b[1]};
+    EXPECT_EQ(recorder.packets, expected);
+}
+
+TEST(USBMIDI_Interface, scheduledQueueFull) {
+    SysExVector sysex = {0xF0};
+    for (uint8_t i = 0; i < 3 * USB_MIDI_BLOCK_SIZE; ++i)
+        sysex.push_back(i & 0x7F);
+    sysex.push_back(0xF7);
+    auto expected = sysExPackets(sysex, CABLE_3);
+
+    StrictMock<GenericUSBMIDI_Interface<USBDeviceMIDIBulkWriteBackend>> midi;
+    BulkRecorder recorder {midi.backend};
+    USBMIDI_OutputScheduler<1, 4> scheduler;
+    midi.setOutputScheduler(&scheduler);
+    // Packets that don't fit in the queue are sent immediately
+    midi.send(SysExMessage(sysex, CABLE_3));
+    EXPECT_EQ(recorder.packets.size(), expected.size() - 4);
+    EXPECT_EQ(scheduler.getQueueSize(CABLE_3), 4);
+    // Removing the scheduler sends the remaining packets
+    midi.setOutputScheduler(nullptr);
+    EXPECT_EQ(recorder.packets, expected);
+}
@@ -0,0 +1,52 @@
+#include <MIDI_Outputs/CCPotentiometers.hpp>
+#include <MockMIDI_Interface.hpp>
+#include <gmock/gmock.h>
+
+using namespace ::testing;
+using namespace CS;
+
+TEST(CCPotentiometers, onlyChangedInputsAreSent) {
+    MockMIDI_Interface midi;
+    Control_Surface.connectDefaultMIDI_Interface();
+
+    CCPotentiometers<3> pots {{2, 3, 4}, {0x3C, CHANNEL_7, CABLE_13}, {2}};
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(_))
+        .WillRepeatedly(Return(0));
+    pots.begin();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(2))
+        .Times(3)
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(3))
+        .Times(3)
+        .WillRepeatedly(Return(512));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(4))
+        .Times(3)
+        .WillRepeatedly(Return(0));
+    // Same values as CCPotentiometer, on the address of the second input
+    InSequence s;
+    EXPECT_CALL(
+        midi, sendChannelMessageImpl(ChannelMessage(0xB6, 0x3E, 16, CABLE_13)));
+    pots.update();
+    EXPECT_CALL(
+        midi, sendChannelMessageImpl(ChannelMessage(0xB6, 0x3E, 28, CABLE_13)));
+    pots.update();
+    EXPECT_CALL(
+        midi, sendChannelMessageImpl(ChannelMessage(0xB6, 0x3E, 37, CABLE_13)));
+    pots.update();
+    EXPECT_EQ(pots.getValue(1), 37);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(CCPotentiometers, forcedUpdate) {
+    MockMIDI_Interface midi;
+    Control_Surface.connectDefaultMIDI_Interface();
+
+    CCPotentiometers<2> pots {{2, 3}, {0x10, CHANNEL_1}};
+    InSequence s;
+    EXPECT_CALL(midi, sendChannelMessageImpl(ChannelMessage(0xB0, 0x10, 0, CABLE_1)));
+    EXPECT_CALL(midi, sendChannelMessageImpl(ChannelMessage(0xB0, 0x11, 0, CABLE_1)));
+    pots.forcedUpdate();
+}
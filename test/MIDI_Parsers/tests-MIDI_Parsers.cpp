@@ -864,4 +864,538 @@ TEST(SerialMIDIParser, realSysEx) {
     EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::SYSEX_MESSAGE);
     EXPECT_EQ(sparser.getSysExMessage(), SysExMessage(data));
     EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
-}
\ No newline at end of file
+}
+// ------------------------- SERIAL PARSER BLOCK API ------------------------ //
+
+using BlockEvent = SerialMIDI_Parser::BlockEvent;
+
+TEST(SerialMIDIParserBlock, runningStatus) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0x93, 0x10, 0x7F, 0x11, 0x7E, 0x12, 0x7D, 0xC1, 0x05,
+                      0x06, 0x07};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 8);
+    EXPECT_EQ(result.bytesConsumed, sizeof(data));
+    ASSERT_EQ(result.numEvents, 6u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x93, 0x10, 0x7F));
+    EXPECT_EQ(events[1].message, MIDIMessage(0x93, 0x11, 0x7E));
+    EXPECT_EQ(events[2].message, MIDIMessage(0x93, 0x12, 0x7D));
+    EXPECT_EQ(events[3].message, MIDIMessage(0xC1, 0x05, 0x00));
+    EXPECT_EQ(events[4].message, MIDIMessage(0xC1, 0x06, 0x00));
+    EXPECT_EQ(events[5].message, MIDIMessage(0xC1, 0x07, 0x00));
+    for (size_t i = 0; i < result.numEvents; ++i)
+        EXPECT_EQ(events[i].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.getChannelMessage(), ChannelMessage(0xC1, 0x07, 0x00));
+}
+
+TEST(SerialMIDIParserBlock, runningStatusSplitBetweenBlocks) {
+    SerialMIDI_Parser sparser;
+    uint8_t data1[] = {0xB2, 0x10, 0x7F, 0x11};
+    uint8_t data2[] = {0x7E, 0x12, 0x7D};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data1, sizeof(data1), events, 8);
+    EXPECT_EQ(result.bytesConsumed, sizeof(data1));
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0xB2, 0x10, 0x7F));
+    result = sparser.parseBlock(data2, sizeof(data2), events, 8);
+    EXPECT_EQ(result.bytesConsumed, sizeof(data2));
+    ASSERT_EQ(result.numEvents, 2u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0xB2, 0x11, 0x7E));
+    EXPECT_EQ(events[1].message, MIDIMessage(0xB2, 0x12, 0x7D));
+}
+
+TEST(SerialMIDIParserBlock, realTimeInRunningStatus) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0x93, 0x10, 0x7F, 0x11, 0xF8, 0x7E, 0x12, 0x7D};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 8);
+    EXPECT_EQ(result.bytesConsumed, sizeof(data));
+    ASSERT_EQ(result.numEvents, 4u);
+    EXPECT_EQ(events[0].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x93, 0x10, 0x7F));
+    EXPECT_EQ(events[1].event, MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(events[1].message.header, 0xF8);
+    EXPECT_EQ(events[2].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[2].message, MIDIMessage(0x93, 0x11, 0x7E));
+    EXPECT_EQ(events[3].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[3].message, MIDIMessage(0x93, 0x12, 0x7D));
+}
+
+TEST(SerialMIDIParserBlock, sysCommonCancelsRunningStatus) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0x93, 0x10, 0x7F, 0xF3, 0x05, 0x11, 0x7E, 0x93, 0x12};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 8);
+    EXPECT_EQ(result.bytesConsumed, sizeof(data));
+    ASSERT_EQ(result.numEvents, 2u);
+    EXPECT_EQ(events[0].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[1].event, MIDIReadEvent::SYSCOMMON_MESSAGE);
+    EXPECT_EQ(events[1].message, MIDIMessage(0xF3, 0x05, 0x00));
+}
+
+TEST(SerialMIDIParserBlock, tuneRequestInterruptsRunningStatus) {
+    // Tune Request in the middle of a running status message, without
+    // cancelling running status (e.g. BLE MIDI)
+    uint8_t data[] = {0x93, 0x10, 0x7F, 0x11, 0xF6, 0x12, 0x7D, 0x13, 0x7C};
+    SerialMIDI_Parser ref {false};
+    std::vector<MIDIMessage> expected;
+    auto puller = BufferPuller(data);
+    while (ref.pull(puller) != MIDIReadEvent::NO_MESSAGE)
+        expected.push_back(ref.getChannelMessage());
+    std::vector<MIDIMessage> reference = {
+        {0x93, 0x10, 0x7F},
+        {0xF6, 0x00, 0x00},
+        {0x93, 0x12, 0x7D},
+        {0x93, 0x13, 0x7C},
+    };
+    EXPECT_EQ(expected, reference);
+
+    SerialMIDI_Parser sparser {false};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 8);
+    EXPECT_EQ(result.bytesConsumed, sizeof(data));
+    std::vector<MIDIMessage> actual;
+    for (size_t i = 0; i < result.numEvents; ++i)
+        actual.push_back(events[i].message);
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(SerialMIDIParserBlock, eventsFull) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0x93, 0x10, 0x7F, 0x11, 0x7E, 0x12, 0x7D};
+    BlockEvent events[2];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 2);
+    EXPECT_EQ(result.bytesConsumed, 5u);
+    ASSERT_EQ(result.numEvents, 2u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x93, 0x10, 0x7F));
+    EXPECT_EQ(events[1].message, MIDIMessage(0x93, 0x11, 0x7E));
+    result = sparser.parseBlock(data + 5, sizeof(data) - 5, events, 2);
+    EXPECT_EQ(result.bytesConsumed, 2u);
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x93, 0x12, 0x7D));
+}
+
+TEST(SerialMIDIParserBlock, stopAfterSysEx) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0x90, 0x10, 0x7F, 0xF0, 0x01, 0x02, 0xF7, 0x91, 0x11, 0x7E};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 8);
+    EXPECT_EQ(result.bytesConsumed, 7u);
+    ASSERT_EQ(result.numEvents, 2u);
+    EXPECT_EQ(events[0].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[1].event, MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(sparser.getSysExMessage(), SysExMessage(data + 3, 4));
+    result = sparser.parseBlock(data + 7, sizeof(data) - 7, events, 8);
+    EXPECT_EQ(result.bytesConsumed, 3u);
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x91, 0x11, 0x7E));
+}
+
+TEST(SerialMIDIParserBlock, sysExTerminatedByStatus) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0xF0, 0x01, 0x02, 0x91, 0x11, 0x7E};
+    BlockEvent events[8];
+    auto result = sparser.parseBlock(data, sizeof(data), events, 8);
+    EXPECT_EQ(result.bytesConsumed, 4u);
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].event, MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(sparser.getSysExMessage(), SysExMessage({0xF0, 0x01, 0x02, 0xF7}));
+    // The status byte that terminated the SysEx message is resumed first
+    result = sparser.parseBlock(data + 4, sizeof(data) - 4, events, 8);
+    EXPECT_EQ(result.bytesConsumed, 2u);
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x91, 0x11, 0x7E));
+}
+
+TEST(SerialMIDIParserBlock, sameAsPull) {
+    std::vector<uint8_t> data = {0x80, 0x10, 0x00, 0x11, 0x01, 0xF8, 0x12};
+    data.push_back(0x02);
+    data.push_back(0xF0);
+    for (uint8_t i = 0; i < SYSEX_BUFFER_SIZE + 10; ++i)
+        data.push_back(i & 0x7F);
+    data.push_back(0xF7);
+    std::vector<uint8_t> tail = {0xE5, 0x01, 0x02, 0x03, 0x04, 0xF6, 0xD0,
+                                 0x10, 0x11, 0xFE, 0x12, 0xF2, 0x01, 0x02,
+                                 0x90, 0x10, 0x7F, 0xF0, 0x01, 0xF7};
+    data.insert(data.end(), tail.begin(), tail.end());
+
+    struct Event {
+        MIDIReadEvent event;
+        MIDIMessage message;
+        SysExVector sysex;
+        bool operator==(const Event &o) const {
+            return event == o.event && message == o.message && sysex == o.sysex;
+        }
+    };
+    auto getSysEx = [](const SerialMIDI_Parser &p) {
+        auto msg = p.getSysExMessage();
+        return SysExVector(msg.data, msg.data + msg.length);
+    };
+
+    std::vector<Event> expected;
+    SerialMIDI_Parser ref;
+    auto puller = BufferPuller(data.data(), data.size());
+    for (auto evt = ref.pull(puller); evt != MIDIReadEvent::NO_MESSAGE;
+         evt = ref.pull(puller)) {
+        bool sysex = evt == MIDIReadEvent::SYSEX_MESSAGE ||
+                     evt == MIDIReadEvent::SYSEX_CHUNK;
+        MIDIMessage msg = evt == MIDIReadEvent::REALTIME_MESSAGE
+                              ? MIDIMessage(ref.getRealTimeMessage().message, 0, 0)
+                          : sysex ? MIDIMessage(0, 0, 0)
+                                  : MIDIMessage(ref.getChannelMessage());
+        expected.push_back({evt, msg, sysex ? getSysEx(ref) : SysExVector{}});
+    }
+    ASSERT_GT(expected.size(), 10u);
+
+    for (size_t blockSize : {1, 2, 3, 7, 64, 1024}) {
+        for (size_t maxEvents : {1, 2, 5, 64}) {
+            SerialMIDI_Parser sparser;
+            std::vector<Event> actual;
+            std::vector<BlockEvent> events(maxEvents);
+            for (size_t i = 0; i < data.size(); i += blockSize) {
+                size_t length = std::min(blockSize, data.size() - i);
+                const uint8_t *begin = data.data() + i;
+                SerialMIDI_Parser::BlockResult result;
+                do {
+                    result = sparser.parseBlock(begin, length, events.data(),
+                                                maxEvents);
+                    begin += result.bytesConsumed;
+                    length -= result.bytesConsumed;
+                    for (size_t j = 0; j < result.numEvents; ++j) {
+                        auto evt = events[j].event;
+                        bool sysex = evt == MIDIReadEvent::SYSEX_MESSAGE ||
+                                     evt == MIDIReadEvent::SYSEX_CHUNK;
+                        actual.push_back(
+                            {evt, sysex ? MIDIMessage(0, 0, 0) : events[j].message,
+                             sysex ? getSysEx(sparser) : SysExVector{}});
+                    }
+                } while (length > 0 || result.numEvents > 0);
+            }
+            EXPECT_TRUE(actual == expected)
+                << "blockSize=" << blockSize << ", maxEvents=" << maxEvents;
+        }
+    }
+}
+
+// --------------------------- USB PARSER BLOCK API ------------------------- //
+
+TEST(USBMIDIParserBlock, channelAndRealTime) {
+    USBMIDI_Parser uparser;
+    Packet_t data[] = {
+        {{0x09, 0x93, 0x10, 0x7F}},
+        {{0x5F, 0xF8, 0x00, 0x00}},
+        {{0x3B, 0xB3, 0x07, 0x40}},
+        {{0x0C, 0xC1, 0x05, 0x00}},
+    };
+    BlockEvent events[8];
+    auto result = uparser.parseBlock(data, 4, events, 8);
+    EXPECT_EQ(result.packetsConsumed, 4u);
+    ASSERT_EQ(result.numEvents, 4u);
+    EXPECT_EQ(events[0].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x93, 0x10, 0x7F, CABLE_1));
+    EXPECT_EQ(events[1].event, MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(events[1].message, MIDIMessage(0xF8, 0x00, 0x00, CABLE_6));
+    EXPECT_EQ(events[2].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[2].message, MIDIMessage(0xB3, 0x07, 0x40, CABLE_4));
+    EXPECT_EQ(events[3].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[3].message, MIDIMessage(0xC1, 0x05, 0x00, CABLE_1));
+    EXPECT_EQ(uparser.getChannelMessage(), ChannelMessage(0xC1, 0x05, 0x00));
+    EXPECT_EQ(uparser.getRealTimeMessage(), RealTimeMessage(0xF8, CABLE_6));
+}
+
+TEST(USBMIDIParserBlock, eventsFull) {
+    USBMIDI_Parser uparser;
+    Packet_t data[] = {
+        {{0x09, 0x93, 0x10, 0x7F}},
+        {{0x09, 0x93, 0x11, 0x7E}},
+        {{0x09, 0x93, 0x12, 0x7D}},
+    };
+    BlockEvent events[2];
+    auto result = uparser.parseBlock(data, 3, events, 2);
+    EXPECT_EQ(result.packetsConsumed, 2u);
+    ASSERT_EQ(result.numEvents, 2u);
+    EXPECT_EQ(events[1].message, MIDIMessage(0x93, 0x11, 0x7E));
+    result = uparser.parseBlock(data + 2, 1, events, 2);
+    EXPECT_EQ(result.packetsConsumed, 1u);
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x93, 0x12, 0x7D));
+}
+
+TEST(USBMIDIParserBlock, stopAfterSysEx) {
+    USBMIDI_Parser uparser;
+    Packet_t data[] = {
+        {{0x29, 0x90, 0x10, 0x7F}},
+        {{0x24, 0xF0, 0x01, 0x02}},
+        {{0x25, 0xF7, 0x00, 0x00}},
+        {{0x29, 0x91, 0x11, 0x7E}},
+    };
+    BlockEvent events[8];
+    auto result = uparser.parseBlock(data, 4, events, 8);
+    EXPECT_EQ(result.packetsConsumed, 3u);
+    ASSERT_EQ(result.numEvents, 2u);
+    EXPECT_EQ(events[0].event, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(events[1].event, MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(uparser.getSysExMessage(),
+              SysExMessage({0xF0, 0x01, 0x02, 0xF7}, CABLE_3));
+    result = uparser.parseBlock(data + 3, 1, events, 8);
+    EXPECT_EQ(result.packetsConsumed, 1u);
+    ASSERT_EQ(result.numEvents, 1u);
+    EXPECT_EQ(events[0].message, MIDIMessage(0x91, 0x11, 0x7E, CABLE_3));
+}
+
+TEST(USBMIDIParserBlock, sameAsPull) {
+    std::vector<Packet_t> data = {
+        {{0x08, 0x80, 0x10, 0x00}}, {{0x1F, 0xF8, 0x00, 0x00}},
+        {{0x02, 0xF3, 0x05, 0x00}}, {{0x13, 0xF2, 0x01, 0x02}},
+        {{0x05, 0xF6, 0x00, 0x00}}, {{0xFE, 0xE5, 0x01, 0x02}},
+    };
+    // Interleaved SysEx messages on two cables that don't fit in the buffer
+    data.push_back({{0x04, 0xF0, 0x01, 0x02}});
+    data.push_back({{0x14, 0xF0, 0x11, 0x12}});
+    for (uint8_t i = 0; i < SYSEX_BUFFER_SIZE / 3 + 4; ++i) {
+        data.push_back({{0x04, uint8_t(i & 0x7F), 0x03, 0x04}});
+        data.push_back({{0x14, uint8_t(i & 0x7F), 0x13, 0x14}});
+        if (i % 5 == 0)
+            data.push_back({{0x19, 0x91, i, 0x7F}});
+    }
+    data.push_back({{0x07, 0x05, 0x06, 0xF7}});
+    data.push_back({{0x15, 0xF7, 0x00, 0x00}});
+    data.push_back({{0x0D, 0xD0, 0x10, 0x00}});
+    data.push_back({{0x06, 0xF0, 0xF7, 0x00}});
+
+    struct Event {
+        MIDIReadEvent event;
+        MIDIMessage message;
+        SysExVector sysex;
+        bool operator==(const Event &o) const {
+            return event == o.event && message == o.message && sysex == o.sysex;
+        }
+    };
+    auto getSysEx = [](const USBMIDI_Parser &p) {
+        auto msg = p.getSysExMessage();
+        SysExVector v(msg.data, msg.data + msg.length);
+        v.push_back(msg.cable.getRaw());
+        return v;
+    };
+    auto getMessage = [](const USBMIDI_Parser &p, MIDIReadEvent evt) {
+        switch (evt) {
+            case MIDIReadEvent::REALTIME_MESSAGE: {
+                auto rt = p.getRealTimeMessage();
+                return MIDIMessage(rt.message, 0, 0, rt.cable);
+            }
+            case MIDIReadEvent::CHANNEL_MESSAGE:
+                return MIDIMessage(p.getChannelMessage());
+            case MIDIReadEvent::SYSCOMMON_MESSAGE:
+                return MIDIMessage(p.getSysCommonMessage());
+            case MIDIReadEvent::NO_MESSAGE:
+            case MIDIReadEvent::SYSEX_MESSAGE:
+            case MIDIReadEvent::SYSEX_CHUNK:
+            default: return MIDIMessage(0, 0, 0);
+        }
+    };
+
+    std::vector<Event> expected;
+    USBMIDI_Parser ref;
+    auto puller = BufferPuller(data);
+    for (auto evt = ref.pull(puller); evt != MIDIReadEvent::NO_MESSAGE;
+         evt = ref.pull(puller)) {
+        bool sysex = evt == MIDIReadEvent::SYSEX_MESSAGE ||
+                     evt == MIDIReadEvent::SYSEX_CHUNK;
+        expected.push_back({evt, getMessage(ref, evt),
+                            sysex ? getSysEx(ref) : SysExVector{}});
+    }
+    ASSERT_GT(expected.size(), 10u);
+
+    for (size_t blockSize : {1, 2, 3, 16, 1024}) {
+        for (size_t maxEvents : {1, 2, 16}) {
+            USBMIDI_Parser uparser;
+            std::vector<Event> actual;
+            std::vector<BlockEvent> events(maxEvents);
+            for (size_t i = 0; i < data.size(); i += blockSize) {
+                size_t count = std::min(blockSize, data.size() - i);
+                const Packet_t *begin = data.data() + i;
+                USBMIDI_Parser::BlockResult result;
+                do {
+                    result = uparser.parseBlock(begin, count, events.data(),
+                                                maxEvents);
+                    begin += result.packetsConsumed;
+                    count -= result.packetsConsumed;
+                    for (size_t j = 0; j < result.numEvents; ++j) {
+                        auto evt = events[j].event;
+                        bool sysex = evt == MIDIReadEvent::SYSEX_MESSAGE ||
+                                     evt == MIDIReadEvent::SYSEX_CHUNK;
+                        actual.push_back(
+                            {evt, sysex ? MIDIMessage(0, 0, 0) : events[j].message,
+                             sysex ? getSysEx(uparser) : SysExVector{}});
+                    }
+                } while (count > 0 || result.numEvents > 0);
+            }
+            EXPECT_TRUE(actual == expected)
+                << "blockSize=" << blockSize << ", maxEvents=" << maxEvents;
+        }
+    }
+}
+
+// ------------------------------ SYSEX SINK -------------------------------- //
+
+#if !IGNORE_SYSEX
+
+struct RecordingSysExSink : SysExSink {
+    void onSysExBegin(Cable cable) override {
+        data.clear();
+        this->cable = cable;
+        ++begins;
+    }
+    void onSysExContinue(SysExMessage chunk) override {
+        EXPECT_EQ(chunk.cable, cable);
+        data.insert(data.end(), chunk.data, chunk.data + chunk.length);
+        if (chunk.data >= input.first && chunk.data < input.second)
+            ++chunksInInput;
+        ++chunks;
+    }
+    void onSysExEnd(Cable cable) override {
+        EXPECT_EQ(cable, this->cable);
+        messages.push_back(data);
+    }
+    std::vector<SysExVector> messages;
+    SysExVector data;
+    Cable cable = CABLE_1;
+    size_t begins = 0, chunks = 0, chunksInInput = 0;
+    std::pair<const uint8_t *, const uint8_t *> input;
+};
+
+static SysExVector getLargeSysEx(size_t length) {
+    SysExVector data(length);
+    data.front() = 0xF0;
+    for (size_t i = 1; i < length - 1; ++i)
+        data[i] = (i * 31) & 0x7F;
+    data.back() = 0xF7;
+    return data;
+}
+
+TEST(SerialMIDIParserSysExSink, pull) {
+    SerialMIDI_Parser sparser;
+    RecordingSysExSink sink;
+    sparser.setSysExSink(&sink);
+    uint8_t data[] = {0x90, 0x10, 0x7F, 0xF0, 0x01, 0xF8,
+                      0x02, 0xF7, 0x91, 0x11, 0x7E};
+    auto puller = BufferPuller(data);
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::REALTIME_MESSAGE);
+    // Short messages are returned as well
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(sparser.getSysExMessage(), SysExMessage({0xF0, 0x01, 0x02, 0xF7}));
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.getChannelMessage(), ChannelMessage(0x91, 0x11, 0x7E));
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
+    ASSERT_EQ(sink.messages.size(), 1u);
+    EXPECT_EQ(sink.messages[0], SysExVector({0xF0, 0x01, 0x02, 0xF7}));
+}
+
+TEST(SerialMIDIParserSysExSink, terminatedByStatus) {
+    SerialMIDI_Parser sparser;
+    RecordingSysExSink sink;
+    sparser.setSysExSink(&sink);
+    uint8_t data[] = {0xF0, 0x01, 0x02, 0x91, 0x11, 0x7E};
+    auto puller = BufferPuller(data);
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(sparser.getSysExMessage(), SysExMessage({0xF0, 0x01, 0x02, 0xF7}));
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.getChannelMessage(), ChannelMessage(0x91, 0x11, 0x7E));
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
+    ASSERT_EQ(sink.messages.size(), 1u);
+    EXPECT_EQ(sink.messages[0], SysExVector({0xF0, 0x01, 0x02, 0xF7}));
+}
+
+TEST(SerialMIDIParserSysExSink, longMessageTerminatedByStatus) {
+    SerialMIDI_Parser sparser;
+    RecordingSysExSink sink;
+    sparser.setSysExSink(&sink);
+    SysExVector data = getLargeSysEx(SYSEX_BUFFER_SIZE + 1);
+    SysExVector message = data;
+    data.back() = 0xF0; // a new message aborts the long one
+    data.insert(data.end(), {0x01, 0x02, 0x91, 0x11, 0x7E});
+    auto puller = BufferPuller(data.data(), data.size());
+    // The long message only goes to the sink
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(sparser.getSysExMessage(), SysExMessage({0xF0, 0x01, 0x02, 0xF7}));
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.getChannelMessage(), ChannelMessage(0x91, 0x11, 0x7E));
+    EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
+    ASSERT_EQ(sink.messages.size(), 2u);
+    message.back() = 0xF7;
+    EXPECT_EQ(sink.messages[0], message);
+    EXPECT_EQ(sink.messages[1], SysExVector({0xF0, 0x01, 0x02, 0xF7}));
+}
+
+TEST(SerialMIDIParserSysExSink, largeBlock) {
+    const size_t size = 64 * 1024;
+    SysExVector data = getLargeSysEx(size);
+    for (int i = 0; i < 3; ++i)
+        data.insert(data.end(), data.begin(), data.begin() + size);
+    SerialMIDI_Parser sparser;
+    RecordingSysExSink sink;
+    sink.input = {data.data(), data.data() + data.size()};
+    sparser.setSysExSink(&sink);
+    SerialMIDI_Parser::BlockEvent events[4];
+    auto result = sparser.parseBlock(data.data(), data.size(), events, 4);
+    EXPECT_EQ(result.bytesConsumed, data.size());
+    EXPECT_EQ(result.numEvents, 0u);
+    ASSERT_EQ(sink.messages.size(), 4u);
+    for (auto &msg : sink.messages)
+        EXPECT_EQ(msg, getLargeSysEx(size));
+    // The data bytes are passed as views into the input buffer, only the
+    // SysEx Start and End bytes are handled one by one.
+    EXPECT_GE(sink.chunksInInput, 4u);
+    EXPECT_LE(sink.chunks, 4u * 4);
+}
+
+TEST(USBMIDIParserSysExSink, large) {
+    const size_t size = 64 * 1024;
+    SysExVector data = getLargeSysEx(size);
+    std::vector<Packet_t> packets;
+    for (auto it = data.begin(); it != data.end(); it += 3) {
+        size_t left = data.end() - it;
+        if (left > 3)
+            packets.push_back({0x54, it[0], it[1], it[2]});
+        else if (left == 3)
+            packets.push_back({0x57, it[0], it[1], it[2]});
+        else if (left == 2)
+            packets.push_back({0x56, it[0], it[1], 0});
+        else
+            packets.push_back({0x55, it[0], 0, 0});
+        if (left < 3)
+            break;
+    }
+    packets.push_back({0x59, 0x93, 0x10, 0x7F});
+    USBMIDI_Parser uparser;
+    RecordingSysExSink sink;
+    uparser.setSysExSink(&sink);
+    auto puller = BufferPuller(packets);
+    EXPECT_EQ(uparser.pull(puller), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(uparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
+    EXPECT_EQ(sink.cable, CABLE_6);
+    EXPECT_EQ(sink.begins, 1u);
+    ASSERT_EQ(sink.messages.size(), 1u);
+    EXPECT_EQ(sink.messages[0], data);
+}
+
+TEST(USBMIDIParserSysExSink, short) {
+    std::vector<Packet_t> packets = {
+        {0x54, 0xF0, 0x01, 0x02},
+        {0x56, 0x03, 0xF7, 0x00},
+    };
+    USBMIDI_Parser uparser;
+    RecordingSysExSink sink;
+    uparser.setSysExSink(&sink);
+    auto puller = BufferPuller(packets);
+    EXPECT_EQ(uparser.pull(puller), MIDIReadEvent::SYSEX_MESSAGE);
+    SysExVector expected = {0xF0, 0x01, 0x02, 0x03, 0xF7};
+    EXPECT_EQ(uparser.getSysExMessage(),
+              SysExMessage(expected.data(), expected.size(), CABLE_6));
+    EXPECT_EQ(uparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
+    ASSERT_EQ(sink.messages.size(), 1u);
+    EXPECT_EQ(sink.messages[0], expected);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <AH/Hardware/ExtendedInputOutput/ExtendedIOElement.hpp>
+#include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace AH;
+
+// An 8-pin element that doesn't do any I/O, so only the cost of finding the
+// element is measured.
+struct NullExtIOElement : ExtendedIOElement {
+    NullExtIOElement() : ExtendedIOElement(8) {}
+    void pinModeBuffered(pin_t, PinMode_t) override {}
+    void digitalWriteBuffered(pin_t, PinStatus_t) override {}
+    PinStatus_t digitalReadBuffered(pin_t pin) override { return pin & 1; }
+    analog_t analogReadBuffered(pin_t) override { return 0; }
+    void analogWriteBuffered(pin_t, analog_t) override {}
+    void begin() override {}
+    void updateBufferedOutputs() override {}
+    void updateBufferedInputs() override {}
+};
+
+// Read every pin of state.range(0) elements, one pin at a time.
+void extioDigitalRead(benchmark::State &state) {
+    std::vector<std::unique_ptr<NullExtIOElement>> elements;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        elements.emplace_back(new NullExtIOElement);
+    const pin_t start = elements.front()->getStart();
+    const pin_t end = elements.back()->getEnd();
+    for (auto _ : state)
+        for (pin_t pin = start; pin < end; ++pin)
+            benchmark::DoNotOptimize(ExtIO::digitalRead(pin));
+    state.SetItemsProcessed(state.iterations() * (end - start));
+}
+BENCHMARK(extioDigitalRead)->ArgName("elements")->Arg(4)->Arg(24)->Arg(64);
+
+// Read every pin of state.range(0) elements using a single call.
+void extioDigitalReadMany(benchmark::State &state) {
+    std::vector<std::unique_ptr<NullExtIOElement>> elements;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        elements.emplace_back(new NullExtIOElement);
+    const pin_t start = elements.front()->getStart();
+    const pin_t count = elements.back()->getEnd() - start;
+    std::vector<PinStatus_t> values(count);
+    for (auto _ : state) {
+        ExtIO::digitalReadMany(start, values.data(), count);
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(extioDigitalReadMany)->ArgName("elements")->Arg(4)->Arg(24)->Arg(64);
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <AH/Hardware/ExtendedInputOutput/ExtendedIOElement.hpp>
+#include <AH/Hardware/FilteredAnalogBank.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace AH;
+
+// Element whose analog inputs return the current frame of readings, so both
+// paths pay the same (small) cost for reading the inputs.
+struct FrameExtIOElement : ExtendedIOElement {
+    FrameExtIOElement(pin_t length) : ExtendedIOElement(length) {}
+    void pinModeBuffered(pin_t, PinMode_t) override {}
+    void digitalWriteBuffered(pin_t, PinStatus_t) override {}
+    PinStatus_t digitalReadBuffered(pin_t) override { return LOW; }
+    analog_t analogReadBuffered(pin_t pin) override { return frame[pin]; }
+    void analogWriteBuffered(pin_t, analog_t) override {}
+    void begin() override {}
+    void updateBufferedOutputs() override {}
+    void updateBufferedInputs() override {}
+    const analog_t *frame = nullptr;
+};
+
+// Frames of readings of faders that are mostly at rest, with some noise.
+template <uint8_t N>
+std::vector<analog_t> getFrames(size_t count) {
+    std::mt19937 rng {0x1234};
+    std::vector<analog_t> frames(count * N);
+    for (uint8_t i = 0; i < N; ++i)
+        frames[i] = rng() % 1024;
+    for (size_t f = 1; f < count; ++f)
+        for (uint8_t i = 0; i < N; ++i)
+            frames[f * N + i] = constrain(
+                int(frames[(f - 1) * N + i]) + int(rng() % 5) - 2, 0, 1023);
+    return frames;
+}
+
+constexpr size_t NumFrames = 64;
+
+// The current path: one FilteredAnalog object per fader.
+template <uint8_t N>
+void filteredAnalogSeparate(benchmark::State &state) {
+    auto frames = getFrames<N>(NumFrames);
+    FrameExtIOElement el {N};
+    std::vector<FilteredAnalog<7>> faders;
+    for (uint8_t i = 0; i < N; ++i)
+        faders.emplace_back(el.pin(i));
+    for (auto _ : state) {
+        for (size_t f = 0; f < NumFrames; ++f) {
+            el.frame = &frames[f * N];
+            for (auto &fader : faders)
+                benchmark::DoNotOptimize(fader.update());
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * NumFrames * N);
+}
+
+// All faders in one FilteredAnalogBank, reading the inputs.
+template <uint8_t N>
+void filteredAnalogBank(benchmark::State &state) {
+    auto frames = getFrames<N>(NumFrames);
+    FrameExtIOElement el {N};
+    Array<pin_t, N> pins;
+    for (uint8_t i = 0; i < N; ++i)
+        pins[i] = el.pin(i);
+    FilteredAnalogBank<N, 7> bank = pins;
+    for (auto _ : state) {
+        for (size_t f = 0; f < NumFrames; ++f) {
+            el.frame = &frames[f * N];
+            benchmark::DoNotOptimize(bank.update());
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * NumFrames * N);
+}
+
+// Only the filter kernel, with the readings already in a buffer (e.g. from
+// an AnalogScanner or DMA).
+template <uint8_t N>
+void filteredAnalogBankKernel(benchmark::State &state) {
+    auto frames = getFrames<N>(NumFrames);
+    FilteredAnalogBank<N, 7> bank = Array<pin_t, N> {};
+    for (auto _ : state) {
+        for (size_t f = 0; f < NumFrames; ++f)
+            benchmark::DoNotOptimize(bank.update(&frames[f * N]));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * NumFrames * N);
+}
+
+BENCHMARK_TEMPLATE(filteredAnalogSeparate, 32);
+BENCHMARK_TEMPLATE(filteredAnalogBank, 32);
+BENCHMARK_TEMPLATE(filteredAnalogBankKernel, 32);
+BENCHMARK_TEMPLATE(filteredAnalogSeparate, 128);
+BENCHMARK_TEMPLATE(filteredAnalogBank, 128);
+BENCHMARK_TEMPLATE(filteredAnalogBankKernel, 128);
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <AH/Hardware/RegisterEncoders.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace AH;
+
+// Sequence of register states where a single random encoder moves one step at
+// a time, which is what the encoder ISR usually sees.
+template <class RegisterType, uint8_t NumEnc>
+std::vector<RegisterType> getSingleStepStates(size_t count) {
+    std::mt19937 rng {0x1234};
+    std::vector<RegisterType> states;
+    states.reserve(count);
+    RegisterType state = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t enc = rng() % NumEnc;
+        // Flip pin A or pin B, which is always a valid quadrature step
+        state ^= RegisterType(1) << (2 * enc + rng() % 2);
+        states.push_back(state);
+    }
+    return states;
+}
+
+template <class RegisterType, uint8_t NumEnc, bool Bitwise>
+void registerEncodersUpdate(benchmark::State &state) {
+    auto states = getSingleStepStates<RegisterType, NumEnc>(1024);
+    RegisterEncoders<RegisterType, NumEnc, int32_t> encs;
+    encs.reset(0);
+    for (auto _ : state) {
+        for (RegisterType s : states)
+            benchmark::DoNotOptimize(Bitwise ? encs.updateBitwise(s)
+                                             : encs.updateLUT(s));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+BENCHMARK_TEMPLATE(registerEncodersUpdate, uint16_t, 8, false);
+BENCHMARK_TEMPLATE(registerEncodersUpdate, uint16_t, 8, true);
+BENCHMARK_TEMPLATE(registerEncodersUpdate, uint64_t, 32, false);
+BENCHMARK_TEMPLATE(registerEncodersUpdate, uint64_t, 32, true);
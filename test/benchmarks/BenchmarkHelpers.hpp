@@ -0,0 +1,34 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+/// Get the total number of calls to the global `operator new` so far.
+/// Defined in benchmark-main.cpp, which replaces the global allocation
+/// functions.
+size_t getAllocationCount();
+
+/// Counts the heap allocations between its construction and a call to
+/// @ref get.
+class AllocationCounter {
+  public:
+    AllocationCounter() : start(getAllocationCount()) {}
+    size_t get() const { return getAllocationCount() - start; }
+
+  private:
+    size_t start;
+};
+
+/// Report the throughput and the number of allocations per message.
+/// Google Benchmark reports `time/msg` as an inverted rate, i.e. in
+/// (nano)seconds per message.
+inline void reportMessages(benchmark::State &state, size_t numMessages,
+                           size_t numAllocations) {
+    using benchmark::Counter;
+    state.SetItemsProcessed(numMessages);
+    state.counters["time/msg"] =
+        Counter(numMessages, Counter::kIsRate | Counter::kInvert);
+    state.counters["allocs/msg"] =
+        numMessages == 0 ? 0. : double(numAllocations) / numMessages;
+}
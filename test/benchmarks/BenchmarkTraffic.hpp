@@ -0,0 +1,285 @@
+#pragma once
+
+#include <MIDI_Interfaces/BLEMIDI/BLEMIDIPacketBuilder.hpp>
+#include <MIDI_Interfaces/MIDI_Pipes.hpp>
+#include <MIDI_Interfaces/USBMIDI_Sender.hpp>
+#include <MIDI_Parsers/MIDIReadEvent.hpp>
+#include <MIDI_Parsers/USBMIDI_Parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+/// Realistic MIDI traffic profiles to feed to the benchmarks, and functions to
+/// encode them for the different transports.
+namespace traffic {
+
+using namespace CS;
+
+/// A single message of a traffic profile.
+struct Event {
+    Event(MIDIReadEvent type, MIDIMessage message)
+        : type(type), message(message) {}
+    Event(std::vector<uint8_t> sysex)
+        : type(MIDIReadEvent::SYSEX_MESSAGE), message(0xF0, 0x00, 0x00),
+          sysex(std::move(sysex)) {}
+
+    MIDIReadEvent type;
+    /// Channel, System Common or Real-Time (in the header) message.
+    MIDIMessage message;
+    /// Complete System Exclusive message, including 0xF0 and 0xF7.
+    std::vector<uint8_t> sysex;
+};
+using Traffic = std::vector<Event>;
+
+inline Event channel(uint8_t header, uint8_t d1, uint8_t d2 = 0x00) {
+    return {MIDIReadEvent::CHANNEL_MESSAGE, {header, d1, d2}};
+}
+inline Event realtime(uint8_t rt) {
+    return {MIDIReadEvent::REALTIME_MESSAGE, {rt, 0x00, 0x00}};
+}
+inline Event syscommon(uint8_t header, uint8_t d1 = 0x00, uint8_t d2 = 0x00) {
+    return {MIDIReadEvent::SYSCOMMON_MESSAGE, {header, d1, d2}};
+}
+
+/// Feedback from a DAW to a Mackie Control Universal: VU meters (Channel
+/// Pressure), V-Pot rings (Control Change), motorized faders (Pitch Bend),
+/// and every 32 messages an LCD update (SysEx).
+inline Traffic getMCUFeedback(size_t numMessages) {
+    Traffic t;
+    t.reserve(numMessages);
+    for (size_t i = 0; i < numMessages; ++i) {
+        uint8_t track = i % 8;
+        uint8_t value = (i * 7) & 0x7F;
+        if (i % 32 == 31) {
+            std::vector<uint8_t> lcd = {0xF0, 0x00, 0x00, 0x66, 0x14, 0x12,
+                                        uint8_t(track * 7)};
+            for (char c : {'V', 'o', 'l', 'u', 'm', 'e', ' '})
+                lcd.push_back(c);
+            lcd.push_back(0xF7);
+            t.emplace_back(std::move(lcd));
+            continue;
+        }
+        switch (i % 3) {
+            case 0: t.push_back(channel(0xD0, (track << 4) | (value & 0xF))); break;
+            case 1: t.push_back(channel(0xB0, 0x30 + track, value)); break;
+            case 2: t.push_back(channel(0xE0 | track, value, value)); break;
+            default: break;
+        }
+    }
+    return t;
+}
+
+/// Timing Clock from a sequencer (24 PPQN), with a Note On/Off every 6 ticks
+/// and a Song Position Pointer every 96 ticks.
+inline Traffic getClockTraffic(size_t numMessages) {
+    Traffic t;
+    t.reserve(numMessages);
+    t.push_back(realtime(0xFA));
+    for (size_t i = 1; i < numMessages; ++i) {
+        if (i % 96 == 0)
+            t.push_back(syscommon(0xF2, (i / 6) & 0x7F, (i / 768) & 0x7F));
+        else if (i % 6 == 0)
+            t.push_back(channel(0x99, 0x24 + (i / 6) % 4, (i / 6) % 2 * 0x7F));
+        else
+            t.push_back(realtime(0xF8));
+    }
+    return t;
+}
+
+/// A number of large System Exclusive dumps, e.g. a synth patch bank.
+inline Traffic getSysExDumps(size_t numDumps, size_t dumpSize) {
+    Traffic t;
+    for (size_t d = 0; d < numDumps; ++d) {
+        std::vector<uint8_t> dump(dumpSize);
+        dump.front() = 0xF0;
+        for (size_t i = 1; i < dumpSize - 1; ++i)
+            dump[i] = (i + d) & 0x7F;
+        dump.back() = 0xF7;
+        t.emplace_back(std::move(dump));
+    }
+    return t;
+}
+
+/// Get a traffic profile by index, to use as a benchmark argument.
+inline Traffic getProfile(int64_t index) {
+    switch (index) {
+        case 0: return getMCUFeedback(1024);
+        case 1: return getClockTraffic(1024);
+        case 2: return getSysExDumps(4, 4096);
+        default: return {};
+    }
+}
+/// Name of the profile returned by @ref getProfile, to use as a label.
+inline const char *getProfileName(int64_t index) {
+    switch (index) {
+        case 0: return "MCU feedback";
+        case 1: return "clock";
+        case 2: return "SysEx dumps";
+        default: return "";
+    }
+}
+/// Apply the profiles as arguments to the given benchmark.
+inline void allProfiles(benchmark::internal::Benchmark *b) {
+    b->ArgName("profile")->DenseRange(0, 2);
+}
+
+/// Send all messages of the given traffic profile from the given source.
+inline void send(MIDI_Source &source, const Traffic &traffic) {
+    for (const Event &e : traffic) {
+        switch (e.type) {
+            case MIDIReadEvent::CHANNEL_MESSAGE:
+                source.sourceMIDItoPipe(ChannelMessage(e.message));
+                break;
+            case MIDIReadEvent::SYSCOMMON_MESSAGE:
+                source.sourceMIDItoPipe(SysCommonMessage(e.message));
+                break;
+            case MIDIReadEvent::REALTIME_MESSAGE:
+                source.sourceMIDItoPipe(RealTimeMessage(e.message.header));
+                break;
+            case MIDIReadEvent::SYSEX_MESSAGE:
+                source.sourceMIDItoPipe(
+                    SysExMessage(e.sysex.data(), e.sysex.size()));
+                break;
+            case MIDIReadEvent::NO_MESSAGE:
+            case MIDIReadEvent::SYSEX_CHUNK:
+            default: break;
+        }
+    }
+}
+
+/// Encode as a serial MIDI byte stream, using running status.
+inline std::vector<uint8_t> toSerial(const Traffic &traffic) {
+    std::vector<uint8_t> data;
+    uint8_t runningStatus = 0;
+    for (const Event &e : traffic) {
+        const MIDIMessage &m = e.message;
+        switch (e.type) {
+            case MIDIReadEvent::CHANNEL_MESSAGE:
+                if (m.header != runningStatus)
+                    data.push_back(runningStatus = m.header);
+                data.push_back(m.data1);
+                if (ChannelMessage(m).hasTwoDataBytes())
+                    data.push_back(m.data2);
+                break;
+            case MIDIReadEvent::SYSCOMMON_MESSAGE: {
+                runningStatus = 0;
+                data.push_back(m.header);
+                uint8_t n = SysCommonMessage(m).getNumberOfDataBytes();
+                if (n >= 1)
+                    data.push_back(m.data1);
+                if (n >= 2)
+                    data.push_back(m.data2);
+            } break;
+            case MIDIReadEvent::REALTIME_MESSAGE:
+                data.push_back(m.header);
+                break;
+            case MIDIReadEvent::SYSEX_MESSAGE:
+                runningStatus = 0;
+                data.insert(data.end(), e.sysex.begin(), e.sysex.end());
+                break;
+            case MIDIReadEvent::NO_MESSAGE:
+            case MIDIReadEvent::SYSEX_CHUNK:
+            default: break;
+        }
+    }
+    return data;
+}
+
+using USBPacket = USBMIDI_Parser::MIDIUSBPacket_t;
+
+/// Encode as USB MIDI event packets.
+inline std::vector<USBPacket> toUSB(const Traffic &traffic) {
+    std::vector<USBPacket> packets;
+    USBMIDI_Sender sender;
+    auto write = [&](Cable cn, MIDICodeIndexNumber cin, uint8_t d0,
+                     uint8_t d1, uint8_t d2) {
+        packets.push_back({uint8_t((cn.getRaw() << 4) | uint8_t(cin)), d0, d1,
+                           d2});
+    };
+    for (const Event &e : traffic) {
+        switch (e.type) {
+            case MIDIReadEvent::CHANNEL_MESSAGE:
+                sender.sendChannelMessage(ChannelMessage(e.message), write);
+                break;
+            case MIDIReadEvent::SYSCOMMON_MESSAGE:
+                sender.sendSysCommonMessage(SysCommonMessage(e.message), write);
+                break;
+            case MIDIReadEvent::REALTIME_MESSAGE:
+                sender.sendRealTimeMessage(e.message.header, write);
+                break;
+            case MIDIReadEvent::SYSEX_MESSAGE:
+                sender.sendFullSysEx({e.sysex.data(), uint16_t(e.sysex.size())}, write);
+                break;
+            case MIDIReadEvent::NO_MESSAGE:
+            case MIDIReadEvent::SYSEX_CHUNK:
+            default: break;
+        }
+    }
+    return packets;
+}
+
+/// Add a single event to the BLE packet builder, calling `flush` whenever a
+/// packet is full. Mirrors BluetoothMIDI_Interface.
+template <class Flush>
+void addToBLE(BLEMIDIPacketBuilder &builder, const Event &e, uint16_t ts,
+              Flush &&flush) {
+    const MIDIMessage &m = e.message;
+    auto retry = [&](auto add) {
+        if (!add()) {
+            flush();
+            add();
+        }
+    };
+    switch (e.type) {
+        case MIDIReadEvent::CHANNEL_MESSAGE:
+            if (ChannelMessage(m).hasTwoDataBytes())
+                retry([&] { return builder.add3B(m.header, m.data1, m.data2, ts); });
+            else
+                retry([&] { return builder.add2B(m.header, m.data1, ts); });
+            break;
+        case MIDIReadEvent::SYSCOMMON_MESSAGE: {
+            uint8_t n = SysCommonMessage(m).getNumberOfDataBytes();
+            retry([&] {
+                return builder.addSysCommon(n, m.header, m.data1, m.data2, ts);
+            });
+        } break;
+        case MIDIReadEvent::REALTIME_MESSAGE:
+            retry([&] { return builder.addRealTime(m.header, ts); });
+            break;
+        case MIDIReadEvent::SYSEX_MESSAGE: {
+            const uint8_t *data = e.sysex.data();
+            size_t length = e.sysex.size();
+            if (!builder.addSysEx(data, length, ts)) {
+                flush();
+                builder.addSysEx(data, length, ts);
+            }
+            while (data) {
+                flush();
+                builder.continueSysEx(data, length, ts);
+            }
+        } break;
+        case MIDIReadEvent::NO_MESSAGE:
+        case MIDIReadEvent::SYSEX_CHUNK:
+        default: break;
+    }
+}
+
+/// Encode as BLE MIDI packets with the given maximum size.
+inline std::vector<std::vector<uint8_t>> toBLE(const Traffic &traffic,
+                                               uint16_t packetSize) {
+    std::vector<std::vector<uint8_t>> packets;
+    BLEMIDIPacketBuilder builder {packetSize};
+    auto flush = [&] {
+        packets.push_back(builder.getPacket());
+        builder.reset();
+    };
+    uint16_t ts = 0;
+    for (const Event &e : traffic)
+        addToBLE(builder, e, ts++ & 0x1FFF, flush);
+    if (!builder.empty())
+        flush();
+    return packets;
+}
+
+} // namespace traffic
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <Control_Surface/Control_Surface_Class.hpp>
+#include <MIDI_Inputs/MCU/LCD.hpp>
+#include <MIDI_Inputs/MCU/VPotRing.hpp>
+#include <MIDI_Inputs/MCU/VU.hpp>
+#include <MIDI_Inputs/PBValue.hpp>
+
+using namespace CS;
+
+// Dispatch Mackie Control feedback to the input elements of an 8-track
+// control surface (VU meters, V-Pot rings, faders and the LCD), the way it
+// would arrive from a USB MIDI interface.
+// The VU meters call millis() for their decay, which goes through the Google
+// Mock ArduinoMock and accounts for the allocations.
+static void controlSurfaceMCUFeedback(benchmark::State &state) {
+    auto profile = traffic::getMCUFeedback(1024);
+    MCU::VU vus[] {{1, CHANNEL_1}, {2, CHANNEL_1}, {3, CHANNEL_1},
+                   {4, CHANNEL_1}, {5, CHANNEL_1}, {6, CHANNEL_1},
+                   {7, CHANNEL_1}, {8, CHANNEL_1}};
+    MCU::VPotRing vpots[] {1, 2, 3, 4, 5, 6, 7, 8};
+    PBValue faders[] {{CHANNEL_1}, {CHANNEL_2}, {CHANNEL_3}, {CHANNEL_4},
+                      {CHANNEL_5}, {CHANNEL_6}, {CHANNEL_7}, {CHANNEL_8}};
+    MCU::LCD<> lcd;
+    benchmark::DoNotOptimize(vus);
+    benchmark::DoNotOptimize(vpots);
+    benchmark::DoNotOptimize(faders);
+    benchmark::DoNotOptimize(lcd);
+
+    TrueMIDI_Source source;
+    MIDI_Pipe pipe;
+    Control_Surface.disconnectMIDI_Interfaces();
+    source >> pipe >> Control_Surface;
+
+    AllocationCounter allocations;
+    for (auto _ : state)
+        traffic::send(source, profile);
+    reportMessages(state, state.iterations() * profile.size(),
+                   allocations.get());
+    Control_Surface.disconnectMIDI_Interfaces();
+}
+BENCHMARK(controlSurfaceMCUFeedback);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <Control_Surface/Control_Surface_Class.hpp>
+#include <MIDI_Inputs/MIDIInputElementMatchers.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace CS;
+
+// Same as TwoByteMIDIMatcher, but without support for the index, so elements
+// using it are checked one by one.
+struct LinearTwoByteMIDIMatcher {
+    LinearTwoByteMIDIMatcher(MIDIAddress address) : matcher(address) {}
+    using Result = TwoByteMIDIMatcher::Result;
+    Result operator()(ChannelMessage m) { return matcher(m); }
+    TwoByteMIDIMatcher matcher;
+};
+
+template <class Matcher>
+struct NoteElement
+    : MatchingMIDIInputElement<MIDIMessageType::NOTE_ON, Matcher> {
+    NoteElement(MIDIAddress address)
+        : MatchingMIDIInputElement<MIDIMessageType::NOTE_ON, Matcher>(
+              Matcher(address)) {}
+    void handleUpdate(typename Matcher::Result match) override {
+        value = match.value;
+    }
+    uint8_t value = 0;
+};
+
+// Send Note messages to Control_Surface, each message is addressed to a
+// different one of the state.range(0) elements.
+template <class Matcher>
+void sinkNoteToControlSurface(benchmark::State &state) {
+    const uint8_t numElements = state.range(0);
+    std::vector<std::unique_ptr<NoteElement<Matcher>>> elements;
+    for (uint8_t i = 0; i < numElements; ++i)
+        elements.emplace_back(new NoteElement<Matcher>({i, CHANNEL_1}));
+
+    TrueMIDI_Source source;
+    MIDI_Pipe pipe;
+    Control_Surface.disconnectMIDI_Interfaces();
+    source >> pipe >> Control_Surface;
+
+    uint8_t address = 0;
+    for (auto _ : state) {
+        source.sourceMIDItoPipe(ChannelMessage {
+            MIDIMessageType::NOTE_ON,
+            CHANNEL_1,
+            address,
+            0x7F,
+        });
+        if (++address == numElements)
+            address = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    Control_Surface.disconnectMIDI_Interfaces();
+}
+
+BENCHMARK_TEMPLATE(sinkNoteToControlSurface, TwoByteMIDIMatcher)
+    ->RangeMultiplier(4)
+    ->Range(1, MIDI_INPUT_INDEX_SIZE);
+BENCHMARK_TEMPLATE(sinkNoteToControlSurface, LinearTwoByteMIDIMatcher)
+    ->RangeMultiplier(4)
+    ->Range(1, MIDI_INPUT_INDEX_SIZE);
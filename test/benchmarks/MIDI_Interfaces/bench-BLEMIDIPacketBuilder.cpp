@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Interfaces/BLEMIDI/BLEMIDIPacketBuilder.hpp>
+
+using namespace CS;
+
+// Pack a traffic profile into BLE MIDI packets of the given size, the same way
+// BluetoothMIDI_Interface does, discarding the packets when they're full.
+static void blePacketBuilderProfile(benchmark::State &state) {
+    auto profile = traffic::getProfile(state.range(0));
+    const uint16_t packetSize = state.range(1);
+    size_t numPackets = 0, numBytes = 0;
+    BLEMIDIPacketBuilder builder {packetSize};
+    auto flush = [&] {
+        benchmark::DoNotOptimize(builder.getBuffer());
+        ++numPackets;
+        numBytes += builder.getSize();
+        builder.reset();
+    };
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        uint16_t ts = 0;
+        for (const traffic::Event &e : profile)
+            traffic::addToBLE(builder, e, ts++ & 0x1FFF, flush);
+        if (!builder.empty())
+            flush();
+    }
+    reportMessages(state, state.iterations() * profile.size(),
+                   allocations.get());
+    state.counters["packets"] = double(numPackets) / state.iterations();
+    state.counters["bytes/msg"] =
+        double(numBytes) / (state.iterations() * profile.size());
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(blePacketBuilderProfile)
+    ->ArgNames({"profile", "mtu"})
+    ->ArgsProduct({{0, 1, 2}, {20, 182}});
+
+// Compare the packing modes. Messages are generated in bursts of 8 with the
+// same timestamp (e.g. a single iteration of the main loop), which is when
+// running status and timestamp compression pay off.
+static void blePacketBuilderPacking(benchmark::State &state) {
+    auto profile = traffic::getProfile(state.range(0));
+    auto packing = static_cast<BLEMIDIPacketBuilder::Packing>(state.range(1));
+    BLEMIDIPacketBuilder builder {182};
+    builder.setPacking(packing);
+    auto flush = [&] {
+        benchmark::DoNotOptimize(builder.getBuffer());
+        builder.reset();
+    };
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        uint16_t i = 0;
+        for (const traffic::Event &e : profile)
+            traffic::addToBLE(builder, e, (i++ / 8) & 0x1FFF, flush);
+        if (!builder.empty())
+            flush();
+    }
+    reportMessages(state, state.iterations() * profile.size(),
+                   allocations.get());
+    state.counters["bytes/msg"] = builder.getStats().getBytesPerMessage();
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(blePacketBuilderPacking)
+    ->ArgNames({"profile", "optimal"})
+    ->ArgsProduct({{0, 1}, {0, 1}});
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Interfaces/BufferedMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/CoalescingMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/InstrumentedMIDI_Pipe.hpp>
+#include <MIDI_Interfaces/MIDI_Pipes.hpp>
+
+using namespace CS;
+
+struct CountingSink : TrueMIDI_Sink {
+    void sinkMIDIfromPipe(ChannelMessage m) override { count(m.header); }
+    void sinkMIDIfromPipe(SysExMessage m) override { count(m.length); }
+    void sinkMIDIfromPipe(SysCommonMessage m) override { count(m.header); }
+    void sinkMIDIfromPipe(RealTimeMessage m) override { count(m.message); }
+    void count(size_t value) {
+        benchmark::DoNotOptimize(value);
+        ++messages;
+    }
+    size_t messages = 0;
+};
+
+/// Maximum number of sinks or sources in a topology.
+constexpr size_t MaxN = 4;
+
+// Route a traffic profile from a single source to a number of sinks.
+template <class Pipe>
+static void pipeFanOut(benchmark::State &state) {
+    auto profile = traffic::getProfile(state.range(0));
+    const size_t numSinks = state.range(1);
+    TrueMIDI_Source source;
+    CountingSink sinks[MaxN];
+    Pipe pipes[MaxN];
+    for (size_t i = 0; i < numSinks; ++i)
+        source >> pipes[i] >> sinks[i];
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        traffic::send(source, profile);
+        AH::Updatable<>::updateAll();
+        AH::Updatable<MIDIOutputStage>::updateAll();
+    }
+    reportMessages(state, state.iterations() * profile.size() * numSinks,
+                   allocations.get());
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+
+// Merge a traffic profile from a number of sources into a single sink.
+template <class Pipe>
+static void pipeMerge(benchmark::State &state) {
+    auto profile = traffic::getProfile(state.range(0));
+    const size_t numSources = state.range(1);
+    TrueMIDI_Source sources[MaxN];
+    CountingSink sink;
+    Pipe pipes[MaxN];
+    for (size_t i = 0; i < numSources; ++i)
+        sources[i] >> pipes[i] >> sink;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        for (size_t i = 0; i < numSources; ++i)
+            traffic::send(sources[i], profile);
+        AH::Updatable<>::updateAll();
+        AH::Updatable<MIDIOutputStage>::updateAll();
+    }
+    reportMessages(state, state.iterations() * profile.size() * numSources,
+                   allocations.get());
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+
+static void pipeArgs(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"profile", "n"})->ArgsProduct({{0, 1, 2}, {1, MaxN}});
+}
+
+BENCHMARK_TEMPLATE(pipeFanOut, MIDI_Pipe)->Apply(pipeArgs);
+BENCHMARK_TEMPLATE(pipeMerge, MIDI_Pipe)->Apply(pipeArgs);
+// Note: the instrumented pipe calls micros(), which goes through the Google
+// Mock ArduinoMock, so its time and allocations are dominated by the mock.
+BENCHMARK_TEMPLATE(pipeFanOut, InstrumentedMIDI_Pipe)->Apply(pipeArgs);
+BENCHMARK_TEMPLATE(pipeFanOut, BufferedMIDI_Pipe<64>)->Apply(pipeArgs);
+BENCHMARK_TEMPLATE(pipeFanOut, CoalescingMIDI_Pipe<16>)->Apply(pipeArgs);
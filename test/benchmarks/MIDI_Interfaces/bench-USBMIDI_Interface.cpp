@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Interfaces/USBMIDI_Interface.hpp>
+
+using namespace CS;
+
+using Packet = traffic::USBPacket;
+
+// USB MIDI backend that returns one packet at a time from a buffer.
+struct PacketBackend {
+    using MIDIUSBPacket_t = Packet;
+    MIDIUSBPacket_t read() {
+        return index < packets.size() ? packets[index++] : Packet {{0x00}};
+    }
+    void write(MIDIUSBPacket_t) { ++writes; }
+    void sendNow() {}
+    static bool preferImmediateSend() { return false; }
+
+    std::vector<Packet> packets;
+    size_t index = 0;
+    size_t writes = 0;
+};
+
+// USB MIDI backend that can return multiple packets at once, like the
+// backends that receive entire USB endpoint buffers.
+struct BulkBackend : PacketBackend {
+    using PacketBackend::read;
+    size_t read(MIDIUSBPacket_t *p, size_t maxPackets) {
+        size_t n = std::min(maxPackets, packets.size() - index);
+        std::copy_n(packets.begin() + index, n, p);
+        index += n;
+        return n;
+    }
+};
+
+// USB MIDI backend that can write multiple packets at once, like the backends
+// that fill entire USB endpoint buffers.
+struct BulkWriteBackend : PacketBackend {
+    using PacketBackend::write;
+    void write(const MIDIUSBPacket_t *p, size_t numPackets) {
+        benchmark::DoNotOptimize(p);
+        written += numPackets;
+        ++writes;
+    }
+    size_t written = 0;
+};
+
+struct CountingSink : TrueMIDI_Sink {
+    void sinkMIDIfromPipe(ChannelMessage) override { ++messages; }
+    void sinkMIDIfromPipe(SysExMessage) override { ++messages; }
+    void sinkMIDIfromPipe(SysCommonMessage) override { ++messages; }
+    void sinkMIDIfromPipe(RealTimeMessage) override { ++messages; }
+    size_t messages = 0;
+};
+
+// Read a traffic profile from the USB backend and route it to a sink, using
+// either the per-packet or the bulk read path of GenericUSBMIDI_Interface.
+// Note: incoming messages are timestamped using micros(), which goes through
+// the Google Mock ArduinoMock, and adds the same overhead to both paths.
+template <class Backend>
+static void usbInterfaceUpdate(benchmark::State &state) {
+    auto profile = traffic::getProfile(state.range(0));
+    GenericUSBMIDI_Interface<Backend> midi;
+    midi.backend.packets = traffic::toUSB(profile);
+    CountingSink sink;
+    MIDI_Pipe pipe;
+    midi >> pipe >> sink;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        midi.backend.index = 0;
+        midi.update();
+    }
+    reportMessages(state, state.iterations() * profile.size(),
+                   allocations.get());
+    state.counters["packets"] = midi.backend.packets.size();
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK_TEMPLATE(usbInterfaceUpdate, PacketBackend)
+    ->Apply(traffic::allProfiles);
+BENCHMARK_TEMPLATE(usbInterfaceUpdate, BulkBackend)
+    ->Apply(traffic::allProfiles);
+
+// Send a burst of channel messages (the channel messages of the MCU feedback
+// profile) either one at a time, or as a single batch. With a backend that
+// supports bulk writes, the batch is encoded into a buffer and handed to the
+// backend once per USB_MIDI_BLOCK_SIZE packets.
+template <class Backend, bool Batch>
+static void usbInterfaceSendBurst(benchmark::State &state) {
+    std::vector<ChannelMessage> messages;
+    for (const auto &e : traffic::getMCUFeedback(state.range(0)))
+        if (e.type == MIDIReadEvent::CHANNEL_MESSAGE)
+            messages.push_back(ChannelMessage(e.message));
+    GenericUSBMIDI_Interface<Backend> midi;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        if (Batch) {
+            midi.send(messages.data(), messages.size());
+        } else {
+            for (ChannelMessage msg : messages)
+                midi.send(msg);
+        }
+        benchmark::ClobberMemory();
+    }
+    reportMessages(state, state.iterations() * messages.size(),
+                   allocations.get());
+    state.counters["writes/msg"] =
+        double(midi.backend.writes) / (state.iterations() * messages.size());
+}
+BENCHMARK_TEMPLATE(usbInterfaceSendBurst, PacketBackend, false)
+    ->ArgName("burst")->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(usbInterfaceSendBurst, PacketBackend, true)
+    ->ArgName("burst")->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(usbInterfaceSendBurst, BulkWriteBackend, true)
+    ->ArgName("burst")->Arg(16)->Arg(256);
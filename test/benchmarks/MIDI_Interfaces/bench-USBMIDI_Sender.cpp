@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Interfaces/USBMIDI_Sender.hpp>
+
+using namespace CS;
+
+// Encode a traffic profile as USB MIDI packets, writing them to a buffer of
+// the size of a full-speed bulk endpoint, like the USB MIDI backends do.
+static void usbSenderProfile(benchmark::State &state) {
+    auto profile = traffic::getProfile(state.range(0));
+    USBMIDI_Sender sender;
+    uint32_t buffer[16];
+    size_t index = 0, numPackets = 0;
+    auto write = [&](Cable cn, MIDICodeIndexNumber cin, uint8_t d0,
+                     uint8_t d1, uint8_t d2) {
+        uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
+        buffer[index] = uint32_t(cn_cin) | uint32_t(d0) << 8 |
+                        uint32_t(d1) << 16 | uint32_t(d2) << 24;
+        if (++index == 16) {
+            benchmark::DoNotOptimize(buffer);
+            index = 0;
+        }
+        ++numPackets;
+    };
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        for (const traffic::Event &e : profile) {
+            switch (e.type) {
+                case MIDIReadEvent::CHANNEL_MESSAGE:
+                    sender.sendChannelMessage(ChannelMessage(e.message), write);
+                    break;
+                case MIDIReadEvent::SYSCOMMON_MESSAGE:
+                    sender.sendSysCommonMessage(SysCommonMessage(e.message),
+                                                write);
+                    break;
+                case MIDIReadEvent::REALTIME_MESSAGE:
+                    sender.sendRealTimeMessage(e.message.header, write);
+                    break;
+                case MIDIReadEvent::SYSEX_MESSAGE:
+                    sender.sendFullSysEx({e.sysex.data(), uint16_t(e.sysex.size())}, write);
+                    break;
+                case MIDIReadEvent::NO_MESSAGE:
+                case MIDIReadEvent::SYSEX_CHUNK:
+                default: break;
+            }
+        }
+    }
+    reportMessages(state, state.iterations() * profile.size(),
+                   allocations.get());
+    state.counters["packets"] = double(numPackets) / state.iterations();
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(usbSenderProfile)->Apply(traffic::allProfiles);
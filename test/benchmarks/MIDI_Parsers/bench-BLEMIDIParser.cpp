@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Parsers/BLEMIDIParser.hpp>
+#include <MIDI_Parsers/SerialMIDI_Parser.hpp>
+
+using namespace CS;
+
+// Parse BLE MIDI packets the same way BluetoothMIDI_Interface does: the
+// BLEMIDIParser strips the headers and timestamps, and the SerialMIDI_Parser
+// parses the resulting MIDI bytes.
+static void bleParserProfile(benchmark::State &state) {
+    auto packets = traffic::toBLE(traffic::getProfile(state.range(0)),
+                                  state.range(1));
+    size_t numEvents = 0, numBytes = 0;
+    for (auto &packet : packets)
+        numBytes += packet.size();
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        SerialMIDI_Parser parser {false};
+        for (auto &packet : packets) {
+            BLEMIDIParser ble {packet.data(), packet.size()};
+            MIDIReadEvent event;
+            while ((event = parser.pull(ble)) != MIDIReadEvent::NO_MESSAGE) {
+                benchmark::DoNotOptimize(ble.getTimestamp());
+                ++numEvents;
+            }
+        }
+    }
+    reportMessages(state, numEvents, allocations.get());
+    state.SetBytesProcessed(state.iterations() * numBytes);
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(bleParserProfile)
+    ->ArgNames({"profile", "mtu"})
+    ->ArgsProduct({{0, 1, 2}, {20, 182}});
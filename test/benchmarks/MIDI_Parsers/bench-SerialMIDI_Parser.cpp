@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Parsers/BufferPuller.hpp>
+#include <MIDI_Parsers/SerialMIDI_Parser.hpp>
+
+#include <vector>
+
+using namespace CS;
+
+// Dense stream of Control Change messages using running status, with the
+// occasional Timing Clock message in between, as sent by a busy controller.
+static std::vector<uint8_t> getRunningStatusStream(size_t numMessages) {
+    std::vector<uint8_t> data = {0xB0};
+    for (size_t i = 0; i < numMessages; ++i) {
+        if (i % 64 == 63)
+            data.push_back(0xF8);
+        data.push_back(i & 0x7F);
+        data.push_back((i >> 7) & 0x7F);
+    }
+    return data;
+}
+
+static void serialParserPull(benchmark::State &state) {
+    auto data = getRunningStatusStream(state.range(0));
+    size_t numEvents = 0;
+    for (auto _ : state) {
+        SerialMIDI_Parser parser;
+        auto puller = BufferPuller(data);
+        while (parser.pull(puller) != MIDIReadEvent::NO_MESSAGE) {
+            benchmark::DoNotOptimize(parser.getChannelMessage());
+            ++numEvents;
+        }
+    }
+    state.SetItemsProcessed(numEvents);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(serialParserPull)->Arg(1024);
+
+static void serialParserBlock(benchmark::State &state) {
+    auto data = getRunningStatusStream(state.range(0));
+    const size_t blockSize = state.range(1);
+    std::vector<SerialMIDI_Parser::BlockEvent> events(blockSize);
+    size_t numEvents = 0;
+    for (auto _ : state) {
+        SerialMIDI_Parser parser;
+        for (size_t i = 0; i < data.size(); i += blockSize) {
+            const uint8_t *begin = data.data() + i;
+            size_t length = std::min(blockSize, data.size() - i);
+            SerialMIDI_Parser::BlockResult result;
+            do {
+                result = parser.parseBlock(begin, length, events.data(),
+                                           events.size());
+                begin += result.bytesConsumed;
+                length -= result.bytesConsumed;
+                benchmark::DoNotOptimize(events.data());
+                numEvents += result.numEvents;
+            } while (length > 0 || result.numEvents > 0);
+        }
+    }
+    state.SetItemsProcessed(numEvents);
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(serialParserBlock)->Args({1024, 16})->Args({1024, 64});
+
+static void serialParserProfile(benchmark::State &state) {
+    auto data = traffic::toSerial(traffic::getProfile(state.range(0)));
+    size_t numEvents = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        SerialMIDI_Parser parser;
+        auto puller = BufferPuller(data);
+        MIDIReadEvent event;
+        while ((event = parser.pull(puller)) != MIDIReadEvent::NO_MESSAGE) {
+            benchmark::DoNotOptimize(event);
+            ++numEvents;
+        }
+    }
+    reportMessages(state, numEvents, allocations.get());
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(serialParserProfile)->Apply(traffic::allProfiles);
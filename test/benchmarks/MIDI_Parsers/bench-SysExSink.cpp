@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <MIDI_Parsers/BufferPuller.hpp>
+#include <MIDI_Parsers/SerialMIDI_Parser.hpp>
+#include <MIDI_Parsers/USBMIDI_Parser.hpp>
+
+#include <vector>
+
+using namespace CS;
+
+// Throughput of 64 KiB SysEx dumps, buffered in chunks of SYSEX_BUFFER_SIZE
+// bytes versus streamed to a SysExSink.
+
+static constexpr size_t DumpSize = 64 * 1024;
+
+struct ChecksumSysExSink : SysExSink {
+    void onSysExBegin(Cable) override {}
+    void onSysExContinue(SysExMessage chunk) override {
+        for (uint16_t i = 0; i < chunk.length; ++i)
+            checksum += chunk.data[i];
+    }
+    void onSysExEnd(Cable) override {}
+    uint32_t checksum = 0;
+};
+
+static std::vector<uint8_t> getSysExDump() {
+    std::vector<uint8_t> data(DumpSize);
+    for (size_t i = 0; i < DumpSize; ++i)
+        data[i] = i & 0x7F;
+    data.front() = 0xF0;
+    data.back() = 0xF7;
+    return data;
+}
+
+static std::vector<USBMIDI_Parser::MIDIUSBPacket_t> getUSBSysExDump() {
+    auto data = getSysExDump();
+    std::vector<USBMIDI_Parser::MIDIUSBPacket_t> packets;
+    size_t i = 0;
+    for (; i + 3 < data.size(); i += 3)
+        packets.push_back({0x04, data[i], data[i + 1], data[i + 2]});
+    switch (data.size() - i) {
+        case 3:
+            packets.push_back({0x07, data[i], data[i + 1], data[i + 2]});
+            break;
+        case 2: packets.push_back({0x06, data[i], data[i + 1], 0}); break;
+        case 1: packets.push_back({0x05, data[i], 0, 0}); break;
+        default: break;
+    }
+    return packets;
+}
+
+static void sysexSerialBuffered(benchmark::State &state) {
+    auto data = getSysExDump();
+    for (auto _ : state) {
+        SerialMIDI_Parser parser;
+        auto puller = BufferPuller(data);
+        uint32_t checksum = 0;
+        while (parser.pull(puller) != MIDIReadEvent::NO_MESSAGE) {
+            auto msg = parser.getSysExMessage();
+            for (uint16_t i = 0; i < msg.length; ++i)
+                checksum += msg.data[i];
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(sysexSerialBuffered);
+
+static void sysexSerialSinkBlock(benchmark::State &state) {
+    auto data = getSysExDump();
+    const size_t blockSize = state.range(0);
+    for (auto _ : state) {
+        SerialMIDI_Parser parser;
+        ChecksumSysExSink sink;
+        parser.setSysExSink(&sink);
+        SerialMIDI_Parser::BlockEvent events[8];
+        for (size_t i = 0; i < data.size(); i += blockSize) {
+            size_t length = std::min(blockSize, data.size() - i);
+            parser.parseBlock(data.data() + i, length, events, 8);
+        }
+        benchmark::DoNotOptimize(sink.checksum);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(sysexSerialSinkBlock)->Arg(64)->Arg(DumpSize);
+
+static void sysexUSBBuffered(benchmark::State &state) {
+    auto packets = getUSBSysExDump();
+    for (auto _ : state) {
+        USBMIDI_Parser parser;
+        auto puller = BufferPuller(packets);
+        uint32_t checksum = 0;
+        while (parser.pull(puller) != MIDIReadEvent::NO_MESSAGE) {
+            auto msg = parser.getSysExMessage();
+            for (uint16_t i = 0; i < msg.length; ++i)
+                checksum += msg.data[i];
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetBytesProcessed(state.iterations() * DumpSize);
+}
+BENCHMARK(sysexUSBBuffered);
+
+static void sysexUSBSink(benchmark::State &state) {
+    auto packets = getUSBSysExDump();
+    for (auto _ : state) {
+        USBMIDI_Parser parser;
+        ChecksumSysExSink sink;
+        parser.setSysExSink(&sink);
+        auto puller = BufferPuller(packets);
+        while (parser.pull(puller) != MIDIReadEvent::NO_MESSAGE)
+            ;
+        benchmark::DoNotOptimize(sink.checksum);
+    }
+    state.SetBytesProcessed(state.iterations() * DumpSize);
+}
+BENCHMARK(sysexUSBSink);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include "../BenchmarkHelpers.hpp"
+#include "../BenchmarkTraffic.hpp"
+
+#include <MIDI_Parsers/BufferPuller.hpp>
+#include <MIDI_Parsers/USBMIDI_Parser.hpp>
+
+using namespace CS;
+
+static void usbParserProfile(benchmark::State &state) {
+    auto packets = traffic::toUSB(traffic::getProfile(state.range(0)));
+    size_t numEvents = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        USBMIDI_Parser parser;
+        auto puller = BufferPuller(packets);
+        MIDIReadEvent event;
+        while ((event = parser.pull(puller)) != MIDIReadEvent::NO_MESSAGE) {
+            benchmark::DoNotOptimize(event);
+            ++numEvents;
+        }
+    }
+    reportMessages(state, numEvents, allocations.get());
+    state.SetBytesProcessed(state.iterations() * packets.size() * 4);
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(usbParserProfile)->Apply(traffic::allProfiles);
+
+static void usbParserBlockProfile(benchmark::State &state) {
+    auto packets = traffic::toUSB(traffic::getProfile(state.range(0)));
+    using Packet = USBMIDI_Parser::MIDIUSBPacket_t;
+    USBMIDI_Parser::BlockEvent events[USB_MIDI_BLOCK_SIZE];
+    size_t numEvents = 0;
+    AllocationCounter allocations;
+    for (auto _ : state) {
+        USBMIDI_Parser parser;
+        for (size_t i = 0; i < packets.size(); i += USB_MIDI_BLOCK_SIZE) {
+            const Packet *begin = packets.data() + i;
+            size_t count = std::min(size_t(USB_MIDI_BLOCK_SIZE),
+                                    packets.size() - i);
+            USBMIDI_Parser::BlockResult result;
+            do {
+                result = parser.parseBlock(begin, count, events,
+                                           USB_MIDI_BLOCK_SIZE);
+                begin += result.packetsConsumed;
+                count -= result.packetsConsumed;
+                benchmark::DoNotOptimize(events);
+                numEvents += result.numEvents;
+            } while (count > 0 || result.numEvents > 0);
+        }
+    }
+    reportMessages(state, numEvents, allocations.get());
+    state.SetBytesProcessed(state.iterations() * packets.size() * 4);
+    state.SetLabel(traffic::getProfileName(state.range(0)));
+}
+BENCHMARK(usbParserBlockProfile)->Apply(traffic::allProfiles);
@@ -0,0 +1,47 @@
+#include <Arduino.h>
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "BenchmarkHelpers.hpp"
+
+// Count all heap allocations, so the benchmarks can report them.
+static std::atomic<size_t> allocationCount {0};
+
+size_t getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void *operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+int main(int argc, char **argv) {
+    ArduinoMock::begin();
+    // Some of the code under test reads the time (e.g. to timestamp incoming
+    // messages), the mock always returns zero.
+    using ::testing::AnyNumber;
+    using ::testing::Return;
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(0));
+    ::benchmark::Initialize(&argc, argv);
+    int result = 1;
+    if (!::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        ::benchmark::RunSpecifiedBenchmarks();
+        result = 0;
+    }
+    ::benchmark::Shutdown();
+    ArduinoMock::end();
+    return result;
+}